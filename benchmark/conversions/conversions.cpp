@@ -37,7 +37,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <chrono>
 #include <cstdlib>
 #include <exception>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <typeinfo>
@@ -140,10 +139,10 @@ int main(int argc, char *argv[])
         auto &conversion_case = test_case["conversions"];
 
         std::clog << "Running test case: " << test_case << std::endl;
-        std::ifstream mtx_fd(test_case["filename"].GetString());
         gko::matrix_data<etype> data;
         try {
-            data = gko::read_raw<etype>(mtx_fd);
+            data = gko::read_raw<etype>(
+                std::string{test_case["filename"].GetString()});
         } catch (std::exception &e) {
             std::cerr << "Error setting up matrix data, what(): " << e.what()
                       << std::endl;
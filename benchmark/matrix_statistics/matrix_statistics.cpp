@@ -36,7 +36,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cmath>
 #include <cstdlib>
 #include <exception>
-#include <fstream>
 #include <iostream>
 
 
@@ -198,9 +197,8 @@ int main(int argc, char *argv[])
 
             std::clog << "Running test case: " << test_case << std::endl;
 
-            std::ifstream ifs(test_case["filename"].GetString());
-            auto matrix = gko::read_raw<etype, gko::int64>(ifs);
-            ifs.close();
+            auto matrix = gko::read_raw<etype, gko::int64>(
+                std::string{test_case["filename"].GetString()});
 
             std::clog << "Matrix is of size (" << matrix.size[0] << ", "
                       << matrix.size[1] << ")" << std::endl;
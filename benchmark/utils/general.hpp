@@ -154,7 +154,7 @@ template <typename MatrixType>
 std::unique_ptr<gko::LinOp> read_matrix(
     std::shared_ptr<const gko::Executor> exec, const rapidjson::Value &options)
 {
-    return gko::read<MatrixType>(std::ifstream(options["filename"].GetString()),
+    return gko::read<MatrixType>(std::string{options["filename"].GetString()},
                                  std::move(exec));
 }
 
@@ -34,11 +34,33 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <complex>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <numeric>
 #include <regex>
+#include <sstream>
+#include <streambuf>
 #include <string>
 #include <type_traits>
+#include <vector>
+
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GKO_MTX_IO_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define GKO_MTX_IO_HAVE_MMAP 0
+#endif
 
 
 #include <ginkgo/core/base/exception_helpers.hpp>
@@ -46,6 +68,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/utils.hpp>
 
 
+#include "core/base/iterator_factory.hpp"
+#include "core/base/run_parallel.hpp"
+
+
 namespace gko {
 namespace {
 
@@ -63,6 +89,585 @@ namespace {
     }
 
 
+/**
+ * Read-only view of the complete contents of a file.
+ *
+ * Regular files are mapped into memory where the operating system supports
+ * it, everything else (and every file on other systems) is read into a
+ * buffer in one piece.
+ */
+class file_contents {
+public:
+    explicit file_contents(const std::string &filename)
+    {
+#if GKO_MTX_IO_HAVE_MMAP
+        auto fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw GKO_STREAM_ERROR("error when opening file " + filename);
+        }
+        struct stat info {};
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) &&
+            info.st_size > 0) {
+            auto size = static_cast<size_type>(info.st_size);
+            // the mapping is private, so writes (e.g. to arrays created on
+            // top of it) never reach the file
+            auto ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                            fd, 0);
+            if (ptr != MAP_FAILED) {
+                // every thread parses a contiguous part of the file, so
+                // all of it will be needed soon
+                madvise(ptr, size, MADV_WILLNEED);
+                data_ = static_cast<const char *>(ptr);
+                size_ = size;
+                mapped_ = true;
+            }
+        }
+        close(fd);
+        if (mapped_) {
+            return;
+        }
+#endif
+        std::ifstream fs(filename, std::ios::in | std::ios::binary);
+        GKO_CHECK_STREAM(fs, "error when opening file " + filename);
+        buffer_.assign(std::istreambuf_iterator<char>(fs),
+                       std::istreambuf_iterator<char>());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+
+    file_contents(const file_contents &) = delete;
+
+    file_contents &operator=(const file_contents &) = delete;
+
+    ~file_contents()
+    {
+#if GKO_MTX_IO_HAVE_MMAP
+        if (mapped_) {
+            munmap(const_cast<char *>(data_), size_);
+        }
+#endif
+    }
+
+    const char *begin() const { return data_; }
+
+    const char *end() const { return data_ + size_; }
+
+private:
+    const char *data_{};
+    size_type size_{};
+    bool mapped_{};
+    std::string buffer_{};
+};
+
+
+/**
+ * Stream buffer reading from a contiguous range of characters in memory,
+ * without copying them.
+ */
+class memory_streambuf : public std::streambuf {
+public:
+    memory_streambuf(const char *begin, const char *end)
+    {
+        // the get area is never written to
+        this->setg(const_cast<char *>(begin), const_cast<char *>(begin),
+                   const_cast<char *>(end));
+    }
+
+    /**
+     * Returns the number of characters that were already extracted.
+     */
+    size_type get_position() const
+    {
+        return static_cast<size_type>(this->gptr() - this->eback());
+    }
+};
+
+
+inline bool is_blank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+
+inline const char *skip_blanks(const char *it, const char *end)
+{
+    while (it != end && is_blank(*it)) {
+        ++it;
+    }
+    return it;
+}
+
+
+inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+
+/**
+ * Parses a non-negative decimal integer from the start of [it, end) after
+ * skipping leading blanks.
+ *
+ * @return the position after the integer, or nullptr if no integer
+ *         representable by IndexType could be read
+ */
+template <typename IndexType>
+const char *parse_index(const char *it, const char *end, IndexType &result)
+{
+    constexpr auto max_value =
+        static_cast<uint64>(std::numeric_limits<IndexType>::max());
+    it = skip_blanks(it, end);
+    if (it != end && *it == '+') {
+        ++it;
+    }
+    if (it == end || !is_digit(*it)) {
+        return nullptr;
+    }
+    uint64 value{};
+    for (; it != end && is_digit(*it); ++it) {
+        value = 10 * value + static_cast<uint64>(*it - '0');
+        if (value > max_value) {
+            return nullptr;
+        }
+    }
+    if (it != end && !is_blank(*it)) {
+        return nullptr;
+    }
+    result = static_cast<IndexType>(value);
+    return it;
+}
+
+
+/**
+ * Parses a floating point number from the start of [it, end) after skipping
+ * leading blanks.
+ *
+ * Numbers with at most 15 significant digits and a decimal exponent of at most
+ * 22 in magnitude are converted exactly by a single multiplication or
+ * division, everything else (including inf and nan) is handed to strtod.
+ *
+ * @return the position after the number, or nullptr if no number could be
+ *         read
+ */
+inline const char *parse_double(const char *it, const char *end,
+                                double &result)
+{
+    static constexpr double exact_powers[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr int max_exact_digits = 15;
+    constexpr int max_exact_exponent = 22;
+    it = skip_blanks(it, end);
+    auto token_end = it;
+    while (token_end != end && !is_blank(*token_end) && *token_end != '\n') {
+        ++token_end;
+    }
+    if (it == token_end) {
+        return nullptr;
+    }
+    auto pos = it;
+    bool negative = false;
+    if (*pos == '+' || *pos == '-') {
+        negative = *pos == '-';
+        ++pos;
+    }
+    uint64 mantissa{};
+    int num_digits{};
+    int significant_digits{};
+    int exponent{};
+    for (; pos != token_end && is_digit(*pos); ++pos, ++num_digits) {
+        if (mantissa != 0 || *pos != '0') {
+            mantissa = 10 * mantissa + static_cast<uint64>(*pos - '0');
+            ++significant_digits;
+        }
+    }
+    if (pos != token_end && *pos == '.') {
+        for (++pos; pos != token_end && is_digit(*pos); ++pos, ++num_digits) {
+            if (mantissa != 0 || *pos != '0') {
+                mantissa = 10 * mantissa + static_cast<uint64>(*pos - '0');
+                ++significant_digits;
+            }
+            --exponent;
+        }
+    }
+    bool exact = num_digits > 0 && significant_digits <= max_exact_digits;
+    if (exact && pos != token_end && (*pos == 'e' || *pos == 'E')) {
+        ++pos;
+        bool negative_exponent = false;
+        if (pos != token_end && (*pos == '+' || *pos == '-')) {
+            negative_exponent = *pos == '-';
+            ++pos;
+        }
+        exact = pos != token_end && is_digit(*pos);
+        int explicit_exponent{};
+        for (; pos != token_end && is_digit(*pos); ++pos) {
+            // larger exponents are out of range for the fast path anyway
+            if (explicit_exponent <= max_exact_exponent) {
+                explicit_exponent = 10 * explicit_exponent + (*pos - '0');
+            }
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+    if (exact && pos == token_end && exponent >= -max_exact_exponent &&
+        exponent <= max_exact_exponent) {
+        auto value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / exact_powers[-exponent]
+                             : value * exact_powers[exponent];
+        result = negative ? -value : value;
+        return token_end;
+    }
+    // slow path: strtod needs a null-terminated copy of the token
+    char token[128];
+    const auto length = static_cast<size_type>(token_end - it);
+    if (length >= sizeof(token)) {
+        return nullptr;
+    }
+    std::copy(it, token_end, token);
+    token[length] = '\0';
+    char *parsed_end{};
+    result = std::strtod(token, &parsed_end);
+    return parsed_end == token + length ? token_end : nullptr;
+}
+
+
+/**
+ * The header of Ginkgo's binary matrix format, see layout_type::binary.
+ */
+struct binary_header {
+    char magic[8];
+    uint32 byte_order;
+    uint32 version;
+    uint32 layout;
+    uint32 value_type;
+    uint32 index_size;
+    uint32 reserved;
+    uint64 num_rows;
+    uint64 num_cols;
+    uint64 num_nonzeros;
+    uint64 reserved2;
+};
+
+static_assert(sizeof(binary_header) == 64,
+              "the binary header needs to be 64 bytes large");
+
+
+constexpr char binary_magic[] = {'G', 'K', 'O', 'M', 'T', 'X', 'B', 'N'};
+constexpr uint32 binary_byte_order = 0x01020304;
+constexpr uint32 binary_version = 1;
+constexpr uint32 binary_csr_layout = 0;
+constexpr size_type binary_alignment = 64;
+
+
+template <typename ValueType>
+struct binary_value_type {};
+
+template <>
+struct binary_value_type<float> : std::integral_constant<uint32, 0> {};
+
+template <>
+struct binary_value_type<double> : std::integral_constant<uint32, 1> {};
+
+template <>
+struct binary_value_type<std::complex<float>>
+    : std::integral_constant<uint32, 2> {};
+
+template <>
+struct binary_value_type<std::complex<double>>
+    : std::integral_constant<uint32, 3> {};
+
+
+/**
+ * The offsets of the arrays in a binary matrix file.
+ */
+struct binary_offsets {
+    size_type row_ptrs;
+    size_type col_idxs;
+    size_type values;
+    size_type end;
+};
+
+
+inline size_type align_binary_offset(size_type offset)
+{
+    return ceildiv(offset, binary_alignment) * binary_alignment;
+}
+
+
+inline binary_offsets get_binary_offsets(const binary_header &header)
+{
+    const auto value_size = header.value_type < 2
+                                ? 4 * (header.value_type + 1)
+                                : 8 * (header.value_type - 1);
+    binary_offsets offsets{};
+    offsets.row_ptrs = sizeof(binary_header);
+    offsets.col_idxs = align_binary_offset(
+        offsets.row_ptrs + (header.num_rows + 1) * header.index_size);
+    offsets.values = align_binary_offset(
+        offsets.col_idxs + header.num_nonzeros * header.index_size);
+    offsets.end = offsets.values + header.num_nonzeros * value_size;
+    return offsets;
+}
+
+
+inline bool is_binary(const char *begin, const char *end)
+{
+    return static_cast<size_type>(end - begin) >= sizeof(binary_magic) &&
+           std::equal(std::begin(binary_magic), std::end(binary_magic), begin);
+}
+
+
+/**
+ * Reads and validates the header of a binary matrix file.
+ */
+inline binary_header read_binary_header(const char *begin, const char *end)
+{
+    binary_header header{};
+    GKO_CHECK_MATCH((static_cast<size_type>(end - begin) >= sizeof(header) &&
+                     is_binary(begin, end)),
+                    "error when reading the binary matrix header");
+    std::memcpy(&header, begin, sizeof(header));
+    GKO_CHECK_MATCH((header.byte_order == binary_byte_order),
+                    "the binary matrix was written with a different byte "
+                    "order");
+    GKO_CHECK_MATCH((header.version == binary_version),
+                    "unsupported binary matrix format version " +
+                        std::to_string(header.version));
+    GKO_CHECK_MATCH((header.layout == binary_csr_layout &&
+                     header.value_type < 4 &&
+                     (header.index_size == sizeof(int32) ||
+                      header.index_size == sizeof(int64))),
+                    "invalid layout, value type or index size in the binary "
+                    "matrix header");
+    GKO_CHECK_MATCH(
+        (get_binary_offsets(header).end <= static_cast<size_type>(end - begin)),
+        "the binary matrix file is truncated");
+    return header;
+}
+
+
+/**
+ * Calls fn(value, index) with value-initialized objects of the value and
+ * index types stored in a binary matrix file.
+ */
+template <typename Function>
+void run_for_binary_types(const binary_header &header, Function fn)
+{
+    auto dispatch_index = [&](auto value) {
+        if (header.index_size == sizeof(int32)) {
+            fn(value, int32{});
+        } else {
+            fn(value, int64{});
+        }
+    };
+    switch (header.value_type) {
+    case binary_value_type<float>::value:
+        dispatch_index(float{});
+        break;
+    case binary_value_type<double>::value:
+        dispatch_index(double{});
+        break;
+    case binary_value_type<std::complex<float>>::value:
+        dispatch_index(std::complex<float>{});
+        break;
+    default:
+        dispatch_index(std::complex<double>{});
+    }
+}
+
+
+template <typename T>
+T load_binary(const char *ptr, size_type i)
+{
+    T result{};
+    std::memcpy(&result, ptr + i * sizeof(T), sizeof(T));
+    return result;
+}
+
+
+template <typename T, typename S>
+std::enable_if_t<!is_complex_s<S>::value || is_complex_s<T>::value, T>
+convert_binary(const S &value)
+{
+    return static_cast<T>(value);
+}
+
+template <typename T, typename S>
+std::enable_if_t<is_complex_s<S>::value && !is_complex_s<T>::value, T>
+convert_binary(const S &)
+{
+    throw GKO_STREAM_ERROR(
+        "trying to read a complex matrix into a real storage type");
+}
+
+
+/**
+ * Reads a matrix from a binary matrix file held in memory.
+ */
+template <typename ValueType, typename IndexType>
+matrix_data<ValueType, IndexType> read_binary_data(const char *begin,
+                                                   const char *end)
+{
+    const auto header = read_binary_header(begin, end);
+    const auto offsets = get_binary_offsets(header);
+    matrix_data<ValueType, IndexType> data(
+        dim<2>{header.num_rows, header.num_cols});
+    data.nonzeros.reserve(header.num_nonzeros);
+    run_for_binary_types(header, [&](auto value, auto index) {
+        using file_value_type = decltype(value);
+        using file_index_type = decltype(index);
+        const auto row_ptrs = begin + offsets.row_ptrs;
+        const auto col_idxs = begin + offsets.col_idxs;
+        const auto values = begin + offsets.values;
+        for (size_type row = 0; row < header.num_rows; ++row) {
+            const auto row_begin = static_cast<size_type>(
+                load_binary<file_index_type>(row_ptrs, row));
+            const auto row_end = static_cast<size_type>(
+                load_binary<file_index_type>(row_ptrs, row + 1));
+            GKO_CHECK_MATCH((row_begin <= row_end &&
+                             row_end <= header.num_nonzeros &&
+                             row_begin == data.nonzeros.size()),
+                            "invalid row pointers in the binary matrix");
+            for (auto nz = row_begin; nz < row_end; ++nz) {
+                const auto col = load_binary<file_index_type>(col_idxs, nz);
+                GKO_CHECK_MATCH(
+                    (col >= 0 && static_cast<size_type>(col) < header.num_cols),
+                    "invalid column index in the binary matrix");
+                data.nonzeros.emplace_back(
+                    static_cast<IndexType>(row), static_cast<IndexType>(col),
+                    convert_binary<ValueType>(
+                        load_binary<file_value_type>(values, nz)));
+            }
+        }
+    });
+    GKO_CHECK_MATCH((data.nonzeros.size() == header.num_nonzeros),
+                    "invalid row pointers in the binary matrix");
+    return data;
+}
+
+
+/**
+ * Creates an array from data in a binary matrix file. If possible, the array
+ * refers to the file contents directly, otherwise the data is converted and
+ * copied.
+ */
+template <typename T, typename S>
+Array<T> map_binary_array(std::shared_ptr<const Executor> exec,
+                          std::shared_ptr<const file_contents> file,
+                          size_type offset, size_type num_elems)
+{
+    const auto ptr = file->begin() + offset;
+    auto host = exec->get_master();
+    if (std::is_same<T, S>::value && host == exec &&
+        reinterpret_cast<uintptr>(ptr) % alignof(T) == 0) {
+        // the deleter keeps the file contents alive as long as the array
+        return Array<T>{exec, num_elems,
+                        reinterpret_cast<T *>(const_cast<char *>(ptr)),
+                        [file](T *) {}};
+    }
+    Array<T> host_array{host, num_elems};
+    for (size_type i = 0; i < num_elems; ++i) {
+        host_array.get_data()[i] = convert_binary<T>(load_binary<S>(ptr, i));
+    }
+    return Array<T>{exec, std::move(host_array)};
+}
+
+
+/**
+ * Creates the CSR arrays of a matrix from the contents of a binary matrix
+ * file, without copying them if possible.
+ */
+template <typename ValueType, typename IndexType>
+csr_arrays<ValueType, IndexType> map_binary_arrays(
+    std::shared_ptr<const file_contents> file,
+    std::shared_ptr<const Executor> exec)
+{
+    const auto header = read_binary_header(file->begin(), file->end());
+    const auto offsets = get_binary_offsets(header);
+    csr_arrays<ValueType, IndexType> result{
+        dim<2>{header.num_rows, header.num_cols}, Array<ValueType>{exec},
+        Array<IndexType>{exec}, Array<IndexType>{exec}};
+    run_for_binary_types(header, [&](auto value, auto index) {
+        using file_value_type = decltype(value);
+        using file_index_type = decltype(index);
+        const auto first_row_ptr =
+            load_binary<file_index_type>(file->begin() + offsets.row_ptrs, 0);
+        const auto last_row_ptr = load_binary<file_index_type>(
+            file->begin() + offsets.row_ptrs, header.num_rows);
+        GKO_CHECK_MATCH(
+            (first_row_ptr == 0 &&
+             static_cast<size_type>(last_row_ptr) == header.num_nonzeros),
+            "invalid row pointers in the binary matrix");
+        result.row_ptrs = map_binary_array<IndexType, file_index_type>(
+            exec, file, offsets.row_ptrs, header.num_rows + 1);
+        result.col_idxs = map_binary_array<IndexType, file_index_type>(
+            exec, file, offsets.col_idxs, header.num_nonzeros);
+        result.values = map_binary_array<ValueType, file_value_type>(
+            exec, file, offsets.values, header.num_nonzeros);
+    });
+    return result;
+}
+
+
+/**
+ * Writes a matrix in Ginkgo's binary format.
+ */
+template <typename ValueType, typename IndexType>
+void write_binary_data(std::ostream &os,
+                       const matrix_data<ValueType, IndexType> &data)
+{
+    using nt = typename matrix_data<ValueType, IndexType>::nonzero_type;
+    auto row_major = [](const nt &x, const nt &y) {
+        return std::tie(x.row, x.column) < std::tie(y.row, y.column);
+    };
+    auto nonzeros = &data.nonzeros;
+    std::vector<nt> sorted_nonzeros;
+    if (!std::is_sorted(begin(data.nonzeros), end(data.nonzeros), row_major)) {
+        sorted_nonzeros = data.nonzeros;
+        std::sort(begin(sorted_nonzeros), end(sorted_nonzeros), row_major);
+        nonzeros = &sorted_nonzeros;
+    }
+    binary_header header{};
+    std::copy(std::begin(binary_magic), std::end(binary_magic), header.magic);
+    header.byte_order = binary_byte_order;
+    header.version = binary_version;
+    header.layout = binary_csr_layout;
+    header.value_type = binary_value_type<ValueType>::value;
+    header.index_size = sizeof(IndexType);
+    header.num_rows = data.size[0];
+    header.num_cols = data.size[1];
+    header.num_nonzeros = nonzeros->size();
+    const auto offsets = get_binary_offsets(header);
+    std::vector<IndexType> row_ptrs(data.size[0] + 1);
+    std::vector<IndexType> col_idxs(nonzeros->size());
+    std::vector<ValueType> values(nonzeros->size());
+    for (size_type nz = 0; nz < nonzeros->size(); ++nz) {
+        const auto &nonzero = (*nonzeros)[nz];
+        GKO_CHECK_MATCH((nonzero.row >= 0 &&
+                         static_cast<size_type>(nonzero.row) < data.size[0] &&
+                         nonzero.column >= 0 &&
+                         static_cast<size_type>(nonzero.column) < data.size[1]),
+                        "matrix entry " + std::to_string(nz) +
+                            " is out of bounds");
+        ++row_ptrs[nonzero.row + 1];
+        col_idxs[nz] = nonzero.column;
+        values[nz] = nonzero.value;
+    }
+    std::partial_sum(begin(row_ptrs), end(row_ptrs), begin(row_ptrs));
+    size_type position{};
+    auto write_at = [&](size_type offset, const void *ptr, size_type size) {
+        static const char padding[binary_alignment]{};
+        GKO_CHECK_STREAM(os.write(padding, offset - position),
+                         "error when writing binary matrix data");
+        GKO_CHECK_STREAM(os.write(static_cast<const char *>(ptr), size),
+                         "error when writing binary matrix data");
+        position = offset + size;
+    };
+    write_at(0, &header, sizeof(header));
+    write_at(offsets.row_ptrs, row_ptrs.data(),
+             row_ptrs.size() * sizeof(IndexType));
+    write_at(offsets.col_idxs, col_idxs.data(),
+             col_idxs.size() * sizeof(IndexType));
+    write_at(offsets.values, values.data(), values.size() * sizeof(ValueType));
+}
+
+
 /**
  * The mtx_io class provides the functionality of reading and writing matrix
  * market format files.
@@ -92,6 +697,12 @@ public:
      */
     matrix_data<ValueType, IndexType> read(std::istream &is) const
     {
+        if (is.peek() == binary_magic[0]) {
+            const std::string content{std::istreambuf_iterator<char>(is),
+                                      std::istreambuf_iterator<char>()};
+            return read_binary_data<ValueType, IndexType>(
+                content.data(), content.data() + content.size());
+        }
         auto parsed_header = this->read_header(is);
         std::istringstream dimensions_stream(parsed_header.dimensions_line);
         auto data = parsed_header.layout->read_data(
@@ -100,6 +711,56 @@ public:
         return data;
     }
 
+    /**
+     * Reads a matrix from a file, using multiple threads.
+     *
+     * @param filename  the name of the file.
+     * @param num_threads  the maximal number of threads to use.
+     *
+     * @return the matrix data.
+     */
+    matrix_data<ValueType, IndexType> read(const std::string &filename,
+                                           size_type num_threads) const
+    {
+        file_contents contents(filename);
+        if (is_binary(contents.begin(), contents.end())) {
+            return read_binary_data<ValueType, IndexType>(contents.begin(),
+                                                          contents.end());
+        }
+        memory_streambuf buffer(contents.begin(), contents.end());
+        std::istream is(&buffer);
+        auto parsed_header = this->read_header(is);
+        std::istringstream dimensions_stream(parsed_header.dimensions_line);
+        return parsed_header.layout->read_mapped_data(
+            dimensions_stream, contents.begin() + buffer.get_position(),
+            contents.end(), parsed_header.entry, parsed_header.modifier,
+            num_threads);
+    }
+
+    /**
+     * Reads the CSR arrays of a matrix from a file held in memory, using
+     * multiple threads.
+     *
+     * @param contents  the contents of the file.
+     * @param num_threads  the maximal number of threads to use.
+     * @param exec  the executor of the arrays.
+     *
+     * @return the CSR arrays of the matrix.
+     */
+    csr_arrays<ValueType, IndexType> read_csr(
+        const file_contents &contents, size_type num_threads,
+        std::shared_ptr<const Executor> exec) const
+    {
+        memory_streambuf buffer(contents.begin(), contents.end());
+        std::istream is(&buffer);
+        auto parsed_header = this->read_header(is);
+        std::istringstream dimensions_stream(parsed_header.dimensions_line);
+        return parsed_header.layout->read_mapped_csr(
+            dimensions_stream, contents.begin() + buffer.get_position(),
+            contents.end(), parsed_header.entry, parsed_header.modifier,
+            num_threads, std::move(exec));
+    }
+
     /**
      * Writes a matrix to a stream.
      *
@@ -125,6 +786,8 @@ private:
      */
     struct entry_format {
         virtual ValueType read_entry(std::istream &is) const = 0;
+        virtual const char *parse_entry(const char *it, const char *end,
+                                        ValueType &value) const = 0;
         virtual void write_entry(std::ostream &os,
                                  const ValueType &value) const = 0;
     };
@@ -152,6 +815,24 @@ private:
             return static_cast<ValueType>(result);
         }
 
+        /**
+         * parses entry from a range of characters
+         *
+         * @param it  the start of the range
+         * @param end  the end of the range
+         * @param value  the parsed matrix entry
+         *
+         * @return the position after the entry, nullptr on failure
+         */
+        const char *parse_entry(const char *it, const char *end,
+                                ValueType &value) const override
+        {
+            double result{};
+            it = parse_double(it, end, result);
+            value = static_cast<ValueType>(result);
+            return it;
+        }
+
         /**
          * writes entry to the output stream
          *
@@ -199,6 +880,21 @@ private:
             return read_entry_impl<ValueType>(is);
         }
 
+        /**
+         * parses entry from a range of characters
+         *
+         * @param it  the start of the range
+         * @param end  the end of the range
+         * @param value  the parsed matrix entry
+         *
+         * @return the position after the entry, nullptr on failure
+         */
+        const char *parse_entry(const char *it, const char *end,
+                                ValueType &value) const override
+        {
+            return parse_entry_impl(it, end, value);
+        }
+
         /**
          * writes entry to the output stream
          *
@@ -234,6 +930,30 @@ private:
                 "trying to read a complex matrix into a real storage type");
         }
 
+        template <typename T>
+        static std::enable_if_t<is_complex_s<T>::value, const char *>
+        parse_entry_impl(const char *it, const char *end, T &value)
+        {
+            using real_type = remove_complex<T>;
+            double real{};
+            double imag{};
+            it = parse_double(it, end, real);
+            if (it) {
+                it = parse_double(it, end, imag);
+            }
+            value = {static_cast<real_type>(real),
+                     static_cast<real_type>(imag)};
+            return it;
+        }
+
+        template <typename T>
+        static std::enable_if_t<!is_complex_s<T>::value, const char *>
+        parse_entry_impl(const char *, const char *, T &)
+        {
+            throw GKO_STREAM_ERROR(
+                "trying to read a complex matrix into a real storage type");
+        }
+
     } complex_format{};
 
     /**
@@ -252,6 +972,22 @@ private:
             return one<ValueType>();
         }
 
+        /**
+         * parses entry from a range of characters
+         *
+         * @param it  the start of the range
+         * @param dummy end of the range
+         * @param value  the matrix entry(one)
+         *
+         * @return the unchanged start of the range
+         */
+        const char *parse_entry(const char *it, const char *,
+                                ValueType &value) const override
+        {
+            value = one<ValueType>();
+            return it;
+        }
+
         /**
          * writes entry to the output stream
          *
@@ -491,6 +1227,86 @@ private:
                                 const matrix_data<ValueType, IndexType> &data,
                                 const entry_format *entry_writer,
                                 const storage_modifier *modifier) const = 0;
+
+        /**
+         * Read the matrix data from a file that is completely held in memory
+         *
+         * By default, the content is read sequentially as if it was a stream.
+         *
+         * @param header  The header in the matrix file
+         * @param begin  The start of the content in the matrix file
+         * @param end  The end of the content in the matrix file
+         * @param entry_reader  The entry format in the matrix file
+         * @param modifier  The storage modifier for the matrix file
+         * @param num_threads  The maximal number of threads to use
+         *
+         * @return the matrix data in row-major order
+         */
+        virtual matrix_data<ValueType, IndexType> read_mapped_data(
+            std::istream &header, const char *begin, const char *end,
+            const entry_format *entry_reader, const storage_modifier *modifier,
+            size_type) const
+        {
+            memory_streambuf buffer(begin, end);
+            std::istream content(&buffer);
+            auto data =
+                this->read_data(header, content, entry_reader, modifier);
+            data.ensure_row_major_order();
+            return data;
+        }
+
+        /**
+         * Read the CSR arrays of a matrix from a file that is completely held
+         * in memory
+         *
+         * By default, the matrix data is read first, and its nonzero entries
+         * are then copied to the arrays.
+         *
+         * @param header  The header in the matrix file
+         * @param begin  The start of the content in the matrix file
+         * @param end  The end of the content in the matrix file
+         * @param entry_reader  The entry format in the matrix file
+         * @param modifier  The storage modifier for the matrix file
+         * @param num_threads  The maximal number of threads to use
+         * @param exec  The executor of the arrays
+         *
+         * @return the CSR arrays of the matrix
+         */
+        virtual csr_arrays<ValueType, IndexType> read_mapped_csr(
+            std::istream &header, const char *begin, const char *end,
+            const entry_format *entry_reader, const storage_modifier *modifier,
+            size_type num_threads, std::shared_ptr<const Executor> exec) const
+        {
+            const auto data = this->read_mapped_data(
+                header, begin, end, entry_reader, modifier, num_threads);
+            const auto num_rows = data.size[0];
+            auto host = exec->get_master();
+            Array<IndexType> row_ptrs{host, num_rows + 1};
+            std::fill_n(row_ptrs.get_data(), num_rows + 1, 0);
+            for (const auto &nonzero : data.nonzeros) {
+                if (nonzero.value != zero<ValueType>()) {
+                    ++row_ptrs.get_data()[nonzero.row + 1];
+                }
+            }
+            std::partial_sum(row_ptrs.get_data(),
+                             row_ptrs.get_data() + num_rows + 1,
+                             row_ptrs.get_data());
+            const auto num_entries =
+                static_cast<size_type>(row_ptrs.get_data()[num_rows]);
+            Array<IndexType> col_idxs{host, num_entries};
+            Array<ValueType> values{host, num_entries};
+            size_type nz{};
+            for (const auto &nonzero : data.nonzeros) {
+                if (nonzero.value != zero<ValueType>()) {
+                    col_idxs.get_data()[nz] = nonzero.column;
+                    values.get_data()[nz] = nonzero.value;
+                    ++nz;
+                }
+            }
+            return {data.size, Array<ValueType>{exec, std::move(values)},
+                    Array<IndexType>{exec, std::move(col_idxs)},
+                    Array<IndexType>{exec, std::move(row_ptrs)}};
+        }
     };
 
     /**
@@ -568,6 +1384,224 @@ private:
             }
         }
 
+        /**
+         * Read the matrix data from a file that is completely held in memory
+         *
+         * The content is split into chunks of complete lines, which are parsed
+         * and expanded according to the storage modifier in parallel, before
+         * a parallel counting sort by row followed by sorting each row by
+         * column establishes row-major order.
+         *
+         * @param header  The header in the matrix file
+         * @param begin  The start of the content in the matrix file
+         * @param end  The end of the content in the matrix file
+         * @param entry_reader  The entry format in the matrix file
+         * @param modifier  The storage modifier for the matrix file
+         * @param num_threads  The maximal number of threads to use
+         *
+         * @return the matrix data in row-major order
+         */
+        matrix_data<ValueType, IndexType> read_mapped_data(
+            std::istream &header, const char *begin, const char *end,
+            const entry_format *entry_reader, const storage_modifier *modifier,
+            size_type num_threads) const override
+        {
+            using nonzero_type =
+                typename matrix_data<ValueType, IndexType>::nonzero_type;
+            const auto size = read_coordinate_size(header);
+            const auto chunk_begins = split_lines(begin, end, num_threads);
+            const auto num_chunks = chunk_begins.size() - 1;
+            std::vector<std::vector<nonzero_type>> chunks(num_chunks);
+            std::vector<chunk_status> statuses(num_chunks);
+            const auto reservation_size = static_cast<double>(
+                std::min(modifier->get_reservation_size(size[0], size[1],
+                                                        size[2]),
+                         2 * size[2]));
+            detail::run_parallel(num_chunks, [&](size_type chunk) {
+                auto &local = chunks[chunk];
+                local.reserve(static_cast<size_type>(
+                                  reservation_size *
+                                  (chunk_begins[chunk + 1] -
+                                   chunk_begins[chunk]) /
+                                  (end - begin)) +
+                              1);
+                parse_coordinates(chunk_begins[chunk], chunk_begins[chunk + 1],
+                                  size, entry_reader, modifier,
+                                  statuses[chunk],
+                                  [&](const nonzero_type &nonzero) {
+                                      local.push_back(nonzero);
+                                  });
+            });
+            check_chunks(statuses, size[2]);
+            // expanding symmetric storage of non-square matrices can create
+            // entries in rows up to the number of columns
+            const auto num_rows = std::max(size[0], size[1]);
+            size_type num_entries{};
+            for (const auto &chunk : chunks) {
+                num_entries += chunk.size();
+            }
+            const auto num_groups =
+                get_num_groups(num_chunks, num_entries, num_rows);
+            auto for_each_group_entry = [&](size_type group, auto fn) {
+                for (auto chunk = group * num_chunks / num_groups;
+                     chunk < (group + 1) * num_chunks / num_groups; ++chunk) {
+                    for (const auto &nonzero : chunks[chunk]) {
+                        fn(nonzero);
+                    }
+                }
+            };
+            std::vector<std::vector<size_type>> group_offsets(num_groups);
+            detail::run_parallel(num_groups, [&](size_type group) {
+                auto &offsets = group_offsets[group];
+                offsets.assign(num_rows, 0);
+                for_each_group_entry(group, [&](const nonzero_type &nonzero) {
+                    ++offsets[nonzero.row];
+                });
+            });
+            std::vector<size_type> row_ptrs(num_rows + 1);
+            compute_group_offsets(group_offsets, row_ptrs.data(), num_chunks);
+            matrix_data<ValueType, IndexType> data(dim<2>{size[0], size[1]});
+            data.nonzeros.resize(num_entries);
+            detail::run_parallel(num_groups, [&](size_type group) {
+                auto &offsets = group_offsets[group];
+                for_each_group_entry(group, [&](const nonzero_type &nonzero) {
+                    data.nonzeros[offsets[nonzero.row]++] = nonzero;
+                });
+            });
+            chunks.clear();
+            const auto nonzeros = data.nonzeros.begin();
+            for_each_row_balanced(
+                row_ptrs.data(), num_rows, num_chunks, [&](size_type row) {
+                    std::sort(nonzeros + row_ptrs[row],
+                              nonzeros + row_ptrs[row + 1],
+                              [](const nonzero_type &a, const nonzero_type &b) {
+                                  return a.column < b.column;
+                              });
+                });
+            return data;
+        }
+
+        /**
+         * Read the CSR arrays of a matrix from a file that is completely held
+         * in memory, without storing the entries in between
+         *
+         * The content is split into chunks of complete lines. A first pass
+         * over them only parses the coordinates to count the entries of
+         * every row, a second one parses the entries again and scatters them
+         * directly into the final arrays, whose rows are then sorted by
+         * column. Explicitly stored zeros are kept.
+         *
+         * @param header  The header in the matrix file
+         * @param begin  The start of the content in the matrix file
+         * @param end  The end of the content in the matrix file
+         * @param entry_reader  The entry format in the matrix file
+         * @param modifier  The storage modifier for the matrix file
+         * @param num_threads  The maximal number of threads to use
+         * @param exec  The executor of the arrays
+         *
+         * @return the CSR arrays of the matrix
+         */
+        csr_arrays<ValueType, IndexType> read_mapped_csr(
+            std::istream &header, const char *begin, const char *end,
+            const entry_format *entry_reader, const storage_modifier *modifier,
+            size_type num_threads,
+            std::shared_ptr<const Executor> exec) const override
+        {
+            using nonzero_type =
+                typename matrix_data<ValueType, IndexType>::nonzero_type;
+            const auto size = read_coordinate_size(header);
+            const auto chunk_begins = split_lines(begin, end, num_threads);
+            const auto num_chunks = chunk_begins.size() - 1;
+            const auto num_rows = size[0];
+            // there is no intermediate storage to distribute among the
+            // threads, so every group of chunks is processed by one thread
+            const auto num_groups =
+                get_num_groups(num_chunks, size[2], num_rows);
+            auto for_each_group_chunk = [&](size_type group, auto fn) {
+                for (auto chunk = group * num_chunks / num_groups;
+                     chunk < (group + 1) * num_chunks / num_groups; ++chunk) {
+                    fn(chunk);
+                }
+            };
+            std::vector<chunk_status> statuses(num_chunks);
+            std::vector<std::vector<size_type>> group_offsets(num_groups);
+            detail::run_parallel(num_groups, [&](size_type group) {
+                auto &offsets = group_offsets[group];
+                offsets.assign(num_rows, 0);
+                for_each_group_chunk(group, [&](size_type chunk) {
+                    parse_coordinates(chunk_begins[chunk],
+                                      chunk_begins[chunk + 1], size, nullptr,
+                                      modifier, statuses[chunk],
+                                      [&](const nonzero_type &nonzero) {
+                                          check_row(nonzero, num_rows);
+                                          ++offsets[nonzero.row];
+                                      });
+                });
+            });
+            check_chunks(statuses, size[2]);
+            auto host = exec->get_master();
+            csr_arrays<ValueType, IndexType> result{
+                dim<2>{size[0], size[1]}, Array<ValueType>{host},
+                Array<IndexType>{host}, Array<IndexType>{host, num_rows + 1}};
+            auto row_ptrs = result.row_ptrs.get_data();
+            compute_group_offsets(group_offsets, row_ptrs, num_chunks);
+            const auto num_entries = static_cast<size_type>(row_ptrs[num_rows]);
+            result.col_idxs.resize_and_reset(num_entries);
+            result.values.resize_and_reset(num_entries);
+            auto col_idxs = result.col_idxs.get_data();
+            auto values = result.values.get_data();
+            detail::run_parallel(num_groups, [&](size_type group) {
+                auto &offsets = group_offsets[group];
+                for_each_group_chunk(group, [&](size_type chunk) {
+                    statuses[chunk] = {};
+                    parse_coordinates(
+                        chunk_begins[chunk], chunk_begins[chunk + 1], size,
+                        entry_reader, modifier, statuses[chunk],
+                        [&](const nonzero_type &nonzero) {
+                            const auto pos = offsets[nonzero.row]++;
+                            col_idxs[pos] = nonzero.column;
+                            values[pos] = nonzero.value;
+                        });
+                });
+            });
+            check_chunks(statuses, size[2]);
+            for_each_row_balanced(
+                row_ptrs, num_rows, num_chunks, [&](size_type row) {
+                    auto row_entries = detail::IteratorFactory<IndexType,
+                                                               ValueType>(
+                        col_idxs + row_ptrs[row], values + row_ptrs[row],
+                        row_ptrs[row + 1] - row_ptrs[row]);
+                    std::sort(row_entries.begin(), row_entries.end());
+                });
+            result.values = Array<ValueType>{exec, std::move(result.values)};
+            result.col_idxs =
+                Array<IndexType>{exec, std::move(result.col_idxs)};
+            result.row_ptrs =
+                Array<IndexType>{exec, std::move(result.row_ptrs)};
+            return result;
+        }
+
+    private:
+        static std::array<size_type, 3> read_coordinate_size(
+            std::istream &header)
+        {
+            std::array<size_type, 3> size{};
+            GKO_CHECK_STREAM(
+                header >> size[0] >> size[1] >> size[2],
+                "error when determining matrix size, expected: rows cols nnz");
+            return size;
+        }
+
+        static void check_row(
+            const typename matrix_data<ValueType, IndexType>::nonzero_type
+                &nonzero,
+            size_type num_rows)
+        {
+            // only possible for symmetric storage of non-square matrices
+            GKO_CHECK_MATCH((static_cast<size_type>(nonzero.row) < num_rows),
+                            "the expanded symmetric storage exceeds the "
+                            "matrix size");
+        }
     } coordinate_layout{};
 
     /**
@@ -651,6 +1685,221 @@ private:
     } array_layout{};
 
 
+
+    /**
+     * the outcome of parsing a chunk of coordinate entries
+     */
+    struct chunk_status {
+        size_type num_entries{};
+        std::string error{};
+    };
+
+    /**
+     * Splits the content into chunks of complete lines for parallel parsing.
+     *
+     * @param begin  the start of the content
+     * @param end  the end of the content
+     * @param num_threads  the maximal number of chunks
+     *
+     * @return the starts of all chunks, followed by end
+     */
+    static std::vector<const char *> split_lines(const char *begin,
+                                                 const char *end,
+                                                 size_type num_threads)
+    {
+        // below this size, the thread startup dominates the parsing
+        constexpr size_type min_chunk_size = 1 << 16;
+        const auto size = static_cast<size_type>(end - begin);
+        const auto num_chunks = std::max<size_type>(
+            1, std::min(num_threads, size / min_chunk_size));
+        std::vector<const char *> chunk_begins(num_chunks + 1, end);
+        chunk_begins[0] = begin;
+        for (size_type chunk = 1; chunk < num_chunks; ++chunk) {
+            auto it = std::max(begin + size / num_chunks * chunk,
+                               chunk_begins[chunk - 1]);
+            it = std::find(it, end, '\n');
+            chunk_begins[chunk] = it == end ? end : it + 1;
+        }
+        return chunk_begins;
+    }
+
+    /**
+     * Parses the coordinate entries in a chunk of complete lines, expands them
+     * according to the storage modifier, and calls fn for each of the
+     * resulting entries.
+     *
+     * @param begin  the start of the chunk
+     * @param end  the end of the chunk
+     * @param size  the number of rows, columns and entries from the header
+     * @param entry_reader  the entry format, or nullptr to only parse the
+     *                      coordinates
+     * @param modifier  the storage modifier
+     * @param status  the number of entries read and, if parsing failed, the
+     *                error message
+     * @param fn  the function to call for each expanded entry
+     */
+    template <typename Function>
+    static void parse_coordinates(const char *begin, const char *end,
+                                  const std::array<size_type, 3> &size,
+                                  const entry_format *entry_reader,
+                                  const storage_modifier *modifier,
+                                  chunk_status &status, Function fn)
+    {
+        matrix_data<ValueType, IndexType> expanded;
+        for (auto it = begin; it != end;) {
+            const auto line_end = std::find(it, end, '\n');
+            it = skip_blanks(it, line_end);
+            if (it != line_end) {
+                IndexType row{};
+                IndexType col{};
+                ValueType entry{};
+                it = parse_index(it, line_end, row);
+                if (it) {
+                    it = parse_index(it, line_end, col);
+                }
+                if (!it || row < 1 || col < 1 ||
+                    static_cast<size_type>(row) > size[0] ||
+                    static_cast<size_type>(col) > size[1]) {
+                    status.error =
+                        "error when reading coordinates of matrix entry ";
+                    return;
+                }
+                if (entry_reader) {
+                    it = entry_reader->parse_entry(it, line_end, entry);
+                    if (!it || skip_blanks(it, line_end) != line_end) {
+                        status.error = "error when reading matrix entry ";
+                        return;
+                    }
+                }
+                expanded.nonzeros.clear();
+                modifier->insert_entry(row - 1, col - 1, entry, expanded);
+                for (const auto &nonzero : expanded.nonzeros) {
+                    fn(nonzero);
+                }
+                ++status.num_entries;
+            }
+            it = line_end == end ? end : line_end + 1;
+        }
+    }
+
+    /**
+     * Throws for the first chunk in which parsing failed, or if the total
+     * number of entries differs from the header.
+     *
+     * @param statuses  the outcome of parsing each chunk
+     * @param num_nonzeros  the number of entries from the header
+     */
+    static void check_chunks(const std::vector<chunk_status> &statuses,
+                             size_type num_nonzeros)
+    {
+        size_type num_read{};
+        for (const auto &status : statuses) {
+            num_read += status.num_entries;
+            GKO_CHECK_MATCH((status.error.empty()),
+                            status.error + std::to_string(num_read));
+        }
+        GKO_CHECK_MATCH((num_read >= num_nonzeros),
+                        "error when reading coordinates of matrix entry " +
+                            std::to_string(num_read));
+        GKO_CHECK_MATCH((num_read == num_nonzeros),
+                        "found more than the " + std::to_string(num_nonzeros) +
+                            " matrix entries given in the header");
+    }
+
+    /**
+     * Returns the number of groups of threads for a parallel counting sort.
+     * Every group keeps a histogram over all rows, so there are never more
+     * groups than entries per row to bound the memory used by the histograms.
+     */
+    static size_type get_num_groups(size_type num_threads,
+                                    size_type num_entries, size_type num_rows)
+    {
+        return std::max<size_type>(
+            1, std::min(num_threads,
+                        num_entries / std::max<size_type>(num_rows, 1)));
+    }
+
+    /**
+     * Computes the row pointers from the row histograms of all groups, and
+     * replaces the histograms by the offsets at which the entries of each
+     * group start within each row.
+     *
+     * @param group_offsets  the row histograms of each group
+     * @param row_ptrs  the row pointers to compute
+     * @param num_threads  the number of threads to use
+     */
+    template <typename RowPtrType>
+    static void compute_group_offsets(
+        std::vector<std::vector<size_type>> &group_offsets,
+        RowPtrType *row_ptrs, size_type num_threads)
+    {
+        const auto num_rows = group_offsets[0].size();
+        auto row_range = [&](size_type tid) {
+            return std::make_pair(num_rows * tid / num_threads,
+                                  num_rows * (tid + 1) / num_threads);
+        };
+        detail::run_parallel(num_threads, [&](size_type tid) {
+            const auto rows = row_range(tid);
+            for (auto row = rows.first; row < rows.second; ++row) {
+                size_type row_nnz{};
+                for (const auto &offsets : group_offsets) {
+                    row_nnz += offsets[row];
+                }
+                row_ptrs[row + 1] = static_cast<RowPtrType>(row_nnz);
+            }
+        });
+        row_ptrs[0] = 0;
+        size_type num_entries{};
+        for (size_type row = 0; row < num_rows; ++row) {
+            num_entries += row_ptrs[row + 1];
+            row_ptrs[row + 1] = static_cast<RowPtrType>(num_entries);
+        }
+        GKO_CHECK_MATCH(
+            (num_entries <=
+             static_cast<size_type>(std::numeric_limits<RowPtrType>::max())),
+            "the number of matrix entries exceeds the index type");
+        detail::run_parallel(num_threads, [&](size_type tid) {
+            const auto rows = row_range(tid);
+            for (auto row = rows.first; row < rows.second; ++row) {
+                auto offset = static_cast<size_type>(row_ptrs[row]);
+                for (auto &offsets : group_offsets) {
+                    const auto group_nnz = offsets[row];
+                    offsets[row] = offset;
+                    offset += group_nnz;
+                }
+            }
+        });
+    }
+
+    /**
+     * Calls fn(row) for every row in parallel, splitting the rows such that
+     * every thread handles about as many entries.
+     *
+     * @param row_ptrs  the row pointers
+     * @param num_rows  the number of rows
+     * @param num_threads  the number of threads to use
+     * @param fn  the function to call
+     */
+    template <typename RowPtrType, typename Function>
+    static void for_each_row_balanced(const RowPtrType *row_ptrs,
+                                      size_type num_rows, size_type num_threads,
+                                      Function fn)
+    {
+        const auto num_entries = static_cast<size_type>(row_ptrs[num_rows]);
+        detail::run_parallel(num_threads, [&](size_type tid) {
+            const auto first = std::lower_bound(
+                row_ptrs, row_ptrs + num_rows,
+                static_cast<RowPtrType>(num_entries * tid / num_threads));
+            const auto last = std::lower_bound(
+                row_ptrs, row_ptrs + num_rows,
+                static_cast<RowPtrType>(num_entries * (tid + 1) /
+                                        num_threads));
+            for (auto it = first; it < last; ++it) {
+                fn(static_cast<size_type>(it - row_ptrs));
+            }
+        });
+    }
+
     /**
      * the constructors establishes the mapping between specification strings to
      * classes representing algorithms
@@ -760,6 +2009,66 @@ matrix_data<ValueType, IndexType> read_raw(std::istream &is)
 }
 
 
+/**
+ * Reads raw data from a file.
+ *
+ * @param filename  the name of the file
+ * @param num_threads  the maximal number of threads, 0 for one per hardware
+ *                     thread
+ *
+ * @return matrix_data  the matrix data.
+ */
+template <typename ValueType, typename IndexType>
+matrix_data<ValueType, IndexType> read_raw(const std::string &filename,
+                                           size_type num_threads)
+{
+    return mtx_io<ValueType, IndexType>::get().read(
+        filename, detail::get_num_host_threads(num_threads));
+}
+
+
+/**
+ * Loads the CSR arrays of a matrix from a binary file.
+ *
+ * @param filename  the name of the file
+ * @param exec  the executor of the arrays
+ *
+ * @return the arrays of the matrix
+ */
+template <typename ValueType, typename IndexType>
+csr_arrays<ValueType, IndexType> read_binary_arrays(
+    const std::string &filename, std::shared_ptr<const Executor> exec)
+{
+    return map_binary_arrays<ValueType, IndexType>(
+        std::make_shared<const file_contents>(filename), std::move(exec));
+}
+
+
+/**
+ * Reads the CSR arrays of a matrix from a file in matrix market or binary
+ * format.
+ *
+ * @param filename  the name of the file
+ * @param exec  the executor of the arrays
+ * @param num_threads  the maximal number of threads, 0 for one per hardware
+ *                     thread
+ *
+ * @return the arrays of the matrix
+ */
+template <typename ValueType, typename IndexType>
+csr_arrays<ValueType, IndexType> read_csr_arrays(
+    const std::string &filename, std::shared_ptr<const Executor> exec,
+    size_type num_threads)
+{
+    auto file = std::make_shared<const file_contents>(filename);
+    if (is_binary(file->begin(), file->end())) {
+        return map_binary_arrays<ValueType, IndexType>(file, std::move(exec));
+    }
+    return mtx_io<ValueType, IndexType>::get().read_csr(
+        *file, detail::get_num_host_threads(num_threads), std::move(exec));
+}
+
+
 /**
  * Writes raw data to the stream.
  *
@@ -771,6 +2080,10 @@ template <typename ValueType, typename IndexType>
 void write_raw(std::ostream &os, const matrix_data<ValueType, IndexType> &data,
                layout_type layout)
 {
+    if (layout == layout_type::binary) {
+        write_binary_data(os, data);
+        return;
+    }
     // TODO: add support for all layout combinations
     mtx_io<ValueType, IndexType>::get().write(
         os, data,
@@ -782,11 +2095,24 @@ void write_raw(std::ostream &os, const matrix_data<ValueType, IndexType> &data,
 
 #define GKO_DECLARE_READ_RAW(ValueType, IndexType) \
     matrix_data<ValueType, IndexType> read_raw(std::istream &is)
+#define GKO_DECLARE_READ_RAW_FROM_FILE(ValueType, IndexType)                \
+    matrix_data<ValueType, IndexType> read_raw(const std::string &filename, \
+                                               size_type num_threads)
+#define GKO_DECLARE_READ_BINARY_ARRAYS(ValueType, IndexType) \
+    csr_arrays<ValueType, IndexType> read_binary_arrays(     \
+        const std::string &filename, std::shared_ptr<const Executor> exec)
+#define GKO_DECLARE_READ_CSR_ARRAYS(ValueType, IndexType)                  \
+    csr_arrays<ValueType, IndexType> read_csr_arrays(                      \
+        const std::string &filename, std::shared_ptr<const Executor> exec, \
+        size_type num_threads)
 #define GKO_DECLARE_WRITE_RAW(ValueType, IndexType)               \
     void write_raw(std::ostream &os,                              \
                    const matrix_data<ValueType, IndexType> &data, \
                    layout_type layout)
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_READ_RAW);
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_READ_RAW_FROM_FILE);
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_READ_BINARY_ARRAYS);
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_READ_CSR_ARRAYS);
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_WRITE_RAW);
 
 
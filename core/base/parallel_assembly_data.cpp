@@ -0,0 +1,371 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/base/parallel_assembly_data.hpp>
+
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <tuple>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/math.hpp>
+
+
+#include "core/base/iterator_factory.hpp"
+#include "core/base/run_parallel.hpp"
+
+
+namespace gko {
+namespace {
+
+
+/**
+ * Sums up consecutive entries with the same key in place and returns the end
+ * of the combined range.
+ */
+template <typename Iterator, typename KeyEqual, typename Combine>
+Iterator combine_duplicates(Iterator begin, Iterator end, KeyEqual same_key,
+                            Combine combine)
+{
+    if (begin == end) {
+        return end;
+    }
+    auto out = begin;
+    for (auto it = std::next(begin); it != end; ++it) {
+        if (same_key(*out, *it)) {
+            combine(*out, *it);
+        } else {
+            *++out = *it;
+        }
+    }
+    return ++out;
+}
+
+
+}  // namespace
+
+
+template <typename ValueType, typename IndexType>
+parallel_assembly_data<ValueType, IndexType>::parallel_assembly_data(
+    dim<2> size, size_type num_threads)
+    : size_{size}, buffers_(detail::get_num_host_threads(num_threads))
+{}
+
+
+template <typename ValueType, typename IndexType>
+parallel_assembly_data<ValueType, IndexType>::parallel_assembly_data(
+    const matrix_type *pattern, size_type num_threads)
+    : parallel_assembly_data{pattern->get_size(), num_threads}
+{
+    auto exec = pattern->get_executor();
+    auto host_exec = exec->get_master();
+    pattern_row_ptrs_.resize(size_[0] + 1);
+    pattern_col_idxs_.resize(pattern->get_num_stored_elements());
+    host_exec->copy_from(exec.get(), pattern_row_ptrs_.size(),
+                         pattern->get_const_row_ptrs(),
+                         pattern_row_ptrs_.data());
+    host_exec->copy_from(exec.get(), pattern_col_idxs_.size(),
+                         pattern->get_const_col_idxs(),
+                         pattern_col_idxs_.data());
+}
+
+
+template <typename ValueType, typename IndexType>
+void parallel_assembly_data<ValueType, IndexType>::reserve(
+    size_type thread_id, size_type num_values)
+{
+    if (has_pattern()) {
+        buffers_[thread_id].pattern_values.reserve(num_values);
+    } else {
+        buffers_[thread_id].values.reserve(num_values);
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+void parallel_assembly_data<ValueType, IndexType>::clear()
+{
+    for (auto &buffer : buffers_) {
+        buffer.values.clear();
+        buffer.pattern_values.clear();
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+size_type parallel_assembly_data<ValueType, IndexType>::get_num_added_values()
+    const noexcept
+{
+    size_type num_values{};
+    for (const auto &buffer : buffers_) {
+        num_values += buffer.values.size() + buffer.pattern_values.size();
+    }
+    return num_values;
+}
+
+
+template <typename ValueType, typename IndexType>
+void parallel_assembly_data<ValueType, IndexType>::throw_not_in_pattern(
+    index_type row, index_type col) const
+{
+    throw BadDimension(__FILE__, __LINE__, __func__, "parallel_assembly_data",
+                       size_[0], size_[1],
+                       "entry (" + std::to_string(row) + ", " +
+                           std::to_string(col) +
+                           ") is not part of the sparsity pattern");
+}
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<matrix::Csr<ValueType, IndexType>>
+parallel_assembly_data<ValueType, IndexType>::assemble(
+    std::shared_ptr<const Executor> exec,
+    std::shared_ptr<typename matrix_type::strategy_type> strategy)
+{
+    auto host_exec = exec->get_master();
+    Array<ValueType> values{host_exec};
+    Array<IndexType> col_idxs{host_exec};
+    Array<IndexType> row_ptrs{host_exec};
+    if (has_pattern()) {
+        row_ptrs = Array<IndexType>(host_exec, pattern_row_ptrs_.begin(),
+                                    pattern_row_ptrs_.end());
+        col_idxs = Array<IndexType>(host_exec, pattern_col_idxs_.begin(),
+                                    pattern_col_idxs_.end());
+        assemble_pattern_values(values);
+    } else {
+        assemble_arrays(values, col_idxs, row_ptrs);
+    }
+    return matrix_type::create(exec, size_, std::move(values),
+                               std::move(col_idxs), std::move(row_ptrs),
+                               std::move(strategy));
+}
+
+
+template <typename ValueType, typename IndexType>
+void parallel_assembly_data<ValueType, IndexType>::assemble_values(
+    matrix_type *mtx)
+{
+    if (!has_pattern()) {
+        GKO_NOT_SUPPORTED(this);
+    }
+    GKO_ASSERT_EQUAL_DIMENSIONS(mtx, size_);
+    GKO_ASSERT_EQ(mtx->get_num_stored_elements(), pattern_col_idxs_.size());
+    Array<ValueType> values{mtx->get_executor()->get_master()};
+    assemble_pattern_values(values);
+    mtx->read_values(values);
+}
+
+
+template <typename ValueType, typename IndexType>
+void parallel_assembly_data<ValueType, IndexType>::assemble_pattern_values(
+    Array<ValueType> &values)
+{
+    using pattern_value = std::pair<index_type, value_type>;
+    const auto num_threads = buffers_.size();
+    const auto nnz = pattern_col_idxs_.size();
+    values.resize_and_reset(nnz);
+    auto vals = values.get_data();
+    auto position_less = [](const pattern_value &a, const pattern_value &b) {
+        return a.first < b.first;
+    };
+    detail::run_parallel(num_threads, [&](size_type tid) {
+        auto &local = buffers_[tid].pattern_values;
+        std::sort(local.begin(), local.end(), position_less);
+    });
+    // each thread owns a range of the values and collects the contributions
+    // to this range from all buffers
+    detail::run_parallel(num_threads, [&](size_type tid) {
+        const auto begin = static_cast<index_type>(nnz * tid / num_threads);
+        const auto end = static_cast<index_type>(nnz * (tid + 1) / num_threads);
+        std::fill(vals + begin, vals + end, zero<ValueType>());
+        for (const auto &buffer : buffers_) {
+            const auto &local = buffer.pattern_values;
+            auto it = std::lower_bound(
+                local.begin(), local.end(), pattern_value{begin, {}},
+                position_less);
+            for (; it != local.end() && it->first < end; ++it) {
+                vals[it->first] += it->second;
+            }
+        }
+    });
+}
+
+
+template <typename ValueType, typename IndexType>
+void parallel_assembly_data<ValueType, IndexType>::assemble_arrays(
+    Array<ValueType> &values, Array<IndexType> &col_idxs,
+    Array<IndexType> &row_ptrs)
+{
+    const auto num_threads = buffers_.size();
+    const auto num_rows = static_cast<index_type>(size_[0]);
+    auto row_less = [](const entry &a, index_type row) { return a.row < row; };
+    // sort each buffer and combine the duplicates within it
+    detail::run_parallel(num_threads, [&](size_type tid) {
+        auto &local = buffers_[tid].values;
+        std::sort(local.begin(), local.end(),
+                  [](const entry &a, const entry &b) {
+                      return std::tie(a.row, a.column) <
+                             std::tie(b.row, b.column);
+                  });
+        local.erase(combine_duplicates(
+                        local.begin(), local.end(),
+                        [](const entry &a, const entry &b) {
+                            return a.row == b.row && a.column == b.column;
+                        },
+                        [](entry &a, const entry &b) { a.value += b.value; }),
+                    local.end());
+    });
+    // split the rows into ranges with about the same number of entries
+    auto count_before = [&](index_type row) {
+        size_type count{};
+        for (const auto &buffer : buffers_) {
+            count += std::lower_bound(buffer.values.begin(),
+                                      buffer.values.end(), row, row_less) -
+                     buffer.values.begin();
+        }
+        return count;
+    };
+    const auto num_values = get_num_added_values();
+    std::vector<index_type> row_splits(num_threads + 1, num_rows);
+    row_splits[0] = 0;
+    for (size_type tid = 1; tid < num_threads; ++tid) {
+        const auto target = num_values * tid / num_threads;
+        auto lo = row_splits[tid - 1];
+        auto hi = num_rows;
+        while (lo < hi) {
+            const auto mid = lo + (hi - lo) / 2;
+            if (count_before(mid) >= target) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        row_splits[tid] = lo;
+    }
+    // merge the rows of each range from all buffers into thread-local arrays,
+    // storing the number of entries of each row in row_ptrs
+    row_ptrs.resize_and_reset(size_[0] + 1);
+    auto rows = row_ptrs.get_data();
+    rows[0] = zero<IndexType>();
+    std::vector<std::vector<index_type>> local_col_idxs(num_threads);
+    std::vector<std::vector<value_type>> local_values(num_threads);
+    std::vector<size_type> offsets(num_threads + 1);
+    detail::run_parallel(num_threads, [&](size_type tid) {
+        const auto row_begin = row_splits[tid];
+        const auto row_end = row_splits[tid + 1];
+        std::vector<const entry *> cursors(num_threads);
+        std::vector<const entry *> ends(num_threads);
+        size_type num_local{};
+        for (size_type buffer = 0; buffer < num_threads; ++buffer) {
+            const auto &local = buffers_[buffer].values;
+            cursors[buffer] =
+                local.data() + (std::lower_bound(local.begin(), local.end(),
+                                                 row_begin, row_less) -
+                                local.begin());
+            ends[buffer] =
+                local.data() + (std::lower_bound(local.begin(), local.end(),
+                                                 row_end, row_less) -
+                                local.begin());
+            num_local += ends[buffer] - cursors[buffer];
+        }
+        auto &cols = local_col_idxs[tid];
+        auto &vals = local_values[tid];
+        cols.reserve(num_local);
+        vals.reserve(num_local);
+        for (auto row = row_begin; row < row_end; ++row) {
+            const auto row_start = cols.size();
+            size_type num_contributing{};
+            for (size_type buffer = 0; buffer < num_threads; ++buffer) {
+                auto &it = cursors[buffer];
+                const auto start = it;
+                for (; it != ends[buffer] && it->row == row; ++it) {
+                    cols.push_back(it->column);
+                    vals.push_back(it->value);
+                }
+                num_contributing += it != start;
+            }
+            // a single buffer is already sorted and free of duplicates
+            if (num_contributing > 1) {
+                auto it = detail::IteratorFactory<index_type, value_type>(
+                    cols.data() + row_start, vals.data() + row_start,
+                    cols.size() - row_start);
+                std::sort(it.begin(), it.end());
+                size_type out = row_start;
+                for (auto nz = row_start + 1; nz < cols.size(); ++nz) {
+                    if (cols[nz] == cols[out]) {
+                        vals[out] += vals[nz];
+                    } else {
+                        ++out;
+                        cols[out] = cols[nz];
+                        vals[out] = vals[nz];
+                    }
+                }
+                cols.resize(out + 1);
+                vals.resize(out + 1);
+            }
+            rows[row + 1] = static_cast<IndexType>(cols.size() - row_start);
+        }
+        offsets[tid + 1] = cols.size();
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    col_idxs.resize_and_reset(offsets[num_threads]);
+    values.resize_and_reset(offsets[num_threads]);
+    auto cols = col_idxs.get_data();
+    auto vals = values.get_data();
+    // turn the row lengths into row pointers and copy the merged rows
+    detail::run_parallel(num_threads, [&](size_type tid) {
+        auto nz = static_cast<IndexType>(offsets[tid]);
+        for (auto row = row_splits[tid]; row < row_splits[tid + 1]; ++row) {
+            nz += rows[row + 1];
+            rows[row + 1] = nz;
+        }
+        std::copy(local_col_idxs[tid].begin(), local_col_idxs[tid].end(),
+                  cols + offsets[tid]);
+        std::copy(local_values[tid].begin(), local_values[tid].end(),
+                  vals + offsets[tid]);
+    });
+}
+
+
+#define GKO_DECLARE_PARALLEL_ASSEMBLY_DATA(ValueType, IndexType) \
+    class parallel_assembly_data<ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_PARALLEL_ASSEMBLY_DATA);
+
+
+}  // namespace gko
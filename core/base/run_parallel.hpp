@@ -0,0 +1,109 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_CORE_BASE_RUN_PARALLEL_HPP_
+#define GKO_CORE_BASE_RUN_PARALLEL_HPP_
+
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace detail {
+
+
+/**
+ * Returns the number of threads to use for a host-side parallel operation.
+ *
+ * @param num_threads  the requested number of threads, 0 uses one thread per
+ *                     hardware thread
+ */
+inline size_type get_num_host_threads(size_type num_threads)
+{
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+    return std::max<size_type>(num_threads, 1);
+}
+
+
+/**
+ * Runs `fn(tid)` for tid = 0, ..., num_threads - 1 on separate threads (with
+ * tid = 0 on the calling thread) and rethrows the first exception any of them
+ * raised after all of them have finished.
+ */
+template <typename Function>
+void run_parallel(size_type num_threads, Function fn)
+{
+    std::vector<std::exception_ptr> errors(num_threads);
+    auto guarded = [&](size_type tid) {
+        try {
+            fn(tid);
+        } catch (...) {
+            errors[tid] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    try {
+        for (size_type tid = 1; tid < num_threads; ++tid) {
+            threads.emplace_back(guarded, tid);
+        }
+    } catch (...) {
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    guarded(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+
+}  // namespace detail
+}  // namespace gko
+
+
+#endif  // GKO_CORE_BASE_RUN_PARALLEL_HPP_
@@ -216,6 +216,72 @@ ParIct<ValueType, IndexType>::generate_l_lt(
 }
 
 
+template <typename ValueType, typename IndexType>
+void ParIct<ValueType, IndexType>::refactorize(
+    std::shared_ptr<const LinOp> system_matrix, bool keep_pattern)
+{
+    using CsrMatrix = matrix::Csr<ValueType, IndexType>;
+    using CooMatrix = matrix::Coo<ValueType, IndexType>;
+    using CooBuilder = matrix::CooBuilder<ValueType, IndexType>;
+
+    GKO_ASSERT_EQUAL_DIMENSIONS(system_matrix, this);
+
+    const auto exec = this->get_executor();
+    auto csr_system_matrix = convert_to_with_sorting<CsrMatrix>(
+        exec, system_matrix, parameters_.skip_sorting);
+    // The factors were created as mutable objects by generate_l_lt, so their
+    // values can be updated in place
+    auto l = std::const_pointer_cast<matrix_type>(get_l_factor());
+    auto lh = std::const_pointer_cast<matrix_type>(get_lt_factor());
+
+    if (keep_pattern) {
+        // only run the asynchronous sweeps on the current factor
+        const auto l_nnz = l->get_num_stored_elements();
+        auto l_coo = CooMatrix::create(exec, this->get_size());
+        {
+            CooBuilder l_builder{l_coo.get()};
+            l_builder.get_row_idx_array().resize_and_reset(l_nnz);
+            l_builder.get_col_idx_array() =
+                Array<IndexType>::view(exec, l_nnz, l->get_col_idxs());
+            l_builder.get_value_array() =
+                Array<ValueType>::view(exec, l_nnz, l->get_values());
+        }
+        exec->run(make_convert_to_coo(l.get(), l_coo.get()));
+        for (size_type it = 0; it < parameters_.iterations; ++it) {
+            exec->run(make_compute_factor(csr_system_matrix.get(), l.get(),
+                                          l_coo.get()));
+        }
+        exec->run(make_csr_conj_transpose(l.get(), lh.get()));
+        return;
+    }
+
+    // the fill-in limit refers to the pattern of the system matrix
+    const auto num_rows = csr_system_matrix->get_size()[0];
+    Array<IndexType> l_row_ptrs{exec, num_rows + 1};
+    exec->run(make_initialize_row_ptrs_l(csr_system_matrix.get(),
+                                         l_row_ptrs.get_data()));
+    auto l_nnz = static_cast<size_type>(
+        exec->copy_val_to_host(l_row_ptrs.get_data() + num_rows));
+    auto l_nnz_limit =
+        static_cast<IndexType>(l_nnz * parameters_.fill_in_limit);
+
+    // start the iterations from the current factor
+    ParIctState<ValueType, IndexType> state{exec,
+                                            csr_system_matrix.get(),
+                                            gko::clone(exec, l),
+                                            l_nnz_limit,
+                                            parameters_.approximate_select,
+                                            parameters_.l_strategy,
+                                            parameters_.lt_strategy};
+
+    for (size_type it = 0; it < parameters_.iterations; ++it) {
+        state.iterate();
+    }
+
+    std::move(state).to_factors()->move_to(this);
+}
+
+
 template <typename ValueType, typename IndexType>
 void ParIctState<ValueType, IndexType>::iterate()
 {
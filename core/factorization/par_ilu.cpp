@@ -162,6 +162,52 @@ ParIlu<ValueType, IndexType>::generate_l_u(
 }
 
 
+template <typename ValueType, typename IndexType>
+void ParIlu<ValueType, IndexType>::refactorize(
+    std::shared_ptr<const LinOp> system_matrix)
+{
+    using CsrMatrix = matrix::Csr<ValueType, IndexType>;
+    using CooMatrix = matrix::Coo<ValueType, IndexType>;
+
+    GKO_ASSERT_EQUAL_DIMENSIONS(system_matrix, this);
+
+    const auto exec = this->get_executor();
+    // The factors were created as mutable objects by generate_l_u, so their
+    // values can be updated in place
+    auto l_factor = std::const_pointer_cast<l_matrix_type>(get_l_factor());
+    auto u_factor = std::const_pointer_cast<u_matrix_type>(get_u_factor());
+
+    auto csr_system_matrix = CsrMatrix::create(exec);
+    as<ConvertibleTo<CsrMatrix>>(system_matrix.get())
+        ->convert_to(csr_system_matrix.get());
+    if (!parameters_.skip_sorting) {
+        csr_system_matrix->sort_by_column_index();
+    }
+    exec->run(par_ilu_factorization::make_add_diagonal_elements(
+        csr_system_matrix.get(), true));
+    // the diagonal is stored in both factors
+    GKO_ASSERT_EQ(csr_system_matrix->get_num_stored_elements(),
+                  l_factor->get_num_stored_elements() +
+                      u_factor->get_num_stored_elements() -
+                      this->get_size()[0]);
+
+    auto u_factor_transpose = u_matrix_type::create(
+        exec, this->get_size(), u_factor->get_num_stored_elements());
+    exec->run(par_ilu_factorization::make_csr_transpose(
+        u_factor.get(), u_factor_transpose.get()));
+    auto coo_system_matrix = CooMatrix::create(exec);
+    csr_system_matrix->move_to(coo_system_matrix.get());
+
+    // the sweeps start from the current values of the factors
+    exec->run(par_ilu_factorization::make_compute_l_u_factors(
+        parameters_.iterations, coo_system_matrix.get(), l_factor.get(),
+        u_factor_transpose.get()));
+
+    exec->run(par_ilu_factorization::make_csr_transpose(
+        u_factor_transpose.get(), u_factor.get()));
+}
+
+
 #define GKO_DECLARE_PAR_ILU(ValueType, IndexType) \
     class ParIlu<ValueType, IndexType>
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_PAR_ILU);
@@ -235,6 +235,32 @@ void Coo<ValueType, IndexType>::write(mat_data &data) const
 }
 
 
+template <typename ValueType, typename IndexType>
+std::unique_ptr<LinOp> Coo<ValueType, IndexType>::transpose() const
+{
+    // the transposed entries need to be sorted by row again, which the Csr
+    // transpose kernels already take care of
+    auto exec = this->get_executor();
+    auto csr = Csr<ValueType, IndexType>::create(exec);
+    this->convert_to(csr.get());
+    auto trans = Coo::create(exec);
+    as<Csr<ValueType, IndexType>>(csr->transpose())->move_to(trans.get());
+    return std::move(trans);
+}
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<LinOp> Coo<ValueType, IndexType>::conj_transpose() const
+{
+    auto exec = this->get_executor();
+    auto csr = Csr<ValueType, IndexType>::create(exec);
+    this->convert_to(csr.get());
+    auto trans = Coo::create(exec);
+    as<Csr<ValueType, IndexType>>(csr->conj_transpose())->move_to(trans.get());
+    return std::move(trans);
+}
+
+
 template <typename ValueType, typename IndexType>
 std::unique_ptr<Diagonal<ValueType>>
 Coo<ValueType, IndexType>::extract_diagonal() const
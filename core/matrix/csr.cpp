@@ -33,6 +33,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/matrix/csr.hpp>
 
 
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/executor.hpp>
@@ -47,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/matrix/sparsity_csr.hpp>
 
 
+#include "core/base/iterator_factory.hpp"
 #include "core/components/absolute_array.hpp"
 #include "core/components/fill_array.hpp"
 #include "core/matrix/csr_kernels.hpp"
@@ -93,6 +99,69 @@ GKO_REGISTER_OPERATION(outplace_absolute_array,
 }  // namespace csr
 
 
+namespace {
+
+
+// returns the data of array on the host, copying it into storage if the array
+// is located on a different executor
+template <typename T>
+const T *get_host_data(std::shared_ptr<const Executor> host,
+                       const Array<T> &array, Array<T> &storage)
+{
+    if (array.get_executor() == host) {
+        return array.get_const_data();
+    }
+    storage = Array<T>{host, array};
+    return storage.get_const_data();
+}
+
+
+// calls fn with the host data of values, which is copied back afterwards if
+// values is located on a different executor
+template <typename ValueType, typename Function>
+void write_host_values(std::shared_ptr<const Executor> host,
+                       Array<ValueType> &values, Function fn)
+{
+    if (values.get_executor() == host) {
+        fn(values.get_data());
+    } else {
+        Array<ValueType> host_values{host, values.get_num_elems()};
+        fn(host_values.get_data());
+        values = host_values;
+    }
+}
+
+
+// returns the position of (row, col) among the stored elements of a matrix
+// with sorted column indexes, or -1 if it is not part of the sparsity pattern
+template <typename IndexType>
+IndexType find_position(const IndexType *row_ptrs, const IndexType *col_idxs,
+                        const dim<2> &size, IndexType row, IndexType col)
+{
+    if (row < 0 || static_cast<size_type>(row) >= size[0]) {
+        return -1;
+    }
+    const auto begin = col_idxs + row_ptrs[row];
+    const auto end = col_idxs + row_ptrs[row + 1];
+    const auto it = std::lower_bound(begin, end, col);
+    return it != end && *it == col ? static_cast<IndexType>(it - col_idxs)
+                                   : -1;
+}
+
+
+[[noreturn]] void throw_not_in_pattern(const char *func, const dim<2> &size,
+                                       int64 row, int64 col)
+{
+    throw BadDimension(__FILE__, __LINE__, func, "Csr", size[0], size[1],
+                       "entry (" + std::to_string(row) + ", " +
+                           std::to_string(col) +
+                           ") is not part of the sparsity pattern");
+}
+
+
+}  // namespace
+
+
 template <typename ValueType, typename IndexType>
 void Csr<ValueType, IndexType>::apply_impl(const LinOp *b, LinOp *x) const
 {
@@ -312,28 +381,44 @@ void Csr<ValueType, IndexType>::move_to(Ell<ValueType, IndexType> *result)
 template <typename ValueType, typename IndexType>
 void Csr<ValueType, IndexType>::read(const mat_data &data)
 {
+    const auto num_rows = data.size[0];
     size_type nnz = 0;
     for (const auto &elem : data.nonzeros) {
         nnz += (elem.value != zero<ValueType>());
     }
     auto tmp = Csr::create(this->get_executor()->get_master(), data.size, nnz,
                            this->get_strategy());
-    size_type ind = 0;
-    size_type cur_ptr = 0;
-    tmp->get_row_ptrs()[0] = cur_ptr;
-    for (size_type row = 0; row < data.size[0]; ++row) {
-        for (; ind < data.nonzeros.size(); ++ind) {
-            if (data.nonzeros[ind].row > row) {
-                break;
-            }
-            auto val = data.nonzeros[ind].value;
-            if (val != zero<ValueType>()) {
-                tmp->get_values()[cur_ptr] = val;
-                tmp->get_col_idxs()[cur_ptr] = data.nonzeros[ind].column;
-                ++cur_ptr;
-            }
+    auto row_ptrs = tmp->get_row_ptrs();
+    auto col_idxs = tmp->get_col_idxs();
+    auto values = tmp->get_values();
+    // counting sort by row, so the entries don't need to be sorted: the
+    // counts are stored shifted by two, which makes row_ptrs[row + 1] the
+    // start of row after the prefix sum and its end after the scatter
+    std::fill_n(row_ptrs, num_rows + 1, zero<IndexType>());
+    for (const auto &elem : data.nonzeros) {
+        if (elem.value != zero<ValueType>() &&
+            static_cast<size_type>(elem.row) + 2 <= num_rows) {
+            ++row_ptrs[elem.row + 2];
+        }
+    }
+    std::partial_sum(row_ptrs, row_ptrs + num_rows + 1, row_ptrs);
+    for (const auto &elem : data.nonzeros) {
+        if (elem.value != zero<ValueType>()) {
+            const auto nz = row_ptrs[elem.row + 1]++;
+            col_idxs[nz] = elem.column;
+            values[nz] = elem.value;
+        }
+    }
+    // the scatter is stable, so only rows with unsorted input need sorting
+    for (size_type row = 0; row < num_rows; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        if (!std::is_sorted(col_idxs + begin, col_idxs + end)) {
+            auto it = gko::detail::IteratorFactory<IndexType, ValueType>(
+                col_idxs + begin, values + begin,
+                static_cast<size_type>(end - begin));
+            std::sort(it.begin(), it.end());
         }
-        tmp->get_row_ptrs()[row + 1] = cur_ptr;
     }
     tmp->make_srow();
     tmp->move_to(this);
@@ -532,6 +617,89 @@ bool Csr<ValueType, IndexType>::is_sorted_by_column_index() const
 }
 
 
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::read_values(const Array<ValueType> &values)
+{
+    GKO_ASSERT_EQ(values.get_num_elems(), this->get_num_stored_elements());
+    values_ = values;
+}
+
+
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::read_values(const mat_data &data)
+{
+    GKO_ASSERT_EQUAL_DIMENSIONS(this, data.size);
+    auto host = this->get_executor()->get_master();
+    Array<IndexType> row_ptrs_storage{host};
+    Array<IndexType> col_idxs_storage{host};
+    const auto row_ptrs = get_host_data(host, row_ptrs_, row_ptrs_storage);
+    const auto col_idxs = get_host_data(host, col_idxs_, col_idxs_storage);
+    // the new values are collected separately to keep the old ones in case
+    // of an error
+    Array<ValueType> values{host, this->get_num_stored_elements()};
+    auto vals = values.get_data();
+    std::fill_n(vals, values.get_num_elems(), zero<ValueType>());
+    for (const auto &elem : data.nonzeros) {
+        const auto pos = find_position(row_ptrs, col_idxs, this->get_size(),
+                                       elem.row, elem.column);
+        if (pos >= 0) {
+            vals[pos] += elem.value;
+        } else if (elem.value != zero<ValueType>()) {
+            throw_not_in_pattern(__func__, this->get_size(), elem.row,
+                                 elem.column);
+        }
+    }
+    values_ = std::move(values);
+}
+
+
+template <typename ValueType, typename IndexType>
+Array<IndexType> Csr<ValueType, IndexType>::compute_value_map(
+    const Array<IndexType> &row_idxs, const Array<IndexType> &col_idxs) const
+{
+    GKO_ASSERT_EQ(row_idxs.get_num_elems(), col_idxs.get_num_elems());
+    auto host = this->get_executor()->get_master();
+    Array<IndexType> storage[4] = {Array<IndexType>{host},
+                                   Array<IndexType>{host},
+                                   Array<IndexType>{host},
+                                   Array<IndexType>{host}};
+    const auto row_ptrs = get_host_data(host, row_ptrs_, storage[0]);
+    const auto pattern_col_idxs = get_host_data(host, col_idxs_, storage[1]);
+    const auto rows = get_host_data(host, row_idxs, storage[2]);
+    const auto cols = get_host_data(host, col_idxs, storage[3]);
+    Array<IndexType> value_map{host, row_idxs.get_num_elems()};
+    auto map = value_map.get_data();
+    for (size_type i = 0; i < value_map.get_num_elems(); ++i) {
+        map[i] = find_position(row_ptrs, pattern_col_idxs, this->get_size(),
+                               rows[i], cols[i]);
+        if (map[i] < 0) {
+            throw_not_in_pattern(__func__, this->get_size(), rows[i],
+                                 cols[i]);
+        }
+    }
+    return value_map;
+}
+
+
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::read_values(const Array<IndexType> &value_map,
+                                            const Array<ValueType> &values)
+{
+    GKO_ASSERT_EQ(value_map.get_num_elems(), values.get_num_elems());
+    auto host = this->get_executor()->get_master();
+    Array<IndexType> map_storage{host};
+    Array<ValueType> values_storage{host};
+    const auto map = get_host_data(host, value_map, map_storage);
+    const auto new_vals = get_host_data(host, values, values_storage);
+    write_host_values(host, values_, [&](ValueType *vals) {
+        std::fill_n(vals, values_.get_num_elems(), zero<ValueType>());
+        for (size_type i = 0; i < values.get_num_elems(); ++i) {
+            vals[map[i]] += new_vals[i];
+        }
+    });
+}
+
+
 template <typename ValueType, typename IndexType>
 std::unique_ptr<Diagonal<ValueType>>
 Csr<ValueType, IndexType>::extract_diagonal() const
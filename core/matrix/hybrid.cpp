@@ -56,6 +56,8 @@ namespace matrix {
 namespace hybrid {
 
 
+GKO_REGISTER_OPERATION(spmv, hybrid::spmv);
+GKO_REGISTER_OPERATION(advanced_spmv, hybrid::advanced_spmv);
 GKO_REGISTER_OPERATION(convert_to_dense, hybrid::convert_to_dense);
 GKO_REGISTER_OPERATION(convert_to_csr, hybrid::convert_to_csr);
 GKO_REGISTER_OPERATION(count_nonzeros, hybrid::count_nonzeros);
@@ -104,10 +106,8 @@ void Hybrid<ValueType, IndexType>::apply_impl(const LinOp *b, LinOp *x) const
 {
     precision_dispatch_real_complex<ValueType>(
         [this](auto dense_b, auto dense_x) {
-            auto ell_mtx = this->get_ell();
-            auto coo_mtx = this->get_coo();
-            ell_mtx->apply(dense_b, dense_x);
-            coo_mtx->apply2(dense_b, dense_x);
+            this->get_executor()->run(
+                hybrid::make_spmv(this, dense_b, dense_x));
         },
         b, x);
 }
@@ -120,10 +120,8 @@ void Hybrid<ValueType, IndexType>::apply_impl(const LinOp *alpha,
 {
     precision_dispatch_real_complex<ValueType>(
         [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
-            auto ell_mtx = this->get_ell();
-            auto coo_mtx = this->get_coo();
-            ell_mtx->apply(dense_alpha, dense_b, dense_beta, dense_x);
-            coo_mtx->apply2(dense_alpha, dense_b, dense_x);
+            this->get_executor()->run(hybrid::make_advanced_spmv(
+                dense_alpha, this, dense_b, dense_beta, dense_x));
         },
         alpha, b, beta, x);
 }
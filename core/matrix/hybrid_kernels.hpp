@@ -44,6 +44,19 @@ namespace gko {
 namespace kernels {
 
 
+#define GKO_DECLARE_HYBRID_SPMV_KERNEL(ValueType, IndexType) \
+    void spmv(std::shared_ptr<const DefaultExecutor> exec,   \
+              const matrix::Hybrid<ValueType, IndexType> *a, \
+              const matrix::Dense<ValueType> *b, matrix::Dense<ValueType> *c)
+
+#define GKO_DECLARE_HYBRID_ADVANCED_SPMV_KERNEL(ValueType, IndexType) \
+    void advanced_spmv(std::shared_ptr<const DefaultExecutor> exec,   \
+                       const matrix::Dense<ValueType> *alpha,         \
+                       const matrix::Hybrid<ValueType, IndexType> *a, \
+                       const matrix::Dense<ValueType> *b,             \
+                       const matrix::Dense<ValueType> *beta,          \
+                       matrix::Dense<ValueType> *c)
+
 #define GKO_DECLARE_HYBRID_CONVERT_TO_DENSE_KERNEL(ValueType, IndexType)      \
     void convert_to_dense(std::shared_ptr<const DefaultExecutor> exec,        \
                           const matrix::Hybrid<ValueType, IndexType> *source, \
@@ -60,6 +73,10 @@ namespace kernels {
                         size_type *result)
 
 #define GKO_DECLARE_ALL_AS_TEMPLATES                                  \
+    template <typename ValueType, typename IndexType>                 \
+    GKO_DECLARE_HYBRID_SPMV_KERNEL(ValueType, IndexType);             \
+    template <typename ValueType, typename IndexType>                 \
+    GKO_DECLARE_HYBRID_ADVANCED_SPMV_KERNEL(ValueType, IndexType);    \
     template <typename ValueType, typename IndexType>                 \
     GKO_DECLARE_HYBRID_CONVERT_TO_DENSE_KERNEL(ValueType, IndexType); \
     template <typename ValueType, typename IndexType>                 \
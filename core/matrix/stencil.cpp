@@ -0,0 +1,268 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/stencil.hpp>
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
+
+
+#include "core/matrix/stencil_kernels.hpp"
+
+
+namespace gko {
+namespace matrix {
+namespace stencil {
+
+
+GKO_REGISTER_OPERATION(spmv, stencil::spmv);
+GKO_REGISTER_OPERATION(advanced_spmv, stencil::advanced_spmv);
+GKO_REGISTER_OPERATION(extract_diagonal, stencil::extract_diagonal);
+GKO_REGISTER_OPERATION(convert_to_csr, stencil::convert_to_csr);
+
+
+}  // namespace stencil
+
+
+namespace {
+
+
+size_type count_nonzeros(const dim<3> &grid, const Array<int32> &offsets)
+{
+    const Array<int32> host_offsets{offsets.get_executor()->get_master(),
+                                    offsets};
+    const auto offset_data = host_offsets.get_const_data();
+    size_type nnz{};
+    for (size_type point = 0; point < offsets.get_num_elems() / 3; ++point) {
+        // number of grid nodes whose neighbor lies within the grid
+        size_type count = 1;
+        for (int i = 0; i < 3; ++i) {
+            const auto offset =
+                static_cast<size_type>(std::abs(offset_data[3 * point + i]));
+            count *= grid[i] > offset ? grid[i] - offset : 0;
+        }
+        nnz += count;
+    }
+    return nnz;
+}
+
+
+template <typename IndexType, typename ValueType>
+void write_impl(const Stencil<ValueType> *source,
+                matrix_data<ValueType, IndexType> &data)
+{
+    auto tmp = Csr<ValueType, IndexType>::create(
+        source->get_executor()->get_master());
+    tmp->copy_from(source);
+    tmp->write(data);
+}
+
+
+}  // namespace
+
+
+template <typename ValueType>
+Array<int32> Stencil<ValueType>::make_shape_offsets(
+    std::shared_ptr<const Executor> exec, stencil_shape shape)
+{
+    // number of dimensions and the maximal sum of the absolute offsets
+    // of the stencil points included in the shape
+    int num_dims{};
+    int max_distance{};
+    switch (shape) {
+    case stencil_shape::three_point_1d:
+        num_dims = 1;
+        max_distance = 1;
+        break;
+    case stencil_shape::five_point_2d:
+        num_dims = 2;
+        max_distance = 1;
+        break;
+    case stencil_shape::nine_point_2d:
+        num_dims = 2;
+        max_distance = 2;
+        break;
+    case stencil_shape::seven_point_3d:
+        num_dims = 3;
+        max_distance = 1;
+        break;
+    case stencil_shape::twenty_seven_point_3d:
+        num_dims = 3;
+        max_distance = 3;
+        break;
+    default:
+        GKO_NOT_SUPPORTED(shape);
+    }
+    const int z_range = num_dims > 2 ? 1 : 0;
+    const int y_range = num_dims > 1 ? 1 : 0;
+    std::vector<int32> offsets;
+    // enumerate in lexicographical (z, y, x) order to sort the points
+    // by their column in the assembled matrix
+    for (int z = -z_range; z <= z_range; ++z) {
+        for (int y = -y_range; y <= y_range; ++y) {
+            for (int x = -1; x <= 1; ++x) {
+                if (std::abs(x) + std::abs(y) + std::abs(z) <= max_distance) {
+                    offsets.push_back(x);
+                    offsets.push_back(y);
+                    offsets.push_back(z);
+                }
+            }
+        }
+    }
+    Array<int32> host_offsets(exec->get_master(), offsets.begin(),
+                              offsets.end());
+    return Array<int32>{exec, std::move(host_offsets)};
+}
+
+
+template <typename ValueType>
+size_type Stencil<ValueType>::count_distinct_points(const Array<int32> &offsets)
+{
+    const Array<int32> host_offsets{offsets.get_executor()->get_master(),
+                                    offsets};
+    const auto data = host_offsets.get_const_data();
+    std::vector<std::tuple<int32, int32, int32>> points;
+    for (size_type i = 0; i + 2 < host_offsets.get_num_elems(); i += 3) {
+        points.emplace_back(data[i], data[i + 1], data[i + 2]);
+    }
+    std::sort(points.begin(), points.end());
+    return std::unique(points.begin(), points.end()) - points.begin();
+}
+
+
+template <typename ValueType>
+void Stencil<ValueType>::apply_impl(const LinOp *b, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->get_executor()->run(
+                stencil::make_spmv(this, dense_b, dense_x));
+        },
+        b, x);
+}
+
+
+template <typename ValueType>
+void Stencil<ValueType>::apply_impl(const LinOp *alpha, const LinOp *b,
+                                    const LinOp *beta, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            this->get_executor()->run(stencil::make_advanced_spmv(
+                dense_alpha, this, dense_b, dense_beta, dense_x));
+        },
+        alpha, b, beta, x);
+}
+
+
+template <typename ValueType>
+void Stencil<ValueType>::convert_to(Csr<ValueType, int32> *result) const
+{
+    auto exec = this->get_executor();
+    auto tmp = Csr<ValueType, int32>::create(
+        exec, this->get_size(), count_nonzeros(grid_size_, offsets_),
+        result->get_strategy());
+    exec->run(stencil::make_convert_to_csr(this, tmp.get()));
+    tmp->make_srow();
+    tmp->move_to(result);
+}
+
+
+template <typename ValueType>
+void Stencil<ValueType>::move_to(Csr<ValueType, int32> *result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType>
+void Stencil<ValueType>::convert_to(Csr<ValueType, int64> *result) const
+{
+    auto exec = this->get_executor();
+    auto tmp = Csr<ValueType, int64>::create(
+        exec, this->get_size(), count_nonzeros(grid_size_, offsets_),
+        result->get_strategy());
+    exec->run(stencil::make_convert_to_csr(this, tmp.get()));
+    tmp->make_srow();
+    tmp->move_to(result);
+}
+
+
+template <typename ValueType>
+void Stencil<ValueType>::move_to(Csr<ValueType, int64> *result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType>
+std::unique_ptr<Diagonal<ValueType>> Stencil<ValueType>::extract_diagonal()
+    const
+{
+    auto exec = this->get_executor();
+    auto diag = Diagonal<ValueType>::create(exec, this->get_size()[0]);
+    exec->run(stencil::make_extract_diagonal(this, lend(diag)));
+    return diag;
+}
+
+
+template <typename ValueType>
+void Stencil<ValueType>::write(mat_data &data) const
+{
+    write_impl(this, data);
+}
+
+
+template <typename ValueType>
+void Stencil<ValueType>::write(mat_data32 &data) const
+{
+    write_impl(this, data);
+}
+
+
+#define GKO_DECLARE_STENCIL_MATRIX(ValueType) class Stencil<ValueType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_STENCIL_MATRIX);
+
+
+}  // namespace matrix
+}  // namespace gko
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/preconditioner/jacobi.hpp>
 
 
+#include <functional>
 #include <memory>
 
 
@@ -43,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/utils.hpp>
 #include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
 
 
 #include "core/base/extended_float.hpp"
@@ -69,6 +71,35 @@ GKO_REGISTER_OPERATION(initialize_precisions, jacobi::initialize_precisions);
 }  // namespace jacobi
 
 
+namespace {
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<const matrix::Csr<ValueType, IndexType>,
+                std::function<void(const matrix::Csr<ValueType, IndexType> *)>>
+convert_to_block_csr(std::shared_ptr<const Executor> exec,
+                     const LinOp *system_matrix, uint32 max_block_size,
+                     bool skip_sorting)
+{
+    using csr_type = matrix::Csr<ValueType, IndexType>;
+    auto diag_extractable =
+        dynamic_cast<const DiagonalExtractable<ValueType> *>(system_matrix);
+    if (max_block_size == 1 && diag_extractable &&
+        !dynamic_cast<const csr_type *>(system_matrix)) {
+        // scalar Jacobi only depends on the diagonal, so there is no need to
+        // assemble the whole matrix (e.g. for matrix-free operators)
+        auto diag_csr = csr_type::create(exec);
+        diag_extractable->extract_diagonal()->move_to(diag_csr.get());
+        return {diag_csr.release(), std::default_delete<const csr_type>()};
+    }
+    return convert_to_with_sorting<csr_type>(exec, system_matrix,
+                                             skip_sorting);
+}
+
+
+}  // namespace
+
+
 template <typename ValueType, typename IndexType>
 void Jacobi<ValueType, IndexType>::apply_impl(const LinOp *b, LinOp *x) const
 {
@@ -166,6 +197,7 @@ std::unique_ptr<LinOp> Jacobi<ValueType, IndexType>::transpose() const
     res->num_blocks_ = num_blocks_;
     res->blocks_.resize_and_reset(blocks_.get_num_elems());
     res->conditioning_ = conditioning_;
+    res->precision_requests_ = precision_requests_;
     res->parameters_ = parameters_;
     this->get_executor()->run(jacobi::make_transpose_jacobi(
         num_blocks_, parameters_.max_block_size,
@@ -187,6 +219,7 @@ std::unique_ptr<LinOp> Jacobi<ValueType, IndexType>::conj_transpose() const
     res->num_blocks_ = num_blocks_;
     res->blocks_.resize_and_reset(blocks_.get_num_elems());
     res->conditioning_ = conditioning_;
+    res->precision_requests_ = precision_requests_;
     res->parameters_ = parameters_;
     this->get_executor()->run(jacobi::make_conj_transpose_jacobi(
         num_blocks_, parameters_.max_block_size,
@@ -216,10 +249,9 @@ void Jacobi<ValueType, IndexType>::generate(const LinOp *system_matrix,
                                             bool skip_sorting)
 {
     GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix);
-    using csr_type = matrix::Csr<ValueType, IndexType>;
     const auto exec = this->get_executor();
-    auto csr_mtx =
-        convert_to_with_sorting<csr_type>(exec, system_matrix, skip_sorting);
+    auto csr_mtx = convert_to_block_csr<ValueType, IndexType>(
+        exec, system_matrix, parameters_.max_block_size, skip_sorting);
 
     if (parameters_.block_pointers.get_data() == nullptr) {
         this->detect_blocks(csr_mtx.get());
@@ -238,6 +270,9 @@ void Jacobi<ValueType, IndexType>::generate(const LinOp *system_matrix,
             exec, parameters_.block_pointers.get_num_elems() - 1);
         exec->run(jacobi::make_initialize_precisions(precisions, tmp));
         precisions = std::move(tmp);
+        // the generation replaces autodetected precisions, so keep the
+        // requested ones for regenerate()
+        precision_requests_ = precisions;
         conditioning_.resize_and_reset(num_blocks_);
     }
 
@@ -248,6 +283,29 @@ void Jacobi<ValueType, IndexType>::generate(const LinOp *system_matrix,
 }
 
 
+template <typename ValueType, typename IndexType>
+void Jacobi<ValueType, IndexType>::regenerate(
+    std::shared_ptr<const LinOp> system_matrix, bool keep_precisions)
+{
+    GKO_ASSERT_EQUAL_DIMENSIONS(this, system_matrix);
+    const auto exec = this->get_executor();
+    auto csr_mtx = convert_to_block_csr<ValueType, IndexType>(
+        exec, system_matrix.get(), parameters_.max_block_size,
+        parameters_.skip_sorting);
+
+    auto &precisions = parameters_.storage_optimization.block_wise;
+    if (!keep_precisions && precision_requests_.get_num_elems() > 0) {
+        precisions = precision_requests_;
+    }
+    // the block pointers, the block storage and the condition number array
+    // already have the right size, so the blocks are inverted in place
+    exec->run(jacobi::make_generate(
+        csr_mtx.get(), num_blocks_, parameters_.max_block_size,
+        parameters_.accuracy, storage_scheme_, conditioning_, precisions,
+        parameters_.block_pointers, blocks_));
+}
+
+
 #define GKO_DECLARE_JACOBI(ValueType, IndexType) \
     class Jacobi<ValueType, IndexType>
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_JACOBI);
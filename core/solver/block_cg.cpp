@@ -0,0 +1,370 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/block_cg.hpp>
+
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+
+
+#include "core/solver/ir_kernels.hpp"
+
+
+namespace gko {
+namespace solver {
+namespace block_cg {
+
+
+GKO_REGISTER_OPERATION(initialize, ir::initialize);
+
+
+}  // namespace block_cg
+
+
+namespace {
+
+
+// Computes a factor T such that S T has orthonormal columns, given the Gram
+// matrix G = S^H S (on the host, overwritten). G is factorized as
+// G(perm, perm) = L L^H by a Cholesky factorization with symmetric pivoting,
+// which stops once the remaining diagonal entries fall below the squared
+// tolerance relative to the largest diagonal entry. With k steps taken,
+// T(perm(0:k), :) = L(0:k, 0:k)^-H and the other rows of T are zero.
+template <typename ValueType>
+std::unique_ptr<matrix::Dense<ValueType>> compute_orthonormalizing_factor(
+    matrix::Dense<ValueType> *gram, remove_complex<ValueType> tolerance)
+{
+    using real_type = remove_complex<ValueType>;
+    const auto size = gram->get_size()[0];
+    std::vector<size_type> perm(size);
+    std::iota(perm.begin(), perm.end(), size_type{});
+    auto max_diag = zero<real_type>();
+    for (size_type i = 0; i < size; ++i) {
+        max_diag = std::max(max_diag, real(gram->at(i, i)));
+    }
+    const auto threshold = tolerance * tolerance * max_diag;
+    size_type rank{};
+    for (; rank < size; ++rank) {
+        auto pivot = rank;
+        for (auto i = rank + 1; i < size; ++i) {
+            if (real(gram->at(i, i)) > real(gram->at(pivot, pivot))) {
+                pivot = i;
+            }
+        }
+        const auto pivot_value = real(gram->at(pivot, pivot));
+        if (!(pivot_value > threshold)) {
+            break;
+        }
+        std::swap(perm[rank], perm[pivot]);
+        for (size_type j = 0; j < size; ++j) {
+            std::swap(gram->at(rank, j), gram->at(pivot, j));
+        }
+        for (size_type i = 0; i < size; ++i) {
+            std::swap(gram->at(i, rank), gram->at(i, pivot));
+        }
+        const auto diag = std::sqrt(pivot_value);
+        gram->at(rank, rank) = diag;
+        for (auto i = rank + 1; i < size; ++i) {
+            gram->at(i, rank) /= diag;
+        }
+        for (auto i = rank + 1; i < size; ++i) {
+            for (auto j = rank + 1; j < size; ++j) {
+                gram->at(i, j) -= gram->at(i, rank) * conj(gram->at(j, rank));
+            }
+        }
+    }
+    auto factor = matrix::Dense<ValueType>::create(gram->get_executor(),
+                                                   dim<2>{size, rank});
+    factor->fill(zero<ValueType>());
+    std::vector<ValueType> column(rank);
+    for (size_type col = 0; col < rank; ++col) {
+        // solve L^H y = e_col, y is zero below the diagonal
+        for (auto i = col + 1; i-- > 0;) {
+            auto sum = i == col ? one<ValueType>() : zero<ValueType>();
+            for (auto l = i + 1; l <= col; ++l) {
+                sum -= conj(gram->at(l, i)) * column[l];
+            }
+            column[i] = sum / gram->at(i, i);
+            factor->at(perm[i], col) = column[i];
+        }
+    }
+    return factor;
+}
+
+
+// Orthonormalizes the columns of src, dropping the linearly dependent ones,
+// and stores the result in the leading columns of dst. Returns the number of
+// remaining columns.
+template <typename ValueType>
+size_type orthonormalize(matrix::Dense<ValueType> *src,
+                         matrix::Dense<ValueType> *dst,
+                         remove_complex<ValueType> tolerance)
+{
+    using Vector = matrix::Dense<ValueType>;
+    auto exec = src->get_executor();
+    const auto num_rows = src->get_size()[0];
+    const auto num_cols = src->get_size()[1];
+    auto gram = Vector::create(exec, dim<2>{num_cols, num_cols});
+    as<Vector>(src->conj_transpose())->apply(src, lend(gram));
+    auto host_gram = gko::clone(exec->get_master(), gram);
+    auto factor = compute_orthonormalizing_factor(lend(host_gram), tolerance);
+    const auto rank = factor->get_size()[1];
+    if (rank > 0) {
+        src->apply(lend(gko::clone(exec, factor)),
+                   lend(dst->create_submatrix(span{0, num_rows},
+                                              span{0, rank})));
+    }
+    return rank;
+}
+
+
+// Computes the Cholesky factorization A = L L^H of a hermitian positive
+// definite matrix (on the host) in its lower triangle. Returns false if the
+// matrix is not positive definite.
+template <typename ValueType>
+bool cholesky_factorize(matrix::Dense<ValueType> *mtx)
+{
+    using real_type = remove_complex<ValueType>;
+    const auto size = mtx->get_size()[0];
+    for (size_type k = 0; k < size; ++k) {
+        const auto pivot = real(mtx->at(k, k));
+        if (!(pivot > zero<real_type>())) {
+            return false;
+        }
+        const auto diag = std::sqrt(pivot);
+        mtx->at(k, k) = diag;
+        for (auto i = k + 1; i < size; ++i) {
+            mtx->at(i, k) /= diag;
+        }
+        for (auto i = k + 1; i < size; ++i) {
+            for (auto j = k + 1; j <= i; ++j) {
+                mtx->at(i, j) -= mtx->at(i, k) * conj(mtx->at(j, k));
+            }
+        }
+    }
+    return true;
+}
+
+
+// Solves L L^H X = B (on the host) for the Cholesky factor computed by
+// cholesky_factorize, overwriting B with X.
+template <typename ValueType>
+void cholesky_solve(const matrix::Dense<ValueType> *factor,
+                    matrix::Dense<ValueType> *rhs)
+{
+    const auto size = factor->get_size()[0];
+    for (size_type col = 0; col < rhs->get_size()[1]; ++col) {
+        for (size_type i = 0; i < size; ++i) {
+            auto sum = rhs->at(i, col);
+            for (size_type l = 0; l < i; ++l) {
+                sum -= factor->at(i, l) * rhs->at(l, col);
+            }
+            rhs->at(i, col) = sum / factor->at(i, i);
+        }
+        for (auto i = size; i-- > 0;) {
+            auto sum = rhs->at(i, col);
+            for (auto l = i + 1; l < size; ++l) {
+                sum -= conj(factor->at(l, i)) * rhs->at(l, col);
+            }
+            rhs->at(i, col) = sum / factor->at(i, i);
+        }
+    }
+}
+
+
+}  // namespace
+
+
+template <typename ValueType>
+void BlockCg<ValueType>::apply_impl(const LinOp *b, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->apply_dense_impl(dense_b, dense_x);
+        },
+        b, x);
+}
+
+
+template <typename ValueType>
+void BlockCg<ValueType>::apply_dense_impl(
+    const matrix::Dense<ValueType> *dense_b,
+    matrix::Dense<ValueType> *dense_x) const
+{
+    using Vector = matrix::Dense<ValueType>;
+    constexpr uint8 relative_stopping_id{1};
+
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    const auto num_rows = dense_b->get_size()[0];
+    const auto num_rhs = dense_b->get_size()[1];
+    const auto tolerance = parameters_.deflation_tolerance;
+    const span all_rows{0, num_rows};
+
+    auto one_op = initialize<Vector>({one<ValueType>()}, exec);
+    auto neg_one_op = initialize<Vector>({-one<ValueType>()}, exec);
+
+    auto r = Vector::create_with_config_of(dense_b);
+    auto precond = this->get_preconditioner();
+    // without preconditioner, z = r
+    const auto uses_identity =
+        dynamic_cast<const matrix::Identity<ValueType> *>(lend(precond));
+    auto z = uses_identity ? std::unique_ptr<Vector>{}
+                           : Vector::create_with_config_of(dense_b);
+    const auto z_ptr = uses_identity ? r.get() : z.get();
+    // the blocks of search directions P and of Q = A P have at most as many
+    // columns as there are right-hand sides, only their leading columns are
+    // used after deflation. w is used for the intermediate results of the
+    // orthonormalization.
+    auto p = Vector::create(exec, dim<2>{num_rows, num_rhs});
+    auto q = Vector::create(exec, dim<2>{num_rows, num_rhs});
+    auto w = Vector::create(exec, dim<2>{num_rows, num_rhs});
+
+    // orthonormalizes the columns of src into the leading columns of p. The
+    // Cholesky QR factorization is applied twice, as forming the Gram matrix
+    // squares its condition number, which degrades the orthogonality of a
+    // single pass.
+    auto update_search_directions = [&](Vector *src) {
+        auto rank = orthonormalize(src, lend(w), tolerance);
+        if (rank > 0) {
+            rank = orthonormalize(
+                lend(w->create_submatrix(all_rows, span{0, rank})), lend(p),
+                tolerance);
+        }
+        return rank;
+    };
+
+    bool one_changed{};
+    Array<stopping_status> stop_status(exec, num_rhs);
+    exec->run(block_cg::make_initialize(&stop_status));
+
+    // r = b - A * x
+    r->copy_from(dense_b);
+    system_matrix_->apply(lend(neg_one_op), dense_x, lend(one_op), lend(r));
+    auto stop_criterion = stop_criterion_factory_->generate(
+        system_matrix_,
+        std::shared_ptr<const LinOp>(dense_b, [](const LinOp *) {}), dense_x,
+        lend(r));
+
+    if (!uses_identity) {
+        precond->apply(lend(r), z_ptr);
+    }
+    auto rank = update_search_directions(z_ptr);
+
+    int iter = -1;
+    while (true) {
+        ++iter;
+        this->template log<log::Logger::iteration_complete>(this, iter,
+                                                            lend(r), dense_x);
+
+        if (stop_criterion->update()
+                .num_iterations(iter)
+                .residual(lend(r))
+                .solution(dense_x)
+                .check(relative_stopping_id, true, &stop_status,
+                       &one_changed)) {
+            break;
+        }
+        if (rank == 0) {
+            // the block Krylov space is exhausted
+            break;
+        }
+
+        auto cur_p = p->create_submatrix(all_rows, span{0, rank});
+        auto cur_q = q->create_submatrix(all_rows, span{0, rank});
+        // Q = A * P
+        system_matrix_->apply(lend(cur_p), lend(cur_q));
+        // Delta = P^H * Q, alpha = Delta^-1 * P^H * R
+        auto p_conj_trans = as<Vector>(cur_p->conj_transpose());
+        auto delta = Vector::create(exec, dim<2>{rank, rank});
+        auto alpha = Vector::create(exec, dim<2>{rank, num_rhs});
+        p_conj_trans->apply(lend(cur_q), lend(delta));
+        p_conj_trans->apply(lend(r), lend(alpha));
+        auto host_delta = gko::clone(host_exec, delta);
+        if (!cholesky_factorize(lend(host_delta))) {
+            // the system matrix is not positive definite
+            break;
+        }
+        auto host_alpha = gko::clone(host_exec, alpha);
+        cholesky_solve(lend(host_delta), lend(host_alpha));
+        alpha->copy_from(lend(host_alpha));
+        // X = X + P * alpha, R = R - Q * alpha
+        cur_p->apply(lend(one_op), lend(alpha), lend(one_op), dense_x);
+        cur_q->apply(lend(neg_one_op), lend(alpha), lend(one_op), lend(r));
+
+        if (!uses_identity) {
+            precond->apply(lend(r), z_ptr);
+        }
+        // gamma = Delta^-1 * Q^H * Z
+        auto gamma = Vector::create(exec, dim<2>{rank, num_rhs});
+        as<Vector>(cur_q->conj_transpose())->apply(z_ptr, lend(gamma));
+        auto host_gamma = gko::clone(host_exec, gamma);
+        cholesky_solve(lend(host_delta), lend(host_gamma));
+        gamma->copy_from(lend(host_gamma));
+        // P = orth(Z - P * gamma), Q is no longer needed and stores the block
+        q->copy_from(z_ptr);
+        cur_p->apply(lend(neg_one_op), lend(gamma), lend(one_op), lend(q));
+        rank = update_search_directions(lend(q));
+    }
+}
+
+
+template <typename ValueType>
+void BlockCg<ValueType>::apply_impl(const LinOp *alpha, const LinOp *b,
+                                    const LinOp *beta, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_dense_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_BLOCK_CG(_type) class BlockCg<_type>
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_BLOCK_CG);
+
+
+}  // namespace solver
+}  // namespace gko
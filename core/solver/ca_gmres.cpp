@@ -0,0 +1,615 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/ca_gmres.hpp>
+
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+
+
+#include "core/solver/host_eigensolver.hpp"
+#include "core/solver/ir_kernels.hpp"
+
+
+namespace gko {
+namespace solver {
+namespace ca_gmres {
+
+
+GKO_REGISTER_OPERATION(initialize, ir::initialize);
+
+
+}  // namespace ca_gmres
+
+
+namespace {
+
+
+template <typename T>
+void assign_shift(T &value, std::complex<T> shift)
+{
+    value = shift.real();
+}
+
+template <typename T>
+void assign_shift(std::complex<T> &value, std::complex<T> shift)
+{
+    value = shift;
+}
+
+
+// Orders the given values (Leja ordering), such that each value maximizes the
+// product of the distances to the previous ones. This keeps the Newton basis
+// well-conditioned. If pair_conjugates is set, the complex conjugate of each
+// value with positive imaginary part immediately follows it.
+template <typename T>
+std::vector<std::complex<T>> compute_leja_ordering(
+    const std::vector<std::complex<T>> &values, bool pair_conjugates)
+{
+    using C = std::complex<T>;
+    std::vector<C> candidates;
+    for (auto value : values) {
+        const auto tolerance =
+            std::sqrt(std::numeric_limits<T>::epsilon()) * std::abs(value);
+        if (!pair_conjugates) {
+            candidates.push_back(value);
+        } else if (std::abs(value.imag()) <= tolerance) {
+            candidates.push_back(C(value.real()));
+        } else if (value.imag() > T{}) {
+            candidates.push_back(value);
+        }
+    }
+    std::vector<C> ordering;
+    std::vector<bool> used(candidates.size());
+    for (size_type picked = 0; picked < candidates.size(); ++picked) {
+        size_type best{};
+        auto best_score = -std::numeric_limits<T>::infinity();
+        for (size_type i = 0; i < candidates.size(); ++i) {
+            if (used[i]) {
+                continue;
+            }
+            auto score = ordering.empty() ? std::log(std::abs(candidates[i]))
+                                          : T{};
+            for (auto chosen : ordering) {
+                score += std::log(std::abs(candidates[i] - chosen));
+            }
+            if (score > best_score || best_score ==
+                                          -std::numeric_limits<T>::infinity()) {
+                best = i;
+                best_score = score;
+            }
+        }
+        used[best] = true;
+        ordering.push_back(candidates[best]);
+        if (pair_conjugates && candidates[best].imag() > T{}) {
+            ordering.push_back(std::conj(candidates[best]));
+        }
+    }
+    return ordering;
+}
+
+
+// One pass of block classical Gram-Schmidt with a Cholesky QR factorization
+// of the block (BCGS-PIP). The basis vectors are the rows of basis. The block
+// W of rows [start, start + size) is orthogonalized against the rows
+// Q = [0, start) and internally, such that W_old = Q C + W_new R. All inner
+// products are computed by a single matrix-matrix product. Returns the
+// number of columns that are numerically linearly independent, C and R are
+// truncated accordingly.
+template <typename ValueType>
+size_type orthogonalize_block(matrix::Dense<ValueType> *basis, size_type start,
+                              size_type size, matrix::Dense<ValueType> *coeffs,
+                              matrix::Dense<ValueType> *factor)
+{
+    using Vector = matrix::Dense<ValueType>;
+    using real_type = remove_complex<ValueType>;
+    auto exec = basis->get_executor();
+    auto host_exec = exec->get_master();
+    const span all_cols{0, basis->get_size()[1]};
+    auto neg_one_op = initialize<Vector>({-one<ValueType>()}, exec);
+    auto one_op = initialize<Vector>({one<ValueType>()}, exec);
+
+    auto block = basis->create_submatrix(span{start, start + size}, all_cols);
+    // products = conj([Q W]^H W)
+    auto products = Vector::create(exec, dim<2>{start + size, size});
+    basis->create_submatrix(span{0, start + size}, all_cols)
+        ->apply(lend(as<Vector>(block->conj_transpose())), lend(products));
+    auto host_products = gko::clone(host_exec, products);
+    for (size_type i = 0; i < start; ++i) {
+        for (size_type k = 0; k < size; ++k) {
+            coeffs->at(i, k) = conj(host_products->at(i, k));
+        }
+    }
+    // W = W - Q C, i.e. W^T = W^T - C^T Q^T
+    if (start > 0) {
+        auto coeffs_trans = Vector::create(host_exec, dim<2>{size, start});
+        for (size_type i = 0; i < start; ++i) {
+            for (size_type k = 0; k < size; ++k) {
+                coeffs_trans->at(k, i) = coeffs->at(i, k);
+            }
+        }
+        gko::clone(exec, coeffs_trans)
+            ->apply(lend(neg_one_op),
+                    lend(basis->create_submatrix(span{0, start}, all_cols)),
+                    lend(one_op), lend(block));
+    }
+    // Cholesky factorization R^H R of W_new^H W_new = G - C^H C
+    size_type rank{};
+    for (; rank < size; ++rank) {
+        const auto k = rank;
+        for (size_type i = 0; i <= k; ++i) {
+            auto value = conj(host_products->at(start + i, k));
+            for (size_type l = 0; l < start; ++l) {
+                value -= conj(coeffs->at(l, i)) * coeffs->at(l, k);
+            }
+            for (size_type l = 0; l < i; ++l) {
+                value -= conj(factor->at(l, i)) * factor->at(l, k);
+            }
+            if (i < k) {
+                factor->at(i, k) = value / factor->at(i, i);
+            } else {
+                const auto norm = real(host_products->at(start + k, k));
+                if (!(real(value) >
+                      10 * std::numeric_limits<real_type>::epsilon() * norm)) {
+                    // linearly dependent on the previous vectors
+                    return rank;
+                }
+                factor->at(k, k) = std::sqrt(real(value));
+            }
+        }
+        for (auto i = k + 1; i < size; ++i) {
+            factor->at(i, k) = zero<ValueType>();
+        }
+        // W_new(:, k) = (W(:, k) - W_new(:, 0:k) R(0:k, k)) / R(k, k)
+        auto row = block->create_submatrix(span{k, k + 1}, all_cols);
+        if (k > 0) {
+            auto row_coeffs = Vector::create(host_exec, dim<2>{1, k});
+            for (size_type i = 0; i < k; ++i) {
+                row_coeffs->at(0, i) = factor->at(i, k);
+            }
+            gko::clone(exec, row_coeffs)
+                ->apply(lend(neg_one_op),
+                        lend(block->create_submatrix(span{0, k}, all_cols)),
+                        lend(one_op), lend(row));
+        }
+        row->scale(lend(
+            initialize<Vector>({one<ValueType>() / factor->at(k, k)}, exec)));
+    }
+    return rank;
+}
+
+
+}  // namespace
+
+
+template <typename ValueType>
+void CaGmres<ValueType>::apply_impl(const LinOp *b, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->apply_dense_impl(dense_b, dense_x);
+        },
+        b, x);
+}
+
+
+template <typename ValueType>
+void CaGmres<ValueType>::apply_dense_impl(
+    const matrix::Dense<ValueType> *dense_b,
+    matrix::Dense<ValueType> *dense_x) const
+{
+    using Vector = matrix::Dense<ValueType>;
+    const auto num_rows = dense_b->get_size()[0];
+    const auto num_rhs = dense_b->get_size()[1];
+    if (num_rhs == 1) {
+        this->solve_single(dense_b, dense_x);
+        return;
+    }
+    for (size_type col = 0; col < num_rhs; ++col) {
+        // the view of b is only read
+        auto b_col = const_cast<Vector *>(dense_b)->create_submatrix(
+            span{0, num_rows}, span{col, col + 1});
+        auto x_col =
+            dense_x->create_submatrix(span{0, num_rows}, span{col, col + 1});
+        this->solve_single(lend(b_col), lend(x_col));
+    }
+}
+
+
+template <typename ValueType>
+void CaGmres<ValueType>::solve_single(const matrix::Dense<ValueType> *dense_b,
+                                      matrix::Dense<ValueType> *dense_x) const
+{
+    using Vector = matrix::Dense<ValueType>;
+    using NormVector = matrix::Dense<remove_complex<ValueType>>;
+    using real_type = remove_complex<ValueType>;
+    using complex_type = to_complex<ValueType>;
+    constexpr uint8 relative_stopping_id{1};
+
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    const auto num_rows = dense_b->get_size()[0];
+    const auto krylov_dim = krylov_dim_;
+    const auto step_size = step_size_;
+    const span all_cols{0, num_rows};
+
+    auto one_op = initialize<Vector>({one<ValueType>()}, exec);
+    auto neg_one_op = initialize<Vector>({-one<ValueType>()}, exec);
+
+    // the basis vectors are stored as rows, so each of them is contiguous and
+    // can be used as a column vector, while blocks of them form matrices
+    auto basis = Vector::create(exec, dim<2>{krylov_dim + 1, num_rows});
+    auto basis_vector = [&](size_type k) {
+        return Vector::create(
+            exec, dim<2>{num_rows, 1},
+            Array<ValueType>::view(exec, num_rows,
+                                   basis->get_values() + k * num_rows),
+            1);
+    };
+    auto residual = Vector::create(exec, dim<2>{num_rows, 1});
+    auto preconditioned_vector = Vector::create(exec, dim<2>{num_rows, 1});
+    auto before_preconditioner = Vector::create(exec, dim<2>{num_rows, 1});
+    auto after_preconditioner = Vector::create(exec, dim<2>{num_rows, 1});
+    auto residual_norm = NormVector::create(exec, dim<2>{1, 1});
+    auto host_residual_norm = NormVector::create(host_exec, dim<2>{1, 1});
+    // Hessenberg matrix of the Arnoldi relation, and its triangular factor
+    // obtained by Givens rotations
+    auto hessenberg =
+        Vector::create(host_exec, dim<2>{krylov_dim + 1, krylov_dim});
+    auto triangular =
+        Vector::create(host_exec, dim<2>{krylov_dim + 1, krylov_dim});
+    std::vector<ValueType> givens_cos(krylov_dim);
+    std::vector<ValueType> givens_sin(krylov_dim);
+    std::vector<ValueType> residual_norm_collection(krylov_dim + 1);
+    auto coeffs = Vector::create(host_exec, dim<2>{krylov_dim + 1, step_size});
+    auto factor = Vector::create(host_exec, dim<2>{step_size, step_size});
+    auto coeffs_2 =
+        Vector::create(host_exec, dim<2>{krylov_dim + 1, step_size});
+    auto factor_2 = Vector::create(host_exec, dim<2>{step_size, step_size});
+
+    auto precond = this->get_preconditioner();
+    const bool newton = parameters_.basis == ca_gmres::basis::newton;
+    // shifts of the Newton basis, empty for the monomial basis
+    std::vector<complex_type> shifts;
+    // scaling of the basis vectors, estimates the norm of A M
+    auto sigma = zero<real_type>();
+
+    bool one_changed{};
+    Array<stopping_status> stop_status(exec, 1);
+    exec->run(ca_gmres::make_initialize(&stop_status));
+
+    // residual = b - A * x
+    auto update_residual = [&] {
+        system_matrix_->apply(dense_x, lend(residual));
+        residual->scale(lend(neg_one_op));
+        residual->add_scaled(lend(one_op), dense_b);
+    };
+    update_residual();
+    auto stop_criterion = stop_criterion_factory_->generate(
+        system_matrix_,
+        std::shared_ptr<const LinOp>(dense_b, [](const LinOp *) {}), dense_x,
+        lend(residual));
+    auto check_convergence = [&](size_type iter) {
+        this->template log<log::Logger::iteration_complete>(
+            this, iter, lend(residual), dense_x, lend(residual_norm));
+        return stop_criterion->update()
+            .num_iterations(iter)
+            .residual(lend(residual))
+            .residual_norm(lend(residual_norm))
+            .solution(dense_x)
+            .check(relative_stopping_id, true, &stop_status, &one_changed);
+    };
+
+    size_type total_iter{};
+    while (true) {
+        residual->compute_norm2(lend(residual_norm));
+        host_residual_norm->copy_from(lend(residual_norm));
+        const auto beta = host_residual_norm->at(0, 0);
+        if (check_convergence(total_iter) || !(beta > zero<real_type>())) {
+            break;
+        }
+        // v_0 = r / beta
+        auto first_vector = basis_vector(0);
+        first_vector->copy_from(lend(residual));
+        first_vector->scale(
+            lend(initialize<Vector>({one<ValueType>() / beta}, exec)));
+        std::fill(residual_norm_collection.begin(),
+                  residual_norm_collection.end(), zero<ValueType>());
+        residual_norm_collection[0] = beta;
+        hessenberg->fill(zero<ValueType>());
+
+        size_type num_cols{};
+        bool converged{};
+        while (num_cols < krylov_dim) {
+            const auto start = num_cols;
+            const auto block_size = std::min(step_size, krylov_dim - start);
+            // change of basis A [w_0 ... w_{s-1}] = [w_0 ... w_s] B
+            auto change_of_basis =
+                Vector::create(host_exec, dim<2>{block_size + 1, block_size});
+            change_of_basis->fill(zero<ValueType>());
+            // matrix powers kernel: w_{k+1} = (A M w_k - theta_k w_k) / sigma
+            for (size_type k = 0; k < block_size; ++k) {
+                auto src = basis_vector(start + k);
+                auto dst = basis_vector(start + k + 1);
+                precond->apply(lend(src), lend(preconditioned_vector));
+                system_matrix_->apply(lend(preconditioned_vector), lend(dst));
+                if (sigma == zero<real_type>()) {
+                    dst->compute_norm2(lend(residual_norm));
+                    host_residual_norm->copy_from(lend(residual_norm));
+                    sigma = host_residual_norm->at(0, 0);
+                    if (!(sigma > zero<real_type>())) {
+                        sigma = one<real_type>();
+                    }
+                }
+                auto shift = zero<ValueType>();
+                if (!shifts.empty()) {
+                    const auto theta = shifts[k % shifts.size()];
+                    assign_shift(shift, theta);
+                    if (!is_complex<ValueType>() && k > 0 &&
+                        shifts[(k - 1) % shifts.size()].imag() >
+                            zero<real_type>()) {
+                        // second shift of a complex conjugate pair
+                        const auto prev = shifts[(k - 1) % shifts.size()];
+                        const auto imag_sq = prev.imag() * prev.imag();
+                        assign_shift(shift, prev);
+                        dst->add_scaled(
+                            lend(initialize<Vector>(
+                                {static_cast<ValueType>(imag_sq / sigma)},
+                                exec)),
+                            lend(basis_vector(start + k - 1)));
+                        change_of_basis->at(k - 1, k) =
+                            static_cast<ValueType>(-imag_sq / sigma);
+                    }
+                    dst->add_scaled(lend(initialize<Vector>({-shift}, exec)),
+                                    lend(src));
+                }
+                dst->scale(lend(
+                    initialize<Vector>({one<ValueType>() / sigma}, exec)));
+                change_of_basis->at(k, k) = shift;
+                change_of_basis->at(k + 1, k) = sigma;
+            }
+
+            // BCGS-PIP2: W = Q C1 + W1 R1, W1 = Q C2 + W2 R2
+            // => W = Q (C1 + C2 R1) + W2 (R2 R1)
+            const auto rank_1 = orthogonalize_block(
+                lend(basis), start + 1, block_size, lend(coeffs), lend(factor));
+            if (rank_1 < block_size) {
+                // the first dependent vector was only orthogonalized against
+                // Q, the second pass expresses it in terms of W2
+                for (size_type i = 0; i < rank_1; ++i) {
+                    factor->at(i, rank_1) = zero<ValueType>();
+                }
+                factor->at(rank_1, rank_1) = one<ValueType>();
+            }
+            const auto rank_2 = orthogonalize_block(
+                lend(basis), start + 1, std::min(rank_1 + 1, block_size),
+                lend(coeffs_2), lend(factor_2));
+            const auto new_cols = std::min(rank_1, rank_2);
+            // on a breakdown, the first dependent vector lies in the span of
+            // the basis, i.e. its part in W2 R2 vanishes, and the Hessenberg
+            // matrix gets one more column with a zero subdiagonal entry
+            const bool breakdown = new_cols < block_size;
+            const auto num_new = new_cols + (breakdown ? 1 : 0);
+            if (breakdown) {
+                factor_2->at(new_cols, new_cols) = zero<ValueType>();
+            }
+            // backwards, as R2 R1 is computed in place
+            for (auto k = num_new; k-- > 0;) {
+                for (size_type i = 0; i <= start; ++i) {
+                    auto value = coeffs->at(i, k);
+                    for (size_type l = 0; l <= k; ++l) {
+                        value += coeffs_2->at(i, l) * factor->at(l, k);
+                    }
+                    coeffs->at(i, k) = value;
+                }
+                for (size_type i = 0; i <= k; ++i) {
+                    auto value = zero<ValueType>();
+                    for (size_type l = i; l <= k; ++l) {
+                        value += factor_2->at(i, l) * factor->at(l, k);
+                    }
+                    factor_2->at(i, k) = value;
+                }
+            }
+            // [w_0 ... w_t] = V T with T(:, 0) = e_start and
+            // T(:, k + 1) = [C(:, k); R(:, k)]
+            const auto num_basis = start + 1 + new_cols;
+            auto transform =
+                Vector::create(host_exec, dim<2>{num_basis, num_new + 1});
+            transform->fill(zero<ValueType>());
+            transform->at(start, 0) = one<ValueType>();
+            for (size_type k = 0; k < num_new; ++k) {
+                for (size_type i = 0; i <= start; ++i) {
+                    transform->at(i, k + 1) = coeffs->at(i, k);
+                }
+                for (size_type i = 0; i <= k && i < new_cols; ++i) {
+                    transform->at(start + 1 + i, k + 1) = factor_2->at(i, k);
+                }
+            }
+            // A V(:, start:start+t) = (T B - [H X; 0]) U^-1, where X are the
+            // first start rows of T(:, 0:t) and U the remaining ones
+            for (size_type k = 0; k < num_new; ++k) {
+                const auto col = start + k;
+                for (size_type i = 0; i < num_basis; ++i) {
+                    auto value = zero<ValueType>();
+                    for (size_type l = 0; l <= num_new; ++l) {
+                        value +=
+                            transform->at(i, l) * change_of_basis->at(l, k);
+                    }
+                    if (i <= start) {
+                        for (size_type l = 0; l < start; ++l) {
+                            value -= hessenberg->at(i, l) * transform->at(l, k);
+                        }
+                    }
+                    for (size_type l = 0; l < k; ++l) {
+                        value -= hessenberg->at(i, start + l) *
+                                 transform->at(start + l, k);
+                    }
+                    hessenberg->at(i, col) = value / transform->at(col, k);
+                }
+            }
+            // Givens rotations of the new columns
+            for (size_type col = start; col < start + num_new; ++col) {
+                for (size_type i = 0; i <= col + 1; ++i) {
+                    triangular->at(i, col) = hessenberg->at(i, col);
+                }
+                for (size_type i = 0; i < col; ++i) {
+                    const auto temp =
+                        givens_cos[i] * triangular->at(i, col) +
+                        givens_sin[i] * triangular->at(i + 1, col);
+                    triangular->at(i + 1, col) =
+                        -conj(givens_sin[i]) * triangular->at(i, col) +
+                        conj(givens_cos[i]) * triangular->at(i + 1, col);
+                    triangular->at(i, col) = temp;
+                }
+                const auto this_hess = triangular->at(col, col);
+                const auto next_hess = triangular->at(col + 1, col);
+                if (this_hess == zero<ValueType>()) {
+                    givens_cos[col] = zero<ValueType>();
+                    givens_sin[col] = one<ValueType>();
+                } else {
+                    const auto hypotenuse = std::sqrt(
+                        squared_norm(this_hess) + squared_norm(next_hess));
+                    givens_cos[col] = conj(this_hess) / hypotenuse;
+                    givens_sin[col] = conj(next_hess) / hypotenuse;
+                }
+                triangular->at(col, col) = givens_cos[col] * this_hess +
+                                           givens_sin[col] * next_hess;
+                triangular->at(col + 1, col) = zero<ValueType>();
+                residual_norm_collection[col + 1] =
+                    -conj(givens_sin[col]) * residual_norm_collection[col];
+                residual_norm_collection[col] =
+                    givens_cos[col] * residual_norm_collection[col];
+            }
+            num_cols += num_new;
+            total_iter += num_new;
+            host_residual_norm->at(0, 0) =
+                abs(residual_norm_collection[num_cols]);
+            residual_norm->copy_from(lend(host_residual_norm));
+            if (check_convergence(total_iter)) {
+                converged = true;
+                break;
+            }
+            if (breakdown) {
+                // the basis cannot be extended, restart the cycle
+                break;
+            }
+        }
+        if (num_cols == 0) {
+            // no progress possible
+            break;
+        }
+
+        // y = triangular \ residual_norm_collection
+        auto host_y = Vector::create(host_exec, dim<2>{1, num_cols});
+        for (auto i = num_cols; i-- > 0;) {
+            auto value = residual_norm_collection[i];
+            for (auto l = i + 1; l < num_cols; ++l) {
+                value -= triangular->at(i, l) * host_y->at(0, l);
+            }
+            host_y->at(0, i) = value / triangular->at(i, i);
+        }
+        // x = x + M V y, computed as (V y)^T = y^T V^T
+        auto before_preconditioner_trans = Vector::create(
+            exec, dim<2>{1, num_rows},
+            Array<ValueType>::view(exec, num_rows,
+                                   before_preconditioner->get_values()),
+            num_rows);
+        gko::clone(exec, host_y)
+            ->apply(lend(basis->create_submatrix(span{0, num_cols}, all_cols)),
+                    lend(before_preconditioner_trans));
+        precond->apply(lend(before_preconditioner),
+                       lend(after_preconditioner));
+        dense_x->add_scaled(lend(one_op), lend(after_preconditioner));
+        if (converged) {
+            break;
+        }
+        if (newton && shifts.empty() && num_cols == krylov_dim) {
+            // Ritz values of the first cycle in Leja ordering, complex
+            // conjugate pairs of a real basis must not be split
+            std::vector<std::complex<real_type>> host_hessenberg(
+                krylov_dim * krylov_dim);
+            for (size_type i = 0; i < krylov_dim; ++i) {
+                for (size_type j = 0; j < krylov_dim; ++j) {
+                    host_hessenberg[i * krylov_dim + j] =
+                        static_cast<std::complex<real_type>>(
+                            hessenberg->at(i, j));
+                }
+            }
+            const auto ordering = compute_leja_ordering(
+                detail::compute_hessenberg_eigenvalues(host_hessenberg,
+                                                       krylov_dim),
+                !is_complex<ValueType>());
+            for (size_type k = 0; k < step_size && !ordering.empty(); ++k) {
+                shifts.push_back(ordering[k % ordering.size()]);
+            }
+            if (!is_complex<ValueType>() && !shifts.empty() &&
+                shifts.back().imag() > zero<real_type>()) {
+                shifts.back() = shifts.back().real();
+            }
+        }
+        update_residual();
+    }
+}
+
+
+template <typename ValueType>
+void CaGmres<ValueType>::apply_impl(const LinOp *alpha, const LinOp *b,
+                                    const LinOp *beta, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_dense_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_CA_GMRES(_type) class CaGmres<_type>
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CA_GMRES);
+
+
+}  // namespace solver
+}  // namespace gko
@@ -0,0 +1,337 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/chebyshev.hpp>
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+
+
+#include "core/solver/chebyshev_kernels.hpp"
+
+
+namespace gko {
+namespace solver {
+namespace chebyshev {
+
+
+GKO_REGISTER_OPERATION(initialize, chebyshev::initialize);
+GKO_REGISTER_OPERATION(step, chebyshev::step);
+
+
+}  // namespace chebyshev
+
+
+namespace {
+
+
+// counts the eigenvalues of the symmetric tridiagonal matrix with the given
+// diagonal and squared off-diagonal that are smaller than shift, using the
+// signs of the Sturm sequence
+template <typename T>
+size_type count_smaller_eigenvalues(const std::vector<T> &diag,
+                                    const std::vector<T> &off_diag_sq, T shift)
+{
+    size_type count{};
+    auto q = one<T>();
+    for (size_type i = 0; i < diag.size(); ++i) {
+        const auto prev = i > 0 ? off_diag_sq[i - 1] / q : zero<T>();
+        q = diag[i] - shift - prev;
+        if (q == zero<T>()) {
+            q = -std::numeric_limits<T>::epsilon() * (abs(diag[i]) + one<T>());
+        }
+        count += q < zero<T>();
+    }
+    return count;
+}
+
+
+// computes the k-th smallest eigenvalue of a symmetric tridiagonal matrix by
+// bisection within the Gershgorin bounds
+template <typename T>
+T compute_tridiagonal_eigenvalue(const std::vector<T> &diag,
+                                 const std::vector<T> &off_diag_sq,
+                                 size_type k)
+{
+    const auto n = diag.size();
+    auto lower = diag[0];
+    auto upper = diag[0];
+    for (size_type i = 0; i < n; ++i) {
+        auto radius = zero<T>();
+        if (i > 0) {
+            radius += std::sqrt(off_diag_sq[i - 1]);
+        }
+        if (i + 1 < n) {
+            radius += std::sqrt(off_diag_sq[i]);
+        }
+        lower = std::min(lower, diag[i] - radius);
+        upper = std::max(upper, diag[i] + radius);
+    }
+    for (int it = 0; it < 100 && lower < upper; ++it) {
+        const auto mid = (lower + upper) / 2;
+        if (mid == lower || mid == upper) {
+            break;
+        }
+        if (count_smaller_eigenvalues(diag, off_diag_sq, mid) > k) {
+            upper = mid;
+        } else {
+            lower = mid;
+        }
+    }
+    return (lower + upper) / 2;
+}
+
+
+}  // namespace
+
+
+template <typename ValueType>
+void Chebyshev<ValueType>::estimate_eigenvalues()
+{
+    using Vector = matrix::Dense<ValueType>;
+    using real_type = remove_complex<ValueType>;
+    auto exec = this->get_executor();
+    const auto num_rows = system_matrix_->get_size()[0];
+    if (num_rows == 0) {
+        return;
+    }
+    if (parameters_.num_estimation_iterations == 0) {
+        GKO_NOT_SUPPORTED(system_matrix_);
+    }
+    const dim<2> vector_size{num_rows, 1};
+    auto precond = this->get_preconditioner();
+
+    // the right-hand side should contain components of all eigenvectors, so
+    // use a (reproducible) random one
+    auto host_r = Vector::create(exec->get_master(), vector_size);
+    std::default_random_engine engine(42);
+    std::uniform_real_distribution<real_type> dist(0.5, 1.5);
+    for (size_type row = 0; row < num_rows; ++row) {
+        host_r->at(row, 0) = dist(engine);
+    }
+    auto r = gko::clone(exec, host_r);
+    auto z = Vector::create(exec, vector_size);
+    auto p = Vector::create(exec, vector_size);
+    auto q = Vector::create(exec, vector_size);
+    auto dot = Vector::create(exec, dim<2>{1, 1});
+    auto compute_dot = [&](const Vector *a, const Vector *b) {
+        a->compute_dot(b, dot.get());
+        return real(exec->copy_val_to_host(dot->get_const_values()));
+    };
+    auto one_op = initialize<Vector>({one<ValueType>()}, exec);
+
+    // run the preconditioned conjugate gradient method and store its
+    // coefficients, which determine the Lanczos matrix
+    std::vector<real_type> alphas;
+    std::vector<real_type> betas;
+    precond->apply(r.get(), z.get());
+    p->copy_from(z.get());
+    auto rho = compute_dot(r.get(), z.get());
+    const auto initial_rho = rho;
+    for (size_type it = 0; it < parameters_.num_estimation_iterations; ++it) {
+        system_matrix_->apply(p.get(), q.get());
+        const auto p_q = compute_dot(p.get(), q.get());
+        if (!(rho > zero<real_type>()) || !(p_q > zero<real_type>())) {
+            // not positive definite (or converged), stop here
+            break;
+        }
+        const auto alpha = rho / p_q;
+        alphas.push_back(alpha);
+        r->add_scaled(initialize<Vector>({-alpha}, exec).get(), q.get());
+        precond->apply(r.get(), z.get());
+        const auto new_rho = compute_dot(r.get(), z.get());
+        const auto beta = new_rho / rho;
+        rho = new_rho;
+        if (!(rho > std::numeric_limits<real_type>::epsilon() * initial_rho)) {
+            // the Krylov space is invariant, the Lanczos matrix is complete
+            break;
+        }
+        betas.push_back(beta);
+        p->scale(initialize<Vector>({beta}, exec).get());
+        p->add_scaled(one_op.get(), z.get());
+    }
+    if (alphas.empty()) {
+        GKO_NOT_SUPPORTED(system_matrix_);
+    }
+
+    const auto size = alphas.size();
+    std::vector<real_type> diag(size);
+    std::vector<real_type> off_diag_sq(size);
+    for (size_type i = 0; i < size; ++i) {
+        diag[i] = one<real_type>() / alphas[i];
+        if (i > 0) {
+            diag[i] += betas[i - 1] / alphas[i - 1];
+        }
+        if (i + 1 < size) {
+            off_diag_sq[i] = betas[i] / (alphas[i] * alphas[i]);
+        }
+    }
+    const auto safety = parameters_.estimation_safety_factor;
+    upper_eigenvalue_ =
+        compute_tridiagonal_eigenvalue(diag, off_diag_sq, size - 1) *
+        (one<real_type>() + safety);
+    if (parameters_.eigenvalue_ratio > zero<real_type>()) {
+        lower_eigenvalue_ = upper_eigenvalue_ / parameters_.eigenvalue_ratio;
+    } else {
+        lower_eigenvalue_ = compute_tridiagonal_eigenvalue(diag, off_diag_sq,
+                                                           size_type{}) *
+                            (one<real_type>() - safety);
+    }
+}
+
+
+template <typename ValueType>
+void Chebyshev<ValueType>::apply_impl(const LinOp *b, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->apply_dense_impl(dense_b, dense_x);
+        },
+        b, x);
+}
+
+
+template <typename ValueType>
+void Chebyshev<ValueType>::apply_dense_impl(
+    const matrix::Dense<ValueType> *dense_b,
+    matrix::Dense<ValueType> *dense_x) const
+{
+    using Vector = matrix::Dense<ValueType>;
+    using real_type = remove_complex<ValueType>;
+    constexpr uint8 relative_stopping_id{1};
+
+    auto exec = this->get_executor();
+    auto one_op = initialize<Vector>({one<ValueType>()}, exec);
+    auto neg_one_op = initialize<Vector>({-one<ValueType>()}, exec);
+
+    auto r = Vector::create_with_config_of(dense_b);
+    auto d = Vector::create_with_config_of(dense_b);
+    auto precond = this->get_preconditioner();
+    // without preconditioner, z = r
+    const auto uses_identity =
+        dynamic_cast<const matrix::Identity<ValueType> *>(lend(precond));
+    auto z = uses_identity ? std::unique_ptr<Vector>{}
+                           : Vector::create_with_config_of(dense_b);
+    const auto z_ptr = uses_identity ? r.get() : z.get();
+
+    bool one_changed{};
+    Array<stopping_status> stop_status(exec, dense_b->get_size()[1]);
+    exec->run(
+        chebyshev::make_initialize(dense_b, lend(r), lend(d), &stop_status));
+    if (parameters_.zero_initial_guess) {
+        dense_x->fill(zero<ValueType>());
+    } else {
+        // r = b - A * x
+        system_matrix_->apply(lend(neg_one_op), dense_x, lend(one_op),
+                              lend(r));
+    }
+
+    auto stop_criterion = stop_criterion_factory_->generate(
+        system_matrix_,
+        std::shared_ptr<const LinOp>(dense_b, [](const LinOp *) {}), dense_x,
+        lend(r));
+
+    const auto theta = (upper_eigenvalue_ + lower_eigenvalue_) / 2;
+    const auto delta = (upper_eigenvalue_ - lower_eigenvalue_) / 2;
+    const auto sigma = theta / delta;
+    auto rho = one<real_type>() / sigma;
+
+    int iter = -1;
+    while (true) {
+        ++iter;
+        this->template log<log::Logger::iteration_complete>(this, iter,
+                                                            lend(r), dense_x);
+
+        if (stop_criterion->update()
+                .num_iterations(iter)
+                .residual(lend(r))
+                .solution(dense_x)
+                .check(relative_stopping_id, true, &stop_status,
+                       &one_changed)) {
+            break;
+        }
+
+        if (!uses_identity) {
+            precond->apply(lend(r), z_ptr);
+        }
+        auto d_coeff = zero<real_type>();
+        auto z_coeff = one<real_type>() / theta;
+        if (iter > 0 && delta > zero<real_type>()) {
+            const auto new_rho = one<real_type>() / (2 * sigma - rho);
+            d_coeff = new_rho * rho;
+            z_coeff = 2 * new_rho / delta;
+            rho = new_rho;
+        }
+        // d = d_coeff * d + z_coeff * z, x = x + d
+        exec->run(chebyshev::make_step(dense_x, lend(d), z_ptr,
+                                       static_cast<ValueType>(d_coeff),
+                                       static_cast<ValueType>(z_coeff),
+                                       &stop_status));
+        // r = r - A * d
+        system_matrix_->apply(lend(neg_one_op), lend(d), lend(one_op),
+                              lend(r));
+    }
+}
+
+
+template <typename ValueType>
+void Chebyshev<ValueType>::apply_impl(const LinOp *alpha, const LinOp *b,
+                                      const LinOp *beta, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_dense_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_CHEBYSHEV(_type) class Chebyshev<_type>
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CHEBYSHEV);
+
+
+}  // namespace solver
+}  // namespace gko
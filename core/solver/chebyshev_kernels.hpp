@@ -0,0 +1,128 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_CORE_SOLVER_CHEBYSHEV_KERNELS_HPP_
+#define GKO_CORE_SOLVER_CHEBYSHEV_KERNELS_HPP_
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace chebyshev {
+
+
+#define GKO_DECLARE_CHEBYSHEV_INITIALIZE_KERNEL(_type)                      \
+    void initialize(std::shared_ptr<const DefaultExecutor> exec,            \
+                    const matrix::Dense<_type> *b, matrix::Dense<_type> *r, \
+                    matrix::Dense<_type> *d,                                \
+                    Array<stopping_status> *stop_status)
+
+
+#define GKO_DECLARE_CHEBYSHEV_STEP_KERNEL(_type)                           \
+    void step(std::shared_ptr<const DefaultExecutor> exec,                 \
+              matrix::Dense<_type> *x, matrix::Dense<_type> *d,            \
+              const matrix::Dense<_type> *z, _type d_coeff, _type z_coeff, \
+              const Array<stopping_status> *stop_status)
+
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                    \
+    template <typename ValueType>                       \
+    GKO_DECLARE_CHEBYSHEV_INITIALIZE_KERNEL(ValueType); \
+    template <typename ValueType>                       \
+    GKO_DECLARE_CHEBYSHEV_STEP_KERNEL(ValueType)
+
+
+}  // namespace chebyshev
+
+
+namespace omp {
+namespace chebyshev {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace chebyshev
+}  // namespace omp
+
+
+namespace cuda {
+namespace chebyshev {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace chebyshev
+}  // namespace cuda
+
+
+namespace reference {
+namespace chebyshev {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace chebyshev
+}  // namespace reference
+
+
+namespace hip {
+namespace chebyshev {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace chebyshev
+}  // namespace hip
+
+
+namespace dpcpp {
+namespace chebyshev {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace chebyshev
+}  // namespace dpcpp
+
+
+#undef GKO_DECLARE_ALL_AS_TEMPLATES
+
+
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_CORE_SOLVER_CHEBYSHEV_KERNELS_HPP_
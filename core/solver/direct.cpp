@@ -0,0 +1,541 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/direct.hpp>
+
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/polymorphic_object.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/temporary_clone.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/sparsity_csr.hpp>
+
+
+#include "core/solver/direct_kernels.hpp"
+
+
+namespace gko {
+namespace solver {
+namespace direct {
+
+
+GKO_REGISTER_OPERATION(factorize, direct::factorize);
+GKO_REGISTER_OPERATION(solve, direct::solve);
+
+
+}  // namespace direct
+
+
+namespace {
+
+
+/**
+ * Computes the strictly lower triangular part of the symmetrized sparsity
+ * pattern of a matrix after reordering its rows and columns, stored as CSR
+ * arrays without values. Duplicate entries are not removed.
+ */
+template <typename IndexType>
+void reordered_lower_pattern(size_type num_rows, const IndexType *row_ptrs,
+                             const IndexType *col_idxs,
+                             const std::vector<IndexType> &inv_perm,
+                             std::vector<IndexType> &lower_ptrs,
+                             std::vector<IndexType> &lower_idxs)
+{
+    lower_ptrs.assign(num_rows + 1, 0);
+    for (size_type row = 0; row < num_rows; ++row) {
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            const auto col = col_idxs[nz];
+            if (col != static_cast<IndexType>(row)) {
+                const auto new_row = std::max(inv_perm[row], inv_perm[col]);
+                lower_ptrs[new_row + 1]++;
+            }
+        }
+    }
+    std::partial_sum(lower_ptrs.begin(), lower_ptrs.end(), lower_ptrs.begin());
+    lower_idxs.resize(lower_ptrs[num_rows]);
+    std::vector<IndexType> fill(lower_ptrs.begin(), lower_ptrs.end() - 1);
+    for (size_type row = 0; row < num_rows; ++row) {
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            const auto col = col_idxs[nz];
+            if (col != static_cast<IndexType>(row)) {
+                const auto new_row = std::max(inv_perm[row], inv_perm[col]);
+                const auto new_col = std::min(inv_perm[row], inv_perm[col]);
+                lower_idxs[fill[new_row]++] = new_col;
+            }
+        }
+    }
+}
+
+
+/**
+ * Computes the elimination tree of a symmetric sparsity pattern given by its
+ * strictly lower triangular part with Liu's algorithm. Roots have the parent
+ * -1.
+ */
+template <typename IndexType>
+std::vector<IndexType> elimination_tree(
+    const std::vector<IndexType> &lower_ptrs,
+    const std::vector<IndexType> &lower_idxs)
+{
+    const auto num_rows = lower_ptrs.size() - 1;
+    std::vector<IndexType> parent(num_rows, -1);
+    std::vector<IndexType> ancestor(num_rows, -1);
+    for (size_type row = 0; row < num_rows; ++row) {
+        const auto i = static_cast<IndexType>(row);
+        for (auto nz = lower_ptrs[row]; nz < lower_ptrs[row + 1]; ++nz) {
+            // follow the path to the root of the current subtree, compressing
+            // it along the way
+            auto node = lower_idxs[nz];
+            while (ancestor[node] != -1 && ancestor[node] != i) {
+                const auto next = ancestor[node];
+                ancestor[node] = i;
+                node = next;
+            }
+            if (ancestor[node] == -1) {
+                ancestor[node] = i;
+                parent[node] = i;
+            }
+        }
+    }
+    return parent;
+}
+
+
+/**
+ * Computes a postorder of a forest, visiting the children of each node in
+ * ascending order.
+ */
+template <typename IndexType>
+std::vector<IndexType> postorder(const std::vector<IndexType> &parent)
+{
+    const auto num_nodes = static_cast<IndexType>(parent.size());
+    std::vector<IndexType> first_child(num_nodes, -1);
+    std::vector<IndexType> next_sibling(num_nodes, -1);
+    for (auto node = num_nodes - 1; node >= 0; --node) {
+        if (parent[node] != -1) {
+            next_sibling[node] = first_child[parent[node]];
+            first_child[parent[node]] = node;
+        }
+    }
+    std::vector<IndexType> order;
+    order.reserve(num_nodes);
+    std::vector<IndexType> stack;
+    for (IndexType root = 0; root < num_nodes; ++root) {
+        if (parent[root] != -1) {
+            continue;
+        }
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const auto node = stack.back();
+            const auto child = first_child[node];
+            if (child != -1) {
+                first_child[node] = next_sibling[child];
+                stack.push_back(child);
+            } else {
+                order.push_back(node);
+                stack.pop_back();
+            }
+        }
+    }
+    return order;
+}
+
+
+/**
+ * Visits the row subtrees of the elimination tree, i.e. calls
+ * `op(row, col)` for each entry below the diagonal of the Cholesky factor of
+ * the symmetric pattern, in ascending order of the rows.
+ */
+template <typename IndexType, typename Op>
+void visit_factor_entries(const std::vector<IndexType> &lower_ptrs,
+                          const std::vector<IndexType> &lower_idxs,
+                          const std::vector<IndexType> &parent, Op op)
+{
+    const auto num_rows = static_cast<IndexType>(parent.size());
+    std::vector<IndexType> mark(num_rows, -1);
+    for (IndexType row = 0; row < num_rows; ++row) {
+        mark[row] = row;
+        for (auto nz = lower_ptrs[row]; nz < lower_ptrs[row + 1]; ++nz) {
+            for (auto col = lower_idxs[nz]; mark[col] != row;
+                 col = parent[col]) {
+                op(row, col);
+                mark[col] = row;
+            }
+        }
+    }
+}
+
+
+}  // anonymous namespace
+
+
+template <typename ValueType, typename IndexType>
+size_type Direct<ValueType, IndexType>::get_num_supernodes() const
+{
+    return symbolic_->supernode_ptrs.get_num_elems() - 1;
+}
+
+
+template <typename ValueType, typename IndexType>
+void Direct<ValueType, IndexType>::analyze(const matrix_type *system_matrix)
+{
+    using sparsity_type = matrix::SparsityCsr<ValueType, IndexType>;
+    const auto host = this->get_executor()->get_master();
+    const auto num_rows = system_matrix->get_size()[0];
+    const auto n = static_cast<IndexType>(num_rows);
+    const auto row_ptrs = system_matrix->get_const_row_ptrs();
+    const auto col_idxs = system_matrix->get_const_col_idxs();
+    const auto is_cholesky =
+        parameters_.factorization == factorization_type::cholesky;
+    auto symbolic = std::make_shared<SupernodalSymbolic<IndexType>>(host);
+    symbolic->type = parameters_.factorization;
+    symbolic->num_nonzeros = system_matrix->get_num_stored_elements();
+
+    std::vector<IndexType> perm(num_rows);
+    std::vector<IndexType> inv_perm(num_rows);
+    std::iota(perm.begin(), perm.end(), IndexType{});
+    std::vector<IndexType> lower_ptrs;
+    std::vector<IndexType> lower_idxs;
+    if (!parameters_.skip_reordering && num_rows > 0) {
+        // reorder the symmetrized pattern without duplicates
+        reordered_lower_pattern(num_rows, row_ptrs, col_idxs, perm, lower_ptrs,
+                                lower_idxs);
+        Array<IndexType> pattern_ptrs{host, num_rows + 1};
+        auto pattern_ptr_data = pattern_ptrs.get_data();
+        std::fill_n(pattern_ptr_data, num_rows + 1, 0);
+        std::vector<std::vector<IndexType>> rows(num_rows);
+        for (IndexType row = 0; row < n; ++row) {
+            for (auto nz = lower_ptrs[row]; nz < lower_ptrs[row + 1]; ++nz) {
+                rows[row].push_back(lower_idxs[nz]);
+                rows[lower_idxs[nz]].push_back(row);
+            }
+        }
+        for (IndexType row = 0; row < n; ++row) {
+            auto &cols = rows[row];
+            std::sort(cols.begin(), cols.end());
+            cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+            pattern_ptr_data[row + 1] = pattern_ptr_data[row] + cols.size();
+        }
+        Array<IndexType> pattern_idxs{host,
+                                      static_cast<size_type>(
+                                          pattern_ptr_data[num_rows])};
+        for (IndexType row = 0; row < n; ++row) {
+            std::copy(rows[row].begin(), rows[row].end(),
+                      pattern_idxs.get_data() + pattern_ptr_data[row]);
+        }
+        auto pattern = share(sparsity_type::create(
+            host, system_matrix->get_size(), std::move(pattern_idxs),
+            std::move(pattern_ptrs)));
+        auto factory = parameters_.reordering
+                           ? parameters_.reordering
+                           : share(reordering_type::build().on(host));
+        auto reordering = factory->generate(pattern);
+        auto host_perm = make_temporary_clone(
+            host, reordering->get_permutation().get());
+        std::copy_n(host_perm->get_const_permutation(), num_rows,
+                    perm.begin());
+    }
+    for (IndexType i = 0; i < n; ++i) {
+        inv_perm[perm[i]] = i;
+    }
+    // a postorder of the elimination tree does not change the fill-in, but
+    // makes the columns of each supernode consecutive
+    reordered_lower_pattern(num_rows, row_ptrs, col_idxs, inv_perm, lower_ptrs,
+                            lower_idxs);
+    const auto order =
+        postorder(elimination_tree(lower_ptrs, lower_idxs));
+    {
+        auto old_perm = perm;
+        for (IndexType i = 0; i < n; ++i) {
+            perm[i] = old_perm[order[i]];
+            inv_perm[perm[i]] = i;
+        }
+    }
+    reordered_lower_pattern(num_rows, row_ptrs, col_idxs, inv_perm, lower_ptrs,
+                            lower_idxs);
+    const auto parent = elimination_tree(lower_ptrs, lower_idxs);
+
+    // number of entries below the diagonal in each column of the factor
+    std::vector<IndexType> col_counts(num_rows, 0);
+    visit_factor_entries(lower_ptrs, lower_idxs, parent,
+                         [&](IndexType, IndexType col) { col_counts[col]++; });
+
+    // group columns with nested patterns into fundamental supernodes
+    const auto max_size = static_cast<IndexType>(
+        std::max<size_type>(parameters_.max_supernode_size, 1));
+    std::vector<IndexType> supernode_ptrs{0};
+    std::vector<IndexType> supernode_of(num_rows);
+    for (IndexType col = 0; col < n; ++col) {
+        const auto first = supernode_ptrs.back();
+        const auto extends = col > 0 && parent[col - 1] == col &&
+                             col_counts[col - 1] == col_counts[col] + 1 &&
+                             col - first < max_size;
+        if (col > 0 && !extends) {
+            supernode_ptrs.push_back(col);
+        }
+        supernode_of[col] = supernode_ptrs.size() - 1;
+    }
+    if (n > 0) {
+        supernode_ptrs.push_back(n);
+    }
+    const auto num_supernodes =
+        static_cast<IndexType>(supernode_ptrs.size() - 1);
+
+    // the rows below each supernode are the pattern of its last column
+    std::vector<IndexType> front_ptrs(num_supernodes + 1, 0);
+    for (IndexType sn = 0; sn < num_supernodes; ++sn) {
+        const auto last = supernode_ptrs[sn + 1] - 1;
+        front_ptrs[sn + 1] = front_ptrs[sn] + supernode_ptrs[sn + 1] -
+                             supernode_ptrs[sn] + col_counts[last];
+    }
+    std::vector<IndexType> front_idxs(front_ptrs.back());
+    std::vector<IndexType> front_fill(num_supernodes);
+    for (IndexType sn = 0; sn < num_supernodes; ++sn) {
+        std::iota(front_idxs.begin() + front_ptrs[sn],
+                  front_idxs.begin() + front_ptrs[sn] + supernode_ptrs[sn + 1] -
+                      supernode_ptrs[sn],
+                  supernode_ptrs[sn]);
+        front_fill[sn] =
+            front_ptrs[sn] + supernode_ptrs[sn + 1] - supernode_ptrs[sn];
+    }
+    visit_factor_entries(lower_ptrs, lower_idxs, parent,
+                         [&](IndexType row, IndexType col) {
+                             const auto sn = supernode_of[col];
+                             if (col == supernode_ptrs[sn + 1] - 1) {
+                                 front_idxs[front_fill[sn]++] = row;
+                             }
+                         });
+    const auto local_idx = [&](IndexType sn, IndexType idx) {
+        const auto first = supernode_ptrs[sn];
+        const auto size = supernode_ptrs[sn + 1] - first;
+        if (idx < first + size) {
+            return idx - first;
+        }
+        const auto begin = front_idxs.begin() + front_ptrs[sn] + size;
+        const auto end = front_idxs.begin() + front_ptrs[sn + 1];
+        return static_cast<IndexType>(size +
+                                      (std::lower_bound(begin, end, idx) -
+                                       begin));
+    };
+
+    // supernodal elimination tree, extend-add targets and levels
+    std::vector<IndexType> sn_parent(num_supernodes, -1);
+    std::vector<IndexType> parent_idxs(front_idxs.size(), -1);
+    std::vector<IndexType> child_ptrs(num_supernodes + 1, 0);
+    std::vector<IndexType> height(num_supernodes, 0);
+    for (IndexType sn = 0; sn < num_supernodes; ++sn) {
+        const auto below = front_ptrs[sn] + supernode_ptrs[sn + 1] -
+                           supernode_ptrs[sn];
+        if (below == front_ptrs[sn + 1]) {
+            continue;
+        }
+        const auto p = supernode_of[front_idxs[below]];
+        sn_parent[sn] = p;
+        child_ptrs[p + 1]++;
+        height[p] = std::max(height[p], height[sn] + 1);
+        for (auto i = below; i < front_ptrs[sn + 1]; ++i) {
+            parent_idxs[i] = local_idx(p, front_idxs[i]);
+        }
+    }
+    std::partial_sum(child_ptrs.begin(), child_ptrs.end(), child_ptrs.begin());
+    std::vector<IndexType> child_idxs(child_ptrs.back());
+    {
+        std::vector<IndexType> fill(child_ptrs.begin(), child_ptrs.end() - 1);
+        for (IndexType sn = 0; sn < num_supernodes; ++sn) {
+            if (sn_parent[sn] != -1) {
+                child_idxs[fill[sn_parent[sn]]++] = sn;
+            }
+        }
+    }
+    const auto num_levels =
+        num_supernodes > 0
+            ? *std::max_element(height.begin(), height.end()) + 1
+            : 0;
+    std::vector<IndexType> level_ptrs(num_levels + 1, 0);
+    for (auto h : height) {
+        level_ptrs[h + 1]++;
+    }
+    std::partial_sum(level_ptrs.begin(), level_ptrs.end(), level_ptrs.begin());
+    std::vector<IndexType> level_supernodes(num_supernodes);
+    {
+        std::vector<IndexType> fill(level_ptrs.begin(), level_ptrs.end() - 1);
+        for (IndexType sn = 0; sn < num_supernodes; ++sn) {
+            level_supernodes[fill[height[sn]]++] = sn;
+        }
+    }
+
+    // positions of the system matrix entries in the frontal matrices
+    const auto owner = [&](IndexType nz, IndexType row) {
+        const auto new_row = inv_perm[row];
+        const auto new_col = inv_perm[col_idxs[nz]];
+        if (is_cholesky && new_row < new_col) {
+            return IndexType{-1};
+        }
+        return supernode_of[std::min(new_row, new_col)];
+    };
+    std::vector<IndexType> assembly_ptrs(num_supernodes + 1, 0);
+    for (IndexType row = 0; row < n; ++row) {
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            const auto sn = owner(nz, row);
+            if (sn != -1) {
+                assembly_ptrs[sn + 1]++;
+            }
+        }
+    }
+    std::partial_sum(assembly_ptrs.begin(), assembly_ptrs.end(),
+                     assembly_ptrs.begin());
+    std::vector<IndexType> assembly_nonzeros(assembly_ptrs.back());
+    std::vector<size_type> assembly_positions(assembly_ptrs.back());
+    {
+        std::vector<IndexType> fill(assembly_ptrs.begin(),
+                                    assembly_ptrs.end() - 1);
+        for (IndexType row = 0; row < n; ++row) {
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+                const auto sn = owner(nz, row);
+                if (sn == -1) {
+                    continue;
+                }
+                const auto front_size = static_cast<size_type>(
+                    front_ptrs[sn + 1] - front_ptrs[sn]);
+                const auto local_row = local_idx(sn, inv_perm[row]);
+                const auto local_col = local_idx(sn, inv_perm[col_idxs[nz]]);
+                assembly_nonzeros[fill[sn]] = nz;
+                assembly_positions[fill[sn]++] =
+                    local_row + local_col * front_size;
+            }
+        }
+    }
+
+    std::vector<size_type> factor_ptrs(num_supernodes + 1, 0);
+    for (IndexType sn = 0; sn < num_supernodes; ++sn) {
+        const auto front_size =
+            static_cast<size_type>(front_ptrs[sn + 1] - front_ptrs[sn]);
+        const auto size =
+            static_cast<size_type>(supernode_ptrs[sn + 1] - supernode_ptrs[sn]);
+        factor_ptrs[sn + 1] = factor_ptrs[sn] + front_size * size +
+                              (is_cholesky ? 0 : size * (front_size - size));
+    }
+
+    const auto to_array = [&](const auto &vec) {
+        using value_type = typename std::decay_t<decltype(vec)>::value_type;
+        return Array<value_type>{host, vec.begin(), vec.end()};
+    };
+    symbolic->permutation = to_array(perm);
+    symbolic->supernode_ptrs = to_array(supernode_ptrs);
+    symbolic->front_ptrs = to_array(front_ptrs);
+    symbolic->front_idxs = to_array(front_idxs);
+    symbolic->parent_idxs = to_array(parent_idxs);
+    symbolic->child_ptrs = to_array(child_ptrs);
+    symbolic->child_idxs = to_array(child_idxs);
+    symbolic->level_ptrs = to_array(level_ptrs);
+    symbolic->level_supernodes = to_array(level_supernodes);
+    symbolic->assembly_ptrs = to_array(assembly_ptrs);
+    symbolic->assembly_nonzeros = to_array(assembly_nonzeros);
+    symbolic->assembly_positions = to_array(assembly_positions);
+    symbolic->factor_ptrs = to_array(factor_ptrs);
+    symbolic_ = std::move(symbolic);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Direct<ValueType, IndexType>::factorize(const matrix_type *system_matrix)
+{
+    this->get_executor()->get_master()->run(direct::make_factorize(
+        system_matrix, *symbolic_, factors_, pivots_, num_perturbed_));
+}
+
+
+template <typename ValueType, typename IndexType>
+void Direct<ValueType, IndexType>::refactorize(
+    std::shared_ptr<const LinOp> system_matrix)
+{
+    GKO_ASSERT_EQUAL_DIMENSIONS(system_matrix, this);
+    const auto host = this->get_executor()->get_master();
+    auto host_matrix = copy_and_convert_to<matrix_type>(host, system_matrix);
+    // the symbolic analysis is only valid for the same sparsity pattern
+    GKO_ASSERT_EQ(host_matrix->get_num_stored_elements(),
+                  symbolic_->num_nonzeros);
+    this->factorize(host_matrix.get());
+}
+
+
+template <typename ValueType, typename IndexType>
+void Direct<ValueType, IndexType>::apply_impl(const LinOp *b, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            using Vector = matrix::Dense<ValueType>;
+            const auto host = this->get_executor()->get_master();
+            auto host_b = make_temporary_clone(host, dense_b);
+            auto host_x = make_temporary_clone(host, dense_x);
+            auto work = Vector::create(host, dense_b->get_size());
+            host->run(direct::make_solve(*symbolic_, factors_, pivots_,
+                                         host_b.get(), work.get(),
+                                         host_x.get()));
+        },
+        b, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void Direct<ValueType, IndexType>::apply_impl(const LinOp *alpha,
+                                              const LinOp *b,
+                                              const LinOp *beta,
+                                              LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_DIRECT(_vtype, _itype) class Direct<_vtype, _itype>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_DIRECT);
+
+
+}  // namespace solver
+}  // namespace gko
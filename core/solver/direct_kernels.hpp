@@ -0,0 +1,229 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_CORE_SOLVER_DIRECT_KERNELS_HPP_
+#define GKO_CORE_SOLVER_DIRECT_KERNELS_HPP_
+
+
+#include <ginkgo/core/solver/direct.hpp>
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+namespace gko {
+namespace solver {
+
+
+/**
+ * @internal
+ *
+ * The result of the symbolic analysis of the Direct solver, which only
+ * depends on the sparsity pattern of the system matrix.
+ *
+ * The columns of the reordered matrix are grouped into supernodes of
+ * consecutive columns. The frontal matrix of supernode `s` is a dense matrix
+ * whose rows and columns correspond to the (reordered) indices
+ * `front_idxs[front_ptrs[s]]` to `front_idxs[front_ptrs[s + 1] - 1]`, starting
+ * with the columns of the supernode themselves, followed by the rows below the
+ * supernode in the factor L in ascending order. All dense matrices are stored
+ * in column-major order.
+ *
+ * @tparam IndexType  precision of matrix indices
+ */
+template <typename IndexType>
+struct SupernodalSymbolic {
+    explicit SupernodalSymbolic(std::shared_ptr<const Executor> exec)
+        : permutation{exec},
+          supernode_ptrs{exec},
+          front_ptrs{exec},
+          front_idxs{exec},
+          parent_idxs{exec},
+          child_ptrs{exec},
+          child_idxs{exec},
+          level_ptrs{exec},
+          level_supernodes{exec},
+          assembly_ptrs{exec},
+          assembly_nonzeros{exec},
+          assembly_positions{exec},
+          factor_ptrs{exec}
+    {}
+
+    /** The factorization the analysis was computed for. */
+    factorization_type type;
+
+    /** Number of stored elements of the analyzed system matrix. */
+    size_type num_nonzeros;
+
+    /** Original index of each reordered row and column. */
+    Array<IndexType> permutation;
+
+    /** First column of each supernode, the last entry is the matrix size. */
+    Array<IndexType> supernode_ptrs;
+
+    /** Offsets of the index lists of the frontal matrices into front_idxs. */
+    Array<IndexType> front_ptrs;
+
+    /** Indices of the rows and columns of the frontal matrices. */
+    Array<IndexType> front_idxs;
+
+    /**
+     * For each entry of front_idxs below the columns of its supernode, the
+     * position of the same index in the frontal matrix of the parent
+     * supernode. These are the targets of the extend-add operation of the
+     * update matrix of the supernode.
+     */
+    Array<IndexType> parent_idxs;
+
+    /** Offsets of the children of each supernode into child_idxs. */
+    Array<IndexType> child_ptrs;
+
+    /** The children of each supernode in the supernodal elimination tree. */
+    Array<IndexType> child_idxs;
+
+    /** Offsets of the levels into level_supernodes. */
+    Array<IndexType> level_ptrs;
+
+    /**
+     * The supernodes grouped by their height in the elimination tree, i.e.
+     * all supernodes of a level only depend on supernodes of previous levels.
+     */
+    Array<IndexType> level_supernodes;
+
+    /** Offsets of the assembly lists of each supernode. */
+    Array<IndexType> assembly_ptrs;
+
+    /** Indices of the system matrix entries assembled into each front. */
+    Array<IndexType> assembly_nonzeros;
+
+    /** Positions of these entries in the (column-major) frontal matrix. */
+    Array<size_type> assembly_positions;
+
+    /**
+     * Offsets of the factor storage of each supernode. The storage of
+     * supernode `s` with `n` columns and a frontal matrix of size `m` holds
+     * the first `n` columns of the factorized frontal matrix (`m x n`), and
+     * for LU the block of U right of the diagonal block (`n x (m - n)`).
+     */
+    Array<size_type> factor_ptrs;
+};
+
+
+}  // namespace solver
+
+
+namespace kernels {
+
+
+#define GKO_DECLARE_DIRECT_FACTORIZE_KERNEL(_vtype, _itype)            \
+    void factorize(std::shared_ptr<const DefaultExecutor> exec,        \
+                   const matrix::Csr<_vtype, _itype> *system_matrix,   \
+                   const solver::SupernodalSymbolic<_itype> &symbolic, \
+                   Array<_vtype> &factors, Array<_itype> &pivots,      \
+                   size_type &num_perturbed)
+
+
+#define GKO_DECLARE_DIRECT_SOLVE_KERNEL(_vtype, _itype)                     \
+    void solve(std::shared_ptr<const DefaultExecutor> exec,                 \
+               const solver::SupernodalSymbolic<_itype> &symbolic,          \
+               const Array<_vtype> &factors, const Array<_itype> &pivots,   \
+               const matrix::Dense<_vtype> *b, matrix::Dense<_vtype> *work, \
+               matrix::Dense<_vtype> *x)
+
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                           \
+    template <typename ValueType, typename IndexType>          \
+    GKO_DECLARE_DIRECT_FACTORIZE_KERNEL(ValueType, IndexType); \
+    template <typename ValueType, typename IndexType>          \
+    GKO_DECLARE_DIRECT_SOLVE_KERNEL(ValueType, IndexType)
+
+
+namespace omp {
+namespace direct {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace direct
+}  // namespace omp
+
+
+namespace cuda {
+namespace direct {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace direct
+}  // namespace cuda
+
+
+namespace reference {
+namespace direct {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace direct
+}  // namespace reference
+
+
+namespace hip {
+namespace direct {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace direct
+}  // namespace hip
+
+
+namespace dpcpp {
+namespace direct {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace direct
+}  // namespace dpcpp
+
+
+#undef GKO_DECLARE_ALL_AS_TEMPLATES
+
+
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_CORE_SOLVER_DIRECT_KERNELS_HPP_
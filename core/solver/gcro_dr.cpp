@@ -0,0 +1,971 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/gcro_dr.hpp>
+
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+
+
+#include "core/solver/host_eigensolver.hpp"
+#include "core/solver/ir_kernels.hpp"
+
+
+namespace gko {
+namespace solver {
+namespace gcro_dr {
+
+
+GKO_REGISTER_OPERATION(initialize, ir::initialize);
+
+
+}  // namespace gcro_dr
+
+
+namespace {
+
+
+// Returns row k of the row-stored vectors as a column vector (n x 1).
+template <typename ValueType>
+std::unique_ptr<matrix::Dense<ValueType>> row_vector(
+    const matrix::Dense<ValueType> *rows, size_type k)
+{
+    auto exec = rows->get_executor();
+    const auto num_cols = rows->get_size()[1];
+    // the view is only written if rows is not const
+    return matrix::Dense<ValueType>::create(
+        exec, dim<2>{num_cols, 1},
+        Array<ValueType>::view(
+            exec, num_cols,
+            const_cast<ValueType *>(rows->get_const_values()) +
+                k * rows->get_stride()),
+        1);
+}
+
+
+// Returns the first num_rows rows of the row-stored vectors.
+template <typename ValueType>
+std::unique_ptr<matrix::Dense<ValueType>> first_rows(
+    const matrix::Dense<ValueType> *rows, size_type num_rows)
+{
+    return const_cast<matrix::Dense<ValueType> *>(rows)->create_submatrix(
+        span{0, num_rows}, span{0, rows->get_size()[1]});
+}
+
+
+// Computes result = alpha * coeffs * rows + beta * result for the row-stored
+// vectors rows and host coefficients coeffs.
+template <typename ValueType>
+void combine_rows(const matrix::Dense<ValueType> *coeffs,
+                  const matrix::Dense<ValueType> *rows, ValueType alpha,
+                  ValueType beta, matrix::Dense<ValueType> *result)
+{
+    using Vector = matrix::Dense<ValueType>;
+    auto exec = result->get_executor();
+    if (beta == zero<ValueType>()) {
+        // the result may be uninitialized
+        result->fill(zero<ValueType>());
+    }
+    if (coeffs->get_size()[1] == 0) {
+        result->scale(lend(initialize<Vector>({beta}, exec)));
+        return;
+    }
+    gko::clone(exec, coeffs)
+        ->apply(lend(initialize<Vector>({alpha}, exec)), rows,
+                lend(initialize<Vector>({beta}, exec)), result);
+}
+
+
+// Computes the inner products a_i^H b_j of the row-stored vectors on the
+// host.
+template <typename ValueType>
+std::unique_ptr<matrix::Dense<ValueType>> compute_inner_products(
+    const matrix::Dense<ValueType> *a, const matrix::Dense<ValueType> *b)
+{
+    using Vector = matrix::Dense<ValueType>;
+    auto exec = a->get_executor();
+    auto host_exec = exec->get_master();
+    const auto num_a = a->get_size()[0];
+    const auto num_b = b->get_size()[0];
+    auto result = Vector::create(host_exec, dim<2>{num_a, num_b});
+    if (num_a == 0 || num_b == 0) {
+        return result;
+    }
+    // b a^H has the entries conj(a_i)^T b_j at (j, i)
+    auto products = Vector::create(exec, dim<2>{num_b, num_a});
+    b->apply(lend(a->conj_transpose()), lend(products));
+    auto host_products = gko::clone(host_exec, products);
+    for (size_type i = 0; i < num_a; ++i) {
+        for (size_type j = 0; j < num_b; ++j) {
+            result->at(i, j) = host_products->at(j, i);
+        }
+    }
+    return result;
+}
+
+
+// Solves a x = b for the row-major size x size matrix a and num_rhs
+// right-hand sides b (row-major size x num_rhs) by Gaussian elimination with
+// partial pivoting. Vanishing pivots are replaced by a small value.
+template <typename T>
+std::vector<std::complex<T>> solve_dense(std::vector<std::complex<T>> a,
+                                         std::vector<std::complex<T>> b,
+                                         size_type size, size_type num_rhs)
+{
+    using C = std::complex<T>;
+    T max_entry{};
+    for (auto value : a) {
+        max_entry = std::max(max_entry, std::abs(value));
+    }
+    const auto min_pivot = std::numeric_limits<T>::epsilon() *
+                           (max_entry > T{} ? max_entry : T{1});
+    for (size_type k = 0; k < size; ++k) {
+        auto pivot = k;
+        for (auto i = k + 1; i < size; ++i) {
+            if (std::abs(a[i * size + k]) > std::abs(a[pivot * size + k])) {
+                pivot = i;
+            }
+        }
+        for (size_type j = 0; j < size; ++j) {
+            std::swap(a[k * size + j], a[pivot * size + j]);
+        }
+        for (size_type j = 0; j < num_rhs; ++j) {
+            std::swap(b[k * num_rhs + j], b[pivot * num_rhs + j]);
+        }
+        if (std::abs(a[k * size + k]) < min_pivot) {
+            a[k * size + k] = C(min_pivot);
+        }
+        for (auto i = k + 1; i < size; ++i) {
+            const auto factor = a[i * size + k] / a[k * size + k];
+            for (auto j = k; j < size; ++j) {
+                a[i * size + j] -= factor * a[k * size + j];
+            }
+            for (size_type j = 0; j < num_rhs; ++j) {
+                b[i * num_rhs + j] -= factor * b[k * num_rhs + j];
+            }
+        }
+    }
+    for (auto k = size; k-- > 0;) {
+        for (size_type j = 0; j < num_rhs; ++j) {
+            auto value = b[k * num_rhs + j];
+            for (auto l = k + 1; l < size; ++l) {
+                value -= a[k * size + l] * b[l * num_rhs + j];
+            }
+            b[k * num_rhs + j] = value / a[k * size + k];
+        }
+    }
+    return b;
+}
+
+
+// Computes an eigenvector of the row-major size x size matrix a for the
+// eigenvalue approximation theta by inverse iteration.
+template <typename T>
+std::vector<std::complex<T>> compute_eigenvector(
+    const std::vector<std::complex<T>> &a, size_type size,
+    std::complex<T> theta)
+{
+    using C = std::complex<T>;
+    T norm{};
+    for (auto value : a) {
+        norm = std::max(norm, std::abs(value));
+    }
+    // a slightly perturbed shift keeps the system nonsingular
+    const auto shift =
+        theta + C(std::sqrt(std::numeric_limits<T>::epsilon()) *
+                  (std::abs(theta) + norm));
+    auto shifted = a;
+    for (size_type i = 0; i < size; ++i) {
+        shifted[i * size + i] -= shift;
+    }
+    std::vector<C> vector(size);
+    for (size_type i = 0; i < size; ++i) {
+        vector[i] = C(T{1} / static_cast<T>(i + 1));
+    }
+    for (int iter = 0; iter < 3; ++iter) {
+        vector = solve_dense(shifted, vector, size, 1);
+        T vector_norm{};
+        for (auto value : vector) {
+            vector_norm += std::norm(value);
+        }
+        vector_norm = std::sqrt(vector_norm);
+        for (auto &value : vector) {
+            value /= vector_norm;
+        }
+    }
+    return vector;
+}
+
+
+template <typename ValueType>
+void assign_vector(ValueType *dst, const std::complex<remove_complex<ValueType>>
+                                       &value, bool imag_part)
+{
+    *dst = imag_part ? value.imag() : value.real();
+}
+
+template <typename T>
+void assign_vector(std::complex<T> *dst, const std::complex<T> &value, bool)
+{
+    *dst = value;
+}
+
+
+// Computes the coefficients P of the harmonic Ritz vectors W P of A M with
+// respect to the search space W of a cycle, for the harmonic Ritz values of
+// smallest magnitude. They are the eigenvectors of the generalized
+// eigenvalue problem G^H G p = theta G^H (W_hat^H W) p, where A M W = W_hat G.
+// For real value types, the real and imaginary parts of complex eigenvectors
+// are used.
+template <typename ValueType>
+std::unique_ptr<matrix::Dense<ValueType>> compute_harmonic_ritz_coefficients(
+    const matrix::Dense<ValueType> *g, const matrix::Dense<ValueType> *w_hat_w,
+    size_type max_vectors)
+{
+    using real_type = remove_complex<ValueType>;
+    using C = std::complex<real_type>;
+    const auto rows = g->get_size()[0];
+    const auto size = g->get_size()[1];
+    std::vector<C> lhs(size * size);
+    std::vector<C> rhs(size * size);
+    for (size_type i = 0; i < size; ++i) {
+        for (size_type j = 0; j < size; ++j) {
+            C lhs_value{};
+            C rhs_value{};
+            for (size_type l = 0; l < rows; ++l) {
+                const auto g_li = std::conj(static_cast<C>(g->at(l, i)));
+                lhs_value += g_li * static_cast<C>(g->at(l, j));
+                rhs_value += g_li * static_cast<C>(w_hat_w->at(l, j));
+            }
+            lhs[i * size + j] = lhs_value;
+            rhs[i * size + j] = rhs_value;
+        }
+    }
+    const auto mat = solve_dense(rhs, lhs, size, size);
+    const auto eigenvalues = detail::compute_eigenvalues(mat, size);
+    std::vector<size_type> order(size);
+    std::iota(order.begin(), order.end(), size_type{});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_type a, size_type b) {
+                         return std::abs(eigenvalues[a]) <
+                                std::abs(eigenvalues[b]);
+                     });
+    const auto tolerance = std::sqrt(std::numeric_limits<real_type>::epsilon());
+    std::vector<std::pair<size_type, bool>> selected;
+    for (auto i : order) {
+        if (selected.size() >= max_vectors) {
+            break;
+        }
+        const auto theta = eigenvalues[i];
+        const bool real_value =
+            std::abs(theta.imag()) <= tolerance * std::abs(theta);
+        if (is_complex<ValueType>() || real_value) {
+            selected.emplace_back(i, false);
+        } else if (theta.imag() > real_type{}) {
+            // the conjugate eigenvalue spans the same real subspace
+            selected.emplace_back(i, false);
+            if (selected.size() < max_vectors) {
+                selected.emplace_back(i, true);
+            }
+        }
+    }
+    auto result = matrix::Dense<ValueType>::create(
+        g->get_executor(), dim<2>{size, selected.size()});
+    std::vector<C> eigenvector;
+    for (size_type col = 0; col < selected.size(); ++col) {
+        if (!selected[col].second) {
+            const auto theta = eigenvalues[selected[col].first];
+            eigenvector = compute_eigenvector(mat, size, theta);
+        }
+        for (size_type row = 0; row < size; ++row) {
+            assign_vector(&result->at(row, col), eigenvector[row],
+                          selected[col].second);
+        }
+    }
+    return result;
+}
+
+
+// Orthonormalizes the columns of the host matrix a by modified Gram-Schmidt
+// with reorthogonalization, a(:, kept) = Q R. Columns that are numerically
+// linearly dependent on the previous ones are dropped. Returns the indices of
+// the kept columns, Q and R are resized accordingly.
+template <typename ValueType>
+std::vector<size_type> orthonormalize_columns(
+    const matrix::Dense<ValueType> *a,
+    std::unique_ptr<matrix::Dense<ValueType>> &q,
+    std::unique_ptr<matrix::Dense<ValueType>> &r)
+{
+    using Vector = matrix::Dense<ValueType>;
+    using real_type = remove_complex<ValueType>;
+    auto exec = a->get_executor();
+    const auto rows = a->get_size()[0];
+    const auto cols = a->get_size()[1];
+    auto full_q = Vector::create(exec, a->get_size());
+    auto full_r = Vector::create(exec, dim<2>{cols, cols});
+    full_r->fill(zero<ValueType>());
+    std::vector<size_type> kept;
+    const auto tolerance = std::sqrt(std::numeric_limits<real_type>::epsilon());
+    for (size_type j = 0; j < cols; ++j) {
+        const auto k = kept.size();
+        std::vector<ValueType> column(rows);
+        real_type original_norm{};
+        for (size_type i = 0; i < rows; ++i) {
+            column[i] = a->at(i, j);
+            original_norm += squared_norm(column[i]);
+        }
+        original_norm = std::sqrt(original_norm);
+        std::vector<ValueType> coeffs(k, zero<ValueType>());
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_type l = 0; l < k; ++l) {
+                auto dot = zero<ValueType>();
+                for (size_type i = 0; i < rows; ++i) {
+                    dot += conj(full_q->at(i, l)) * column[i];
+                }
+                for (size_type i = 0; i < rows; ++i) {
+                    column[i] -= dot * full_q->at(i, l);
+                }
+                coeffs[l] += dot;
+            }
+        }
+        real_type norm{};
+        for (auto value : column) {
+            norm += squared_norm(value);
+        }
+        norm = std::sqrt(norm);
+        if (!(norm > tolerance * original_norm)) {
+            continue;
+        }
+        for (size_type i = 0; i < rows; ++i) {
+            full_q->at(i, k) = column[i] / norm;
+        }
+        for (size_type l = 0; l < k; ++l) {
+            full_r->at(l, k) = coeffs[l];
+        }
+        full_r->at(k, k) = norm;
+        kept.push_back(j);
+    }
+    const auto k = kept.size();
+    q = Vector::create(exec, dim<2>{rows, k});
+    r = Vector::create(exec, dim<2>{k, k});
+    for (size_type i = 0; i < rows; ++i) {
+        for (size_type j = 0; j < k; ++j) {
+            q->at(i, j) = full_q->at(i, j);
+        }
+    }
+    for (size_type i = 0; i < k; ++i) {
+        for (size_type j = 0; j < k; ++j) {
+            r->at(i, j) = full_r->at(i, j);
+        }
+    }
+    return kept;
+}
+
+
+// Computes x = b r^-1 for the host matrices b and upper triangular r, i.e.
+// the coefficients of U = Y R^-1 if b holds those of Y.
+template <typename ValueType>
+std::unique_ptr<matrix::Dense<ValueType>> solve_upper_from_right(
+    const matrix::Dense<ValueType> *b, const matrix::Dense<ValueType> *r)
+{
+    auto x = matrix::Dense<ValueType>::create(b->get_executor(), b->get_size());
+    for (size_type row = 0; row < b->get_size()[0]; ++row) {
+        for (size_type col = 0; col < b->get_size()[1]; ++col) {
+            auto value = b->at(row, col);
+            for (size_type l = 0; l < col; ++l) {
+                value -= x->at(row, l) * r->at(l, col);
+            }
+            x->at(row, col) = value / r->at(col, col);
+        }
+    }
+    return x;
+}
+
+
+}  // namespace
+
+
+template <typename ValueType>
+std::unique_ptr<matrix::Dense<ValueType>> GcroDr<ValueType>::get_recycle_space()
+    const
+{
+    if (!recycle_space_) {
+        return nullptr;
+    }
+    return std::unique_ptr<matrix::Dense<ValueType>>{
+        static_cast<matrix::Dense<ValueType> *>(
+            recycle_space_->transpose().release())};
+}
+
+
+template <typename ValueType>
+void GcroDr<ValueType>::clear_recycle_space()
+{
+    recycle_space_ = nullptr;
+    recycle_image_ = nullptr;
+}
+
+
+template <typename ValueType>
+void GcroDr<ValueType>::regenerate(std::shared_ptr<const LinOp> system_matrix)
+{
+    GKO_ASSERT_EQUAL_DIMENSIONS(system_matrix, system_matrix_);
+    system_matrix_ = std::move(system_matrix);
+    if (!parameters_.generated_preconditioner && parameters_.preconditioner) {
+        // also updates the image of the recycle space
+        this->set_preconditioner(
+            parameters_.preconditioner->generate(system_matrix_));
+    } else {
+        this->update_recycle_image();
+    }
+}
+
+
+template <typename ValueType>
+void GcroDr<ValueType>::set_preconditioner(
+    std::shared_ptr<const LinOp> new_precond)
+{
+    Preconditionable::set_preconditioner(std::move(new_precond));
+    this->update_recycle_image();
+}
+
+
+template <typename ValueType>
+void GcroDr<ValueType>::update_recycle_image()
+{
+    using Vector = matrix::Dense<ValueType>;
+    using real_type = remove_complex<ValueType>;
+    if (!recycle_space_ || recycle_space_->get_size()[0] == 0) {
+        return;
+    }
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    const auto num_vectors = recycle_space_->get_size()[0];
+    const auto num_rows = recycle_space_->get_size()[1];
+    auto image = Vector::create(exec, dim<2>{num_vectors, num_rows});
+    auto preconditioned_vector = Vector::create(exec, dim<2>{num_rows, 1});
+    auto dot = Vector::create(exec, dim<2>{1, 1});
+    auto norm = matrix::Dense<real_type>::create(exec, dim<2>{1, 1});
+    auto factor = Vector::create(host_exec, dim<2>{num_vectors, num_vectors});
+    factor->fill(zero<ValueType>());
+    const auto tolerance = std::sqrt(std::numeric_limits<real_type>::epsilon());
+    std::vector<size_type> kept;
+    for (size_type j = 0; j < num_vectors; ++j) {
+        // images of dependent vectors are overwritten by the next one
+        const auto k = kept.size();
+        auto image_vector = row_vector(lend(image), k);
+        this->get_preconditioner()->apply(
+            lend(row_vector(lend(recycle_space_), j)),
+            lend(preconditioned_vector));
+        system_matrix_->apply(lend(preconditioned_vector), lend(image_vector));
+        image_vector->compute_norm2(lend(norm));
+        const auto original_norm =
+            exec->copy_val_to_host(norm->get_const_values());
+        // modified Gram-Schmidt with reorthogonalization
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_type l = 0; l < k; ++l) {
+                auto other = row_vector(lend(image), l);
+                other->compute_dot(lend(image_vector), lend(dot));
+                const auto value =
+                    exec->copy_val_to_host(dot->get_const_values());
+                image_vector->add_scaled(
+                    lend(initialize<Vector>({-value}, exec)), lend(other));
+                factor->at(l, k) += value;
+            }
+        }
+        image_vector->compute_norm2(lend(norm));
+        const auto new_norm = exec->copy_val_to_host(norm->get_const_values());
+        if (!(new_norm > tolerance * original_norm)) {
+            for (size_type l = 0; l < k; ++l) {
+                factor->at(l, k) = zero<ValueType>();
+            }
+            continue;
+        }
+        image_vector->scale(
+            lend(initialize<Vector>({one<ValueType>() / new_norm}, exec)));
+        factor->at(k, k) = new_norm;
+        kept.push_back(j);
+    }
+    const auto k = kept.size();
+    if (k == 0) {
+        this->clear_recycle_space();
+        return;
+    }
+    // A M U(:, kept) = C R, so the new U(:, kept) R^-1 has the image C.
+    // As rows: U_new = (R^-1)^T U(kept, :)
+    auto selection = Vector::create(host_exec, dim<2>{k, num_vectors});
+    selection->fill(zero<ValueType>());
+    for (size_type i = 0; i < k; ++i) {
+        selection->at(i, kept[i]) = one<ValueType>();
+    }
+    auto small_factor = Vector::create(host_exec, dim<2>{k, k});
+    for (size_type i = 0; i < k; ++i) {
+        for (size_type j = 0; j < k; ++j) {
+            small_factor->at(i, j) = factor->at(i, j);
+        }
+    }
+    auto identity = Vector::create(host_exec, dim<2>{k, k});
+    identity->fill(zero<ValueType>());
+    for (size_type i = 0; i < k; ++i) {
+        identity->at(i, i) = one<ValueType>();
+    }
+    auto inverse = solve_upper_from_right(lend(identity), lend(small_factor));
+    auto coeffs = Vector::create(host_exec, dim<2>{k, num_vectors});
+    as<Vector>(inverse->transpose())->apply(lend(selection), lend(coeffs));
+    auto new_space = Vector::create(exec, dim<2>{k, num_rows});
+    combine_rows(lend(coeffs), lend(recycle_space_), one<ValueType>(),
+                 zero<ValueType>(), lend(new_space));
+    recycle_space_ = std::move(new_space);
+    // the rows are copied, as the view would not keep image alive
+    recycle_image_ = first_rows(lend(image), k)->clone();
+}
+
+
+template <typename ValueType>
+void GcroDr<ValueType>::apply_impl(const LinOp *b, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->apply_dense_impl(dense_b, dense_x);
+        },
+        b, x);
+}
+
+
+template <typename ValueType>
+void GcroDr<ValueType>::apply_dense_impl(
+    const matrix::Dense<ValueType> *dense_b,
+    matrix::Dense<ValueType> *dense_x) const
+{
+    using Vector = matrix::Dense<ValueType>;
+    const auto num_rows = dense_b->get_size()[0];
+    const auto num_rhs = dense_b->get_size()[1];
+    if (num_rhs == 1) {
+        this->solve_single(dense_b, dense_x);
+        return;
+    }
+    for (size_type col = 0; col < num_rhs; ++col) {
+        // the view of b is only read
+        auto b_col = const_cast<Vector *>(dense_b)->create_submatrix(
+            span{0, num_rows}, span{col, col + 1});
+        auto x_col =
+            dense_x->create_submatrix(span{0, num_rows}, span{col, col + 1});
+        this->solve_single(lend(b_col), lend(x_col));
+    }
+}
+
+
+template <typename ValueType>
+void GcroDr<ValueType>::solve_single(const matrix::Dense<ValueType> *dense_b,
+                                     matrix::Dense<ValueType> *dense_x) const
+{
+    using Vector = matrix::Dense<ValueType>;
+    using NormVector = matrix::Dense<remove_complex<ValueType>>;
+    using real_type = remove_complex<ValueType>;
+    constexpr uint8 relative_stopping_id{1};
+
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    const auto num_rows = dense_b->get_size()[0];
+    const auto krylov_dim = parameters_.krylov_dim;
+    const auto recycle_dim = parameters_.recycle_dim;
+
+    auto one_op = initialize<Vector>({one<ValueType>()}, exec);
+    auto neg_one_op = initialize<Vector>({-one<ValueType>()}, exec);
+
+    // the Krylov basis vectors are stored as rows, like U and C
+    auto basis = Vector::create(exec, dim<2>{krylov_dim + 1, num_rows});
+    auto residual = Vector::create(exec, dim<2>{num_rows, 1});
+    auto preconditioned_vector = Vector::create(exec, dim<2>{num_rows, 1});
+    auto update = Vector::create(exec, dim<2>{num_rows, 1});
+    // update as a row vector, to be computed from row-stored vectors
+    auto update_trans = Vector::create(
+        exec, dim<2>{1, num_rows},
+        Array<ValueType>::view(exec, num_rows, update->get_values()),
+        num_rows);
+    auto preconditioned_update = Vector::create(exec, dim<2>{num_rows, 1});
+    auto dot = Vector::create(exec, dim<2>{1, 1});
+    auto residual_norm = NormVector::create(exec, dim<2>{1, 1});
+    auto host_residual_norm = NormVector::create(host_exec, dim<2>{1, 1});
+    // A M W = W_hat G with W = [U D, V_j] and W_hat = [C, V_{j+1}], D scales
+    // the vectors of U to unit norm. G is upper Hessenberg, the triangular
+    // factor is obtained by Givens rotations
+    auto hessenberg =
+        Vector::create(host_exec, dim<2>{krylov_dim + 1, krylov_dim});
+    auto triangular =
+        Vector::create(host_exec, dim<2>{krylov_dim + 1, krylov_dim});
+    std::vector<ValueType> givens_cos(krylov_dim);
+    std::vector<ValueType> givens_sin(krylov_dim);
+    std::vector<ValueType> residual_norm_collection(krylov_dim + 1);
+
+    bool one_changed{};
+    Array<stopping_status> stop_status(exec, 1);
+    exec->run(gcro_dr::make_initialize(&stop_status));
+
+    // residual = b - A * x
+    auto update_residual = [&] {
+        system_matrix_->apply(dense_x, lend(residual));
+        residual->scale(lend(neg_one_op));
+        residual->add_scaled(lend(one_op), dense_b);
+    };
+    update_residual();
+    auto stop_criterion = stop_criterion_factory_->generate(
+        system_matrix_,
+        std::shared_ptr<const LinOp>(dense_b, [](const LinOp *) {}), dense_x,
+        lend(residual));
+    auto check_convergence = [&](size_type iter) {
+        this->template log<log::Logger::iteration_complete>(
+            this, iter, lend(residual), dense_x, lend(residual_norm));
+        return stop_criterion->update()
+            .num_iterations(iter)
+            .residual(lend(residual))
+            .residual_norm(lend(residual_norm))
+            .solution(dense_x)
+            .check(relative_stopping_id, true, &stop_status, &one_changed);
+    };
+    // x = x + M update
+    auto update_solution = [&] {
+        this->get_preconditioner()->apply(lend(update),
+                                          lend(preconditioned_update));
+        dense_x->add_scaled(lend(one_op), lend(preconditioned_update));
+    };
+
+    size_type total_iter{};
+    bool first_cycle{true};
+    while (true) {
+        if (!first_cycle) {
+            update_residual();
+        }
+        first_cycle = false;
+        // copies of the recycle space of this cycle, as it may be replaced
+        auto space = recycle_space_;
+        auto image = recycle_image_;
+        const auto num_recycled = space ? space->get_size()[0] : 0;
+        // x = x + M U C^H r, r = r - C C^H r
+        if (num_recycled > 0) {
+            auto projection = compute_inner_products(
+                lend(image),
+                lend(Vector::create(
+                    exec, dim<2>{1, num_rows},
+                    Array<ValueType>::view(exec, num_rows,
+                                           residual->get_values()),
+                    num_rows)));
+            auto projection_trans = as<Vector>(projection->transpose());
+            combine_rows(lend(projection_trans), lend(space), one<ValueType>(),
+                         zero<ValueType>(), lend(update_trans));
+            update_solution();
+            auto residual_trans = Vector::create(
+                exec, dim<2>{1, num_rows},
+                Array<ValueType>::view(exec, num_rows, residual->get_values()),
+                num_rows);
+            combine_rows(lend(projection_trans), lend(image), -one<ValueType>(),
+                         one<ValueType>(), lend(residual_trans));
+        }
+        residual->compute_norm2(lend(residual_norm));
+        host_residual_norm->copy_from(lend(residual_norm));
+        const auto beta = host_residual_norm->at(0, 0);
+        if (check_convergence(total_iter) || !(beta > zero<real_type>())) {
+            break;
+        }
+        // D = diag(1 / ||u_i||)
+        std::vector<ValueType> scaling(num_recycled);
+        if (num_recycled > 0) {
+            auto norms = NormVector::create(exec, dim<2>{1, num_recycled});
+            as<Vector>(space->transpose())->compute_norm2(lend(norms));
+            auto host_norms = gko::clone(host_exec, norms);
+            for (size_type i = 0; i < num_recycled; ++i) {
+                scaling[i] = one<ValueType>() / host_norms->at(0, i);
+            }
+        }
+        hessenberg->fill(zero<ValueType>());
+        triangular->fill(zero<ValueType>());
+        std::fill(residual_norm_collection.begin(),
+                  residual_norm_collection.end(), zero<ValueType>());
+        for (size_type i = 0; i < num_recycled; ++i) {
+            hessenberg->at(i, i) = scaling[i];
+            triangular->at(i, i) = scaling[i];
+        }
+        residual_norm_collection[num_recycled] = beta;
+        auto first_vector = row_vector(lend(basis), 0);
+        first_vector->copy_from(lend(residual));
+        first_vector->scale(
+            lend(initialize<Vector>({one<ValueType>() / beta}, exec)));
+
+        // Arnoldi process with (I - C C^H) A M
+        size_type num_krylov{};
+        bool converged{};
+        while (num_recycled + num_krylov < krylov_dim) {
+            const auto j = num_krylov;
+            const auto col = num_recycled + j;
+            auto next = row_vector(lend(basis), j + 1);
+            this->get_preconditioner()->apply(
+                lend(row_vector(lend(basis), j)), lend(preconditioned_vector));
+            system_matrix_->apply(lend(preconditioned_vector), lend(next));
+            next->compute_norm2(lend(residual_norm));
+            const auto original_norm =
+                exec->copy_val_to_host(residual_norm->get_const_values());
+            // modified Gram-Schmidt against C and V, with reorthogonalization
+            for (int pass = 0; pass < 2; ++pass) {
+                for (size_type i = 0; i < num_recycled + j + 1; ++i) {
+                    auto other =
+                        i < num_recycled
+                            ? row_vector(lend(image), i)
+                            : row_vector(lend(basis), i - num_recycled);
+                    other->compute_dot(lend(next), lend(dot));
+                    const auto value =
+                        exec->copy_val_to_host(dot->get_const_values());
+                    next->add_scaled(lend(initialize<Vector>({-value}, exec)),
+                                     lend(other));
+                    hessenberg->at(i, col) += value;
+                }
+            }
+            next->compute_norm2(lend(residual_norm));
+            auto next_norm =
+                exec->copy_val_to_host(residual_norm->get_const_values());
+            const bool breakdown =
+                !(next_norm > std::numeric_limits<real_type>::epsilon() *
+                                  original_norm);
+            if (breakdown) {
+                // A M v_j lies in the search space
+                next_norm = zero<real_type>();
+                next->fill(zero<ValueType>());
+            } else {
+                next->scale(lend(initialize<Vector>(
+                    {one<ValueType>() / next_norm}, exec)));
+            }
+            hessenberg->at(col + 1, col) = next_norm;
+            // Givens rotations, the first num_recycled columns are diagonal
+            for (size_type i = 0; i <= col + 1; ++i) {
+                triangular->at(i, col) = hessenberg->at(i, col);
+            }
+            for (auto i = num_recycled; i < col; ++i) {
+                const auto temp = givens_cos[i] * triangular->at(i, col) +
+                                  givens_sin[i] * triangular->at(i + 1, col);
+                triangular->at(i + 1, col) =
+                    -conj(givens_sin[i]) * triangular->at(i, col) +
+                    conj(givens_cos[i]) * triangular->at(i + 1, col);
+                triangular->at(i, col) = temp;
+            }
+            const auto this_hess = triangular->at(col, col);
+            const auto next_hess = triangular->at(col + 1, col);
+            if (this_hess == zero<ValueType>()) {
+                givens_cos[col] = zero<ValueType>();
+                givens_sin[col] = one<ValueType>();
+            } else {
+                const auto hypotenuse = std::sqrt(squared_norm(this_hess) +
+                                                  squared_norm(next_hess));
+                givens_cos[col] = conj(this_hess) / hypotenuse;
+                givens_sin[col] = conj(next_hess) / hypotenuse;
+            }
+            triangular->at(col, col) =
+                givens_cos[col] * this_hess + givens_sin[col] * next_hess;
+            triangular->at(col + 1, col) = zero<ValueType>();
+            residual_norm_collection[col + 1] =
+                -conj(givens_sin[col]) * residual_norm_collection[col];
+            residual_norm_collection[col] =
+                givens_cos[col] * residual_norm_collection[col];
+            ++num_krylov;
+            ++total_iter;
+            host_residual_norm->at(0, 0) =
+                abs(residual_norm_collection[col + 1]);
+            residual_norm->copy_from(lend(host_residual_norm));
+            if (check_convergence(total_iter)) {
+                converged = true;
+                break;
+            }
+            if (breakdown) {
+                break;
+            }
+        }
+
+        // y = triangular \ residual_norm_collection
+        const auto num_cols = num_recycled + num_krylov;
+        std::vector<ValueType> y(num_cols);
+        for (auto i = num_cols; i-- > 0;) {
+            auto value = residual_norm_collection[i];
+            for (auto l = i + 1; l < num_cols; ++l) {
+                value -= triangular->at(i, l) * y[l];
+            }
+            y[i] = value / triangular->at(i, i);
+        }
+        // x = x + M (U D y_U + V y_V)
+        auto coeffs_u = Vector::create(host_exec, dim<2>{1, num_recycled});
+        for (size_type i = 0; i < num_recycled; ++i) {
+            coeffs_u->at(0, i) = scaling[i] * y[i];
+        }
+        auto coeffs_v = Vector::create(host_exec, dim<2>{1, num_krylov});
+        for (size_type i = 0; i < num_krylov; ++i) {
+            coeffs_v->at(0, i) = y[num_recycled + i];
+        }
+        update_trans->fill(zero<ValueType>());
+        if (num_recycled > 0) {
+            combine_rows(lend(coeffs_u), lend(space), one<ValueType>(),
+                         zero<ValueType>(), lend(update_trans));
+        }
+        combine_rows(lend(coeffs_v), lend(first_rows(lend(basis), num_krylov)),
+                     one<ValueType>(), one<ValueType>(), lend(update_trans));
+        update_solution();
+
+        if (recycle_dim > 0) {
+            // W_hat^H W = [C^H U D, 0; V_{j+1}^H U D, I_{j+1,j}]
+            auto w_hat_w =
+                Vector::create(host_exec, dim<2>{num_cols + 1, num_cols});
+            w_hat_w->fill(zero<ValueType>());
+            if (num_recycled > 0) {
+                auto image_space =
+                    compute_inner_products(lend(image), lend(space));
+                auto basis_space = compute_inner_products(
+                    lend(first_rows(lend(basis), num_krylov + 1)),
+                    lend(space));
+                for (size_type i = 0; i < num_recycled; ++i) {
+                    for (size_type l = 0; l < num_recycled; ++l) {
+                        w_hat_w->at(l, i) = image_space->at(l, i) * scaling[i];
+                    }
+                    for (size_type l = 0; l <= num_krylov; ++l) {
+                        w_hat_w->at(num_recycled + l, i) =
+                            basis_space->at(l, i) * scaling[i];
+                    }
+                }
+            }
+            for (size_type i = 0; i < num_krylov; ++i) {
+                w_hat_w->at(num_recycled + i, num_recycled + i) =
+                    one<ValueType>();
+            }
+            auto g = Vector::create(host_exec, dim<2>{num_cols + 1, num_cols});
+            for (size_type i = 0; i <= num_cols; ++i) {
+                for (size_type l = 0; l < num_cols; ++l) {
+                    g->at(i, l) = hessenberg->at(i, l);
+                }
+            }
+            auto coeffs = compute_harmonic_ritz_coefficients(
+                lend(g), lend(w_hat_w), std::min(recycle_dim, num_cols));
+            // G P = Q R, C_new = W_hat Q and U_new = W P R^-1
+            auto g_coeffs =
+                Vector::create(host_exec, dim<2>{num_cols + 1,
+                                                 coeffs->get_size()[1]});
+            g->apply(lend(coeffs), lend(g_coeffs));
+            std::unique_ptr<Vector> q;
+            std::unique_ptr<Vector> r;
+            const auto kept = orthonormalize_columns(lend(g_coeffs), q, r);
+            const auto num_new = kept.size();
+            if (num_new > 0) {
+                auto kept_coeffs =
+                    Vector::create(host_exec, dim<2>{num_cols, num_new});
+                for (size_type i = 0; i < num_cols; ++i) {
+                    for (size_type l = 0; l < num_new; ++l) {
+                        kept_coeffs->at(i, l) = coeffs->at(i, kept[l]);
+                    }
+                }
+                auto space_coeffs =
+                    solve_upper_from_right(lend(kept_coeffs), lend(r));
+                // as rows: C_new = Q^T W_hat, U_new = (P R^-1)^T W
+                auto q_trans = as<Vector>(q->transpose());
+                auto space_trans = as<Vector>(space_coeffs->transpose());
+                auto new_image =
+                    Vector::create(exec, dim<2>{num_new, num_rows});
+                auto new_space =
+                    Vector::create(exec, dim<2>{num_new, num_rows});
+                new_image->fill(zero<ValueType>());
+                new_space->fill(zero<ValueType>());
+                if (num_recycled > 0) {
+                    combine_rows(lend(q_trans->create_submatrix(
+                                     span{0, num_new}, span{0, num_recycled})),
+                                 lend(image), one<ValueType>(),
+                                 zero<ValueType>(), lend(new_image));
+                    auto scaled = space_trans->create_submatrix(
+                        span{0, num_new}, span{0, num_recycled});
+                    for (size_type i = 0; i < num_new; ++i) {
+                        for (size_type l = 0; l < num_recycled; ++l) {
+                            scaled->at(i, l) *= scaling[l];
+                        }
+                    }
+                    combine_rows(lend(scaled), lend(space), one<ValueType>(),
+                                 zero<ValueType>(), lend(new_space));
+                }
+                combine_rows(
+                    lend(q_trans->create_submatrix(
+                        span{0, num_new},
+                        span{num_recycled, num_cols + 1})),
+                    lend(first_rows(lend(basis), num_krylov + 1)),
+                    one<ValueType>(), one<ValueType>(), lend(new_image));
+                combine_rows(lend(space_trans->create_submatrix(
+                                 span{0, num_new},
+                                 span{num_recycled, num_cols})),
+                             lend(first_rows(lend(basis), num_krylov)),
+                             one<ValueType>(), one<ValueType>(),
+                             lend(new_space));
+                recycle_space_ = std::move(new_space);
+                recycle_image_ = std::move(new_image);
+            }
+        }
+        if (converged) {
+            break;
+        }
+    }
+}
+
+
+template <typename ValueType>
+void GcroDr<ValueType>::apply_impl(const LinOp *alpha, const LinOp *b,
+                                   const LinOp *beta, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_dense_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_GCRO_DR(_type) class GcroDr<_type>
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_GCRO_DR);
+
+
+}  // namespace solver
+}  // namespace gko
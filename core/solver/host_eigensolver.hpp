@@ -0,0 +1,217 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_CORE_SOLVER_HOST_EIGENSOLVER_HPP_
+#define GKO_CORE_SOLVER_HOST_EIGENSOLVER_HPP_
+
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace solver {
+namespace detail {
+
+
+// Computes the eigenvalues of the upper Hessenberg matrix h (row-major,
+// size x size) by the shifted QR algorithm with Wilkinson shifts in complex
+// arithmetic.
+template <typename T>
+inline std::vector<std::complex<T>> compute_hessenberg_eigenvalues(
+    std::vector<std::complex<T>> h, size_type size)
+{
+    using C = std::complex<T>;
+    auto at = [&](size_type row, size_type col) -> C & {
+        return h[row * size + col];
+    };
+    const auto eps = std::numeric_limits<T>::epsilon();
+    std::vector<C> eigenvalues(size);
+    // the active block consists of the rows and columns [lo, hi)
+    auto hi = size;
+    size_type iter{};
+    while (hi > 0) {
+        auto lo = hi - 1;
+        while (lo > 0 && std::abs(at(lo, lo - 1)) >
+                             eps * (std::abs(at(lo, lo)) +
+                                    std::abs(at(lo - 1, lo - 1)))) {
+            --lo;
+        }
+        if (lo == hi - 1) {
+            eigenvalues[hi - 1] = at(hi - 1, hi - 1);
+            --hi;
+            iter = 0;
+            continue;
+        }
+        if (iter > 30 * size) {
+            // no convergence, use the diagonal as approximation
+            for (size_type i = 0; i < hi; ++i) {
+                eigenvalues[i] = at(i, i);
+            }
+            break;
+        }
+        // Wilkinson shift from the trailing 2 x 2 block, with an exceptional
+        // shift every 10 iterations to avoid cycling
+        const auto a = at(hi - 2, hi - 2);
+        const auto b = at(hi - 2, hi - 1);
+        const auto c = at(hi - 1, hi - 2);
+        const auto d = at(hi - 1, hi - 1);
+        const auto half_trace = (a + d) / T{2};
+        const auto disc = std::sqrt(half_trace * half_trace - (a * d - b * c));
+        auto shift = std::abs(half_trace + disc - d) <
+                             std::abs(half_trace - disc - d)
+                         ? half_trace + disc
+                         : half_trace - disc;
+        if (iter % 10 == 9) {
+            shift = d + C(std::abs(c));
+        }
+        ++iter;
+        // QR step H - shift I = Q R, H = R Q + shift I on the active block
+        for (auto k = lo; k < hi; ++k) {
+            at(k, k) -= shift;
+        }
+        std::vector<C> cosines(hi);
+        std::vector<C> sines(hi);
+        for (auto k = lo; k + 1 < hi; ++k) {
+            const auto x = at(k, k);
+            const auto y = at(k + 1, k);
+            const auto norm = std::sqrt(std::norm(x) + std::norm(y));
+            cosines[k] = norm == T{} ? C(1) : x / norm;
+            sines[k] = norm == T{} ? C(0) : y / norm;
+            for (auto col = k; col < hi; ++col) {
+                const auto t1 = at(k, col);
+                const auto t2 = at(k + 1, col);
+                at(k, col) = std::conj(cosines[k]) * t1 +
+                             std::conj(sines[k]) * t2;
+                at(k + 1, col) = -sines[k] * t1 + cosines[k] * t2;
+            }
+        }
+        for (auto k = lo; k + 1 < hi; ++k) {
+            for (auto row = lo; row <= k + 1; ++row) {
+                const auto t1 = at(row, k);
+                const auto t2 = at(row, k + 1);
+                at(row, k) = t1 * cosines[k] + t2 * sines[k];
+                at(row, k + 1) =
+                    -t1 * std::conj(sines[k]) + t2 * std::conj(cosines[k]);
+            }
+        }
+        for (auto k = lo; k < hi; ++k) {
+            at(k, k) += shift;
+        }
+    }
+    return eigenvalues;
+}
+
+
+// Reduces the general matrix a (row-major, size x size) to upper Hessenberg
+// form by Householder reflections. The eigenvalues are preserved, the
+// reflections are not stored.
+template <typename T>
+inline void reduce_to_hessenberg(std::vector<std::complex<T>> &a,
+                                 size_type size)
+{
+    using C = std::complex<T>;
+    auto at = [&](size_type row, size_type col) -> C & {
+        return a[row * size + col];
+    };
+    std::vector<C> reflector(size);
+    for (size_type k = 0; k + 2 < size; ++k) {
+        T norm{};
+        for (auto i = k + 1; i < size; ++i) {
+            norm += std::norm(at(i, k));
+        }
+        norm = std::sqrt(norm);
+        if (norm == T{}) {
+            continue;
+        }
+        // v = x + e^(i arg(x_0)) ||x|| e_0, H = I - 2 v v^H / (v^H v)
+        const auto first = at(k + 1, k);
+        const auto phase =
+            std::abs(first) == T{} ? C(1) : first / std::abs(first);
+        T v_norm{};
+        for (auto i = k + 1; i < size; ++i) {
+            reflector[i] = at(i, k);
+        }
+        reflector[k + 1] += phase * norm;
+        for (auto i = k + 1; i < size; ++i) {
+            v_norm += std::norm(reflector[i]);
+        }
+        // A = H A
+        for (auto col = k; col < size; ++col) {
+            C dot{};
+            for (auto i = k + 1; i < size; ++i) {
+                dot += std::conj(reflector[i]) * at(i, col);
+            }
+            dot *= T{2} / v_norm;
+            for (auto i = k + 1; i < size; ++i) {
+                at(i, col) -= dot * reflector[i];
+            }
+        }
+        // A = A H
+        for (size_type row = 0; row < size; ++row) {
+            C dot{};
+            for (auto i = k + 1; i < size; ++i) {
+                dot += at(row, i) * reflector[i];
+            }
+            dot *= T{2} / v_norm;
+            for (auto i = k + 1; i < size; ++i) {
+                at(row, i) -= dot * std::conj(reflector[i]);
+            }
+        }
+        for (auto i = k + 2; i < size; ++i) {
+            at(i, k) = C{};
+        }
+    }
+}
+
+
+// Computes the eigenvalues of the general matrix a (row-major, size x size).
+template <typename T>
+inline std::vector<std::complex<T>> compute_eigenvalues(
+    std::vector<std::complex<T>> a, size_type size)
+{
+    reduce_to_hessenberg(a, size);
+    return compute_hessenberg_eigenvalues(std::move(a), size);
+}
+
+
+}  // namespace detail
+}  // namespace solver
+}  // namespace gko
+
+
+#endif  // GKO_CORE_SOLVER_HOST_EIGENSOLVER_HPP_
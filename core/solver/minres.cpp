@@ -0,0 +1,227 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/minres.hpp>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/name_demangling.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/utils.hpp>
+
+
+#include "core/solver/minres_kernels.hpp"
+
+
+namespace gko {
+namespace solver {
+
+
+namespace minres {
+
+
+GKO_REGISTER_OPERATION(initialize_1, minres::initialize_1);
+GKO_REGISTER_OPERATION(initialize_2, minres::initialize_2);
+GKO_REGISTER_OPERATION(step_1, minres::step_1);
+GKO_REGISTER_OPERATION(step_2, minres::step_2);
+
+
+}  // namespace minres
+
+
+template <typename ValueType>
+std::unique_ptr<LinOp> Minres<ValueType>::transpose() const
+{
+    return build()
+        .with_generated_preconditioner(
+            share(as<Transposable>(this->get_preconditioner())->transpose()))
+        .with_criteria(this->stop_criterion_factory_)
+        .on(this->get_executor())
+        ->generate(
+            share(as<Transposable>(this->get_system_matrix())->transpose()));
+}
+
+
+template <typename ValueType>
+std::unique_ptr<LinOp> Minres<ValueType>::conj_transpose() const
+{
+    return build()
+        .with_generated_preconditioner(share(
+            as<Transposable>(this->get_preconditioner())->conj_transpose()))
+        .with_criteria(this->stop_criterion_factory_)
+        .on(this->get_executor())
+        ->generate(share(
+            as<Transposable>(this->get_system_matrix())->conj_transpose()));
+}
+
+
+template <typename ValueType>
+void Minres<ValueType>::apply_impl(const LinOp *b, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->apply_dense_impl(dense_b, dense_x);
+        },
+        b, x);
+}
+
+
+template <typename ValueType>
+void Minres<ValueType>::apply_dense_impl(
+    const matrix::Dense<ValueType> *dense_b,
+    matrix::Dense<ValueType> *dense_x) const
+{
+    using std::swap;
+    using Vector = matrix::Dense<ValueType>;
+    using NormVector = matrix::Dense<remove_complex<ValueType>>;
+
+    constexpr uint8 RelativeStoppingId{1};
+
+    auto exec = this->get_executor();
+
+    auto one_op = initialize<Vector>({one<ValueType>()}, exec);
+    auto neg_one_op = initialize<Vector>({-one<ValueType>()}, exec);
+
+    // r and r_prev are the last two (unnormalized) Lanczos vectors, w and
+    // w_prev the last two search directions
+    auto r = Vector::create_with_config_of(dense_b);
+    auto r_prev = Vector::create_with_config_of(dense_b);
+    auto z = Vector::create_with_config_of(dense_b);
+    auto q = Vector::create_with_config_of(dense_b);
+    auto w = Vector::create_with_config_of(dense_b);
+    auto w_prev = Vector::create_with_config_of(dense_b);
+
+    auto alpha = Vector::create(exec, dim<2>{1, dense_b->get_size()[1]});
+    auto beta = Vector::create_with_config_of(alpha.get());
+    auto prev_beta = Vector::create_with_config_of(alpha.get());
+    auto delta_bar = Vector::create_with_config_of(alpha.get());
+    auto eps = Vector::create_with_config_of(alpha.get());
+    auto cos = Vector::create_with_config_of(alpha.get());
+    auto sin = Vector::create_with_config_of(alpha.get());
+    auto phi_bar = Vector::create_with_config_of(alpha.get());
+    auto residual_norm =
+        NormVector::create(exec, dim<2>{1, dense_b->get_size()[1]});
+
+    bool one_changed{};
+    Array<stopping_status> stop_status(alpha->get_executor(),
+                                       dense_b->get_size()[1]);
+
+    exec->run(minres::make_initialize_1(
+        dense_b, r.get(), r_prev.get(), w.get(), w_prev.get(), prev_beta.get(),
+        delta_bar.get(), eps.get(), cos.get(), sin.get(), &stop_status));
+    // r = dense_b
+    // r_prev = w = w_prev = 0
+    // prev_beta = delta_bar = eps = sin = 0
+    // cos = -1
+
+    system_matrix_->apply(neg_one_op.get(), dense_x, one_op.get(), r.get());
+    auto stop_criterion = stop_criterion_factory_->generate(
+        system_matrix_,
+        std::shared_ptr<const LinOp>(dense_b, [](const LinOp *) {}), dense_x,
+        r.get());
+    get_preconditioner()->apply(r.get(), z.get());
+    r->compute_dot(z.get(), beta.get());
+    exec->run(minres::make_initialize_2(beta.get(), phi_bar.get(),
+                                        residual_norm.get()));
+    // beta = phi_bar = residual_norm = sqrt(r^H M r)
+
+    int iter = -1;
+    /* Memory movement summary:
+     * 19n * values + matrix/preconditioner storage
+     * 1x SpMV:           2n * values + storage
+     * 1x Preconditioner: 2n * values + storage
+     * 2x dot             4n
+     * 1x step 1          6n
+     * 1x step 2          5n
+     */
+    while (true) {
+        ++iter;
+        this->template log<log::Logger::iteration_complete>(
+            this, iter, nullptr, dense_x, residual_norm.get());
+        if (stop_criterion->update()
+                .num_iterations(iter)
+                .residual_norm(residual_norm.get())
+                .solution(dense_x)
+                .check(RelativeStoppingId, true, &stop_status, &one_changed)) {
+            break;
+        }
+
+        system_matrix_->apply(z.get(), q.get());
+        z->compute_dot(q.get(), alpha.get());
+        // v = z / beta
+        // r_prev = (q - alpha / beta^2 * r) / beta - beta / prev_beta * r_prev
+        // q = v
+        exec->run(minres::make_step_1(q.get(), z.get(), r.get(), r_prev.get(),
+                                      alpha.get(), beta.get(), prev_beta.get(),
+                                      &stop_status));
+        swap(r, r_prev);
+        get_preconditioner()->apply(r.get(), z.get());
+        r->compute_dot(z.get(), prev_beta.get());
+        // prev_beta = sqrt(prev_beta)
+        // update the QR factorization of the tridiagonal matrix by a rotation
+        // w_prev = (v - eps * w_prev - delta * w) / gamma
+        // x = x + phi * w_prev
+        // residual_norm = |phi_bar|
+        exec->run(minres::make_step_2(
+            dense_x, q.get(), w.get(), w_prev.get(), alpha.get(), beta.get(),
+            prev_beta.get(), delta_bar.get(), eps.get(), cos.get(), sin.get(),
+            phi_bar.get(), residual_norm.get(), &stop_status));
+        swap(w, w_prev);
+        swap(beta, prev_beta);
+    }
+}
+
+
+template <typename ValueType>
+void Minres<ValueType>::apply_impl(const LinOp *alpha, const LinOp *b,
+                               const LinOp *beta, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_dense_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_MINRES(_type) class Minres<_type>
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES);
+
+
+}  // namespace solver
+}  // namespace gko
@@ -0,0 +1,160 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_CORE_SOLVER_MINRES_KERNELS_HPP_
+#define GKO_CORE_SOLVER_MINRES_KERNELS_HPP_
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/stop/stopping_status.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace minres {
+
+
+#define GKO_DECLARE_MINRES_INITIALIZE_1_KERNEL(_type)                  \
+    void initialize_1(                                                 \
+        std::shared_ptr<const DefaultExecutor> exec,                   \
+        const matrix::Dense<_type> *b, matrix::Dense<_type> *r,        \
+        matrix::Dense<_type> *r_prev, matrix::Dense<_type> *w,         \
+        matrix::Dense<_type> *w_prev, matrix::Dense<_type> *prev_beta, \
+        matrix::Dense<_type> *delta_bar, matrix::Dense<_type> *eps,    \
+        matrix::Dense<_type> *cos, matrix::Dense<_type> *sin,          \
+        Array<stopping_status> *stop_status)
+
+
+#define GKO_DECLARE_MINRES_INITIALIZE_2_KERNEL(_type)              \
+    void initialize_2(std::shared_ptr<const DefaultExecutor> exec, \
+                      matrix::Dense<_type> *beta,                  \
+                      matrix::Dense<_type> *phi_bar,               \
+                      matrix::Dense<remove_complex<_type>> *residual_norm)
+
+
+#define GKO_DECLARE_MINRES_STEP_1_KERNEL(_type)                              \
+    void step_1(std::shared_ptr<const DefaultExecutor> exec,                 \
+                matrix::Dense<_type> *q, const matrix::Dense<_type> *z,      \
+                const matrix::Dense<_type> *r, matrix::Dense<_type> *r_prev, \
+                const matrix::Dense<_type> *alpha,                           \
+                const matrix::Dense<_type> *beta,                            \
+                const matrix::Dense<_type> *prev_beta,                       \
+                const Array<stopping_status> *stop_status)
+
+
+#define GKO_DECLARE_MINRES_STEP_2_KERNEL(_type)                              \
+    void step_2(std::shared_ptr<const DefaultExecutor> exec,                 \
+                matrix::Dense<_type> *x, const matrix::Dense<_type> *v,      \
+                const matrix::Dense<_type> *w, matrix::Dense<_type> *w_prev, \
+                const matrix::Dense<_type> *alpha,                           \
+                const matrix::Dense<_type> *beta,                            \
+                matrix::Dense<_type> *next_beta,                             \
+                matrix::Dense<_type> *delta_bar, matrix::Dense<_type> *eps,  \
+                matrix::Dense<_type> *cos, matrix::Dense<_type> *sin,        \
+                matrix::Dense<_type> *phi_bar,                               \
+                matrix::Dense<remove_complex<_type>> *residual_norm,         \
+                const Array<stopping_status> *stop_status)
+
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                   \
+    template <typename ValueType>                      \
+    GKO_DECLARE_MINRES_INITIALIZE_1_KERNEL(ValueType); \
+    template <typename ValueType>                      \
+    GKO_DECLARE_MINRES_INITIALIZE_2_KERNEL(ValueType); \
+    template <typename ValueType>                      \
+    GKO_DECLARE_MINRES_STEP_1_KERNEL(ValueType);       \
+    template <typename ValueType>                      \
+    GKO_DECLARE_MINRES_STEP_2_KERNEL(ValueType)
+
+
+}  // namespace minres
+
+
+namespace omp {
+namespace minres {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace minres
+}  // namespace omp
+
+
+namespace cuda {
+namespace minres {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace minres
+}  // namespace cuda
+
+
+namespace reference {
+namespace minres {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace minres
+}  // namespace reference
+
+
+namespace hip {
+namespace minres {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace minres
+}  // namespace hip
+
+
+namespace dpcpp {
+namespace minres {
+
+GKO_DECLARE_ALL_AS_TEMPLATES;
+
+}  // namespace minres
+}  // namespace dpcpp
+
+
+#undef GKO_DECLARE_ALL_AS_TEMPLATES
+
+
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_CORE_SOLVER_MINRES_KERNELS_HPP_
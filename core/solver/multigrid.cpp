@@ -0,0 +1,299 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/multigrid.hpp>
+
+
+#include <algorithm>
+
+
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+
+
+#include "core/solver/ir_kernels.hpp"
+
+
+namespace gko {
+namespace solver {
+namespace multigrid {
+
+
+GKO_REGISTER_OPERATION(initialize, ir::initialize);
+
+
+}  // namespace multigrid
+
+
+namespace {
+
+
+std::shared_ptr<const LinOpFactory> get_level_factory(
+    const std::vector<std::shared_ptr<const LinOpFactory>> &factories,
+    size_type level)
+{
+    if (factories.empty()) {
+        return nullptr;
+    }
+    return factories[std::min(level, factories.size() - 1)];
+}
+
+
+template <typename ValueType>
+void apply_smoother(const LinOp *smoother, const LinOp *op,
+                    const matrix::Dense<ValueType> *one_op,
+                    const matrix::Dense<ValueType> *neg_one_op,
+                    const matrix::Dense<ValueType> *b,
+                    matrix::Dense<ValueType> *x, matrix::Dense<ValueType> *r)
+{
+    if (smoother->apply_uses_initial_guess()) {
+        smoother->apply(b, x);
+    } else {
+        // x = x + S(b - A x)
+        r->copy_from(b);
+        op->apply(neg_one_op, x, one_op, r);
+        smoother->apply(one_op, r, one_op, x);
+    }
+}
+
+
+}  // namespace
+
+
+template <typename ValueType>
+void Multigrid<ValueType>::generate()
+{
+    auto exec = this->get_executor();
+    one_op_ = initialize<matrix::Dense<ValueType>>({one<ValueType>()}, exec);
+    neg_one_op_ =
+        initialize<matrix::Dense<ValueType>>({-one<ValueType>()}, exec);
+    auto matrix = system_matrix_;
+    for (size_type level = 0; level < parameters_.max_levels; ++level) {
+        const auto num_rows = matrix->get_size()[0];
+        const auto level_factory =
+            get_level_factory(parameters_.mg_level, level);
+        if (num_rows <= parameters_.min_coarse_rows || !level_factory) {
+            break;
+        }
+        auto mg_level = as<gko::multigrid::MultigridLevel>(
+            share(level_factory->generate(matrix)));
+        auto coarse = mg_level->get_coarse_op();
+        if (coarse->get_size()[0] >= num_rows) {
+            // the level does not coarsen the operator anymore
+            break;
+        }
+        auto pre_factory =
+            get_level_factory(parameters_.pre_smoother, level);
+        auto post_factory = parameters_.post_uses_pre
+                                ? pre_factory
+                                : get_level_factory(
+                                      parameters_.post_smoother, level);
+        auto pre_smoother =
+            pre_factory ? share(pre_factory->generate(matrix)) : nullptr;
+        auto post_smoother =
+            parameters_.post_uses_pre
+                ? pre_smoother
+                : (post_factory ? share(post_factory->generate(matrix))
+                                : nullptr);
+        mg_level_list_.push_back(std::move(mg_level));
+        pre_smoother_list_.push_back(std::move(pre_smoother));
+        post_smoother_list_.push_back(std::move(post_smoother));
+        matrix = coarse;
+    }
+    if (parameters_.coarsest_solver) {
+        coarsest_solver_ = parameters_.coarsest_solver->generate(matrix);
+    } else {
+        coarsest_solver_ =
+            matrix::Identity<ValueType>::create(exec, matrix->get_size()[0]);
+    }
+}
+
+
+template <typename ValueType>
+void Multigrid<ValueType>::apply_impl(const LinOp *b, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->apply_dense_impl(dense_b, dense_x);
+        },
+        b, x);
+}
+
+
+template <typename ValueType>
+void Multigrid<ValueType>::apply_dense_impl(
+    const matrix::Dense<ValueType> *dense_b,
+    matrix::Dense<ValueType> *dense_x) const
+{
+    using Vector = matrix::Dense<ValueType>;
+    constexpr uint8 relative_stopping_id{1};
+
+    auto exec = this->get_executor();
+    const auto num_rhs = dense_b->get_size()[1];
+
+    // the work vectors are only allocated once for a number of right-hand
+    // sides
+    const auto num_levels = mg_level_list_.size();
+    auto &levels = workspace_.levels;
+    if (levels.empty() || levels[0].r->get_size()[1] != num_rhs) {
+        levels.clear();
+        levels.resize(num_levels + 1);
+        for (size_type level = 0; level <= num_levels; ++level) {
+            const auto num_rows =
+                level < num_levels
+                    ? mg_level_list_[level]->get_fine_op()->get_size()[0]
+                    : coarsest_solver_->get_size()[0];
+            const dim<2> size{num_rows, num_rhs};
+            if (level > 0) {
+                levels[level].b = Vector::create(exec, size);
+                levels[level].x = Vector::create(exec, size);
+            }
+            levels[level].r = Vector::create(exec, size);
+        }
+    }
+    auto residual = lend(levels[0].r);
+
+    if (parameters_.zero_initial_guess) {
+        dense_x->fill(zero<ValueType>());
+    }
+
+    bool one_changed{};
+    Array<stopping_status> stop_status(exec, num_rhs);
+    exec->run(multigrid::make_initialize(&stop_status));
+
+    residual->copy_from(dense_b);
+    system_matrix_->apply(lend(neg_one_op_), dense_x, lend(one_op_),
+                          residual);
+
+    auto stop_criterion = stop_criterion_factory_->generate(
+        system_matrix_,
+        std::shared_ptr<const LinOp>(dense_b, [](const LinOp *) {}), dense_x,
+        residual);
+
+    int iter = -1;
+    while (true) {
+        ++iter;
+        this->template log<log::Logger::iteration_complete>(this, iter,
+                                                            residual, dense_x);
+
+        if (stop_criterion->update()
+                .num_iterations(iter)
+                .residual(residual)
+                .solution(dense_x)
+                .check(relative_stopping_id, true, &stop_status,
+                       &one_changed)) {
+            break;
+        }
+
+        this->run_cycle(parameters_.cycle, 0, dense_b, dense_x);
+
+        // residual = b - A * x
+        residual->copy_from(dense_b);
+        system_matrix_->apply(lend(neg_one_op_), dense_x, lend(one_op_),
+                              residual);
+    }
+}
+
+
+template <typename ValueType>
+void Multigrid<ValueType>::run_cycle(multigrid_cycle cycle, size_type level,
+                                     const matrix::Dense<ValueType> *b,
+                                     matrix::Dense<ValueType> *x) const
+{
+    auto r = lend(workspace_.levels[level].r);
+    if (level == mg_level_list_.size()) {
+        const auto op = level > 0 ? mg_level_list_.back()->get_coarse_op()
+                                  : system_matrix_;
+        apply_smoother(lend(coarsest_solver_), lend(op), lend(one_op_),
+                       lend(neg_one_op_), b, x, r);
+        return;
+    }
+    const auto &mg_level = mg_level_list_[level];
+    const auto op = mg_level->get_fine_op();
+
+    if (pre_smoother_list_[level]) {
+        apply_smoother(lend(pre_smoother_list_[level]), lend(op),
+                       lend(one_op_), lend(neg_one_op_), b, x, r);
+    }
+    // r = b - A * x
+    r->copy_from(b);
+    op->apply(lend(neg_one_op_), x, lend(one_op_), r);
+    // the coarse correction equation A_c e = R r starts from e = 0
+    auto coarse_b = lend(workspace_.levels[level + 1].b);
+    auto coarse_x = lend(workspace_.levels[level + 1].x);
+    mg_level->get_restrict_op()->apply(r, coarse_b);
+    coarse_x->fill(zero<ValueType>());
+    switch (cycle) {
+    case multigrid_cycle::v:
+        this->run_cycle(multigrid_cycle::v, level + 1, coarse_b, coarse_x);
+        break;
+    case multigrid_cycle::w:
+        this->run_cycle(multigrid_cycle::w, level + 1, coarse_b, coarse_x);
+        this->run_cycle(multigrid_cycle::w, level + 1, coarse_b, coarse_x);
+        break;
+    case multigrid_cycle::f:
+        this->run_cycle(multigrid_cycle::f, level + 1, coarse_b, coarse_x);
+        this->run_cycle(multigrid_cycle::v, level + 1, coarse_b, coarse_x);
+        break;
+    }
+    // x = x + P * e
+    mg_level->get_prolong_op()->apply(lend(one_op_), coarse_x, lend(one_op_),
+                                      x);
+    if (post_smoother_list_[level]) {
+        apply_smoother(lend(post_smoother_list_[level]), lend(op),
+                       lend(one_op_), lend(neg_one_op_), b, x, r);
+    }
+}
+
+
+template <typename ValueType>
+void Multigrid<ValueType>::apply_impl(const LinOp *alpha, const LinOp *b,
+                                      const LinOp *beta, LinOp *x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            auto x_clone = dense_x->clone();
+            this->apply_dense_impl(dense_b, x_clone.get());
+            dense_x->scale(dense_beta);
+            dense_x->add_scaled(dense_alpha, x_clone.get());
+        },
+        alpha, b, beta, x);
+}
+
+
+#define GKO_DECLARE_MULTIGRID(_type) class Multigrid<_type>
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MULTIGRID);
+
+
+}  // namespace solver
+}  // namespace gko
@@ -33,14 +33,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/base/mtx_io.hpp>
 
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
 #include <sstream>
+#include <string>
 
 
 #include <gtest/gtest.h>
 
 
 #include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
 #include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
 
 
 #include "core/test/utils.hpp"
@@ -409,6 +416,507 @@ TEST(MtxReader, FailsWhenReadingSparseComplexMtxToRealMtx)
 }
 
 
+/**
+ * Writes its content to a file that is removed again at the end of the
+ * test.
+ */
+class temporary_file {
+public:
+    explicit temporary_file(const std::string &content)
+        : filename_{std::string{"mtx_io_test_"} +
+                    ::testing::UnitTest::GetInstance()
+                        ->current_test_info()
+                        ->name() +
+                    ".mtx"}
+    {
+        std::ofstream(filename_, std::ios::binary) << content;
+    }
+
+    ~temporary_file() { std::remove(filename_.c_str()); }
+
+    const std::string &get_name() const { return filename_; }
+
+private:
+    std::string filename_;
+};
+
+
+std::string generate_coordinate_mtx(const std::string &header, int num_rows,
+                                    bool lower_only, bool complex)
+{
+    std::vector<std::pair<int, int>> coords;
+    for (int row = 0; row < num_rows; ++row) {
+        for (int k = 0; k < 15; ++k) {
+            const auto col = (7 * row + 131 * k) % num_rows;
+            if (!lower_only || col <= row) {
+                coords.emplace_back(row + 1, col + 1);
+            }
+        }
+    }
+    std::shuffle(coords.begin(), coords.end(), std::ranlux48(42));
+    // exercise the different ways a number can be written, including some
+    // that are not converted exactly by the fast path
+    const char *values[] = {"1.5e-3", "-2", "3.",        ".25",
+                            "1E+300", "-0", "7.0000001", "12e-30",
+                            "+4.5",   "0.1234567890123456789"};
+    std::ostringstream oss;
+    oss << header << "%  a comment\n"
+        << num_rows << ' ' << num_rows << ' ' << coords.size() << '\n';
+    int i{};
+    for (const auto &coord : coords) {
+        oss << coord.first << ' ' << coord.second << "  "
+            << values[i++ % 10];
+        if (complex) {
+            oss << '\t' << values[(3 * i) % 10];
+        }
+        oss << (i % 7 == 0 ? " \r\n" : "\n");
+    }
+    return oss.str();
+}
+
+
+TEST(MtxReader, ReadsSparseRealMtxFromFile)
+{
+    using tpl = gko::matrix_data<double, gko::int32>::nonzero_type;
+    temporary_file file(
+        "%%MatrixMarket matrix coordinate real general\n"
+        "2 3 4\n"
+        "1 1 1.0\n"
+        "2 2 5.0\n"
+        "1 2 3.0\n"
+        "1 3 2.0\n");
+
+    auto data = gko::read_raw<double, gko::int32>(file.get_name());
+
+    ASSERT_EQ(data.size, gko::dim<2>(2, 3));
+    auto &v = data.nonzeros;
+    ASSERT_EQ(v.size(), 4);
+    ASSERT_EQ(v[0], tpl(0, 0, 1.0));
+    ASSERT_EQ(v[1], tpl(0, 1, 3.0));
+    ASSERT_EQ(v[2], tpl(0, 2, 2.0));
+    ASSERT_EQ(v[3], tpl(1, 1, 5.0));
+}
+
+
+TEST(MtxReader, ReadsDenseRealMtxFromFile)
+{
+    using tpl = gko::matrix_data<double, gko::int32>::nonzero_type;
+    temporary_file file(
+        "%%MatrixMarket matrix array real general\n"
+        "2 2\n"
+        "1.0\n"
+        "2.0\n"
+        "3.0\n"
+        "4.0\n");
+
+    auto data = gko::read_raw<double, gko::int32>(file.get_name());
+
+    ASSERT_EQ(data.size, gko::dim<2>(2, 2));
+    auto &v = data.nonzeros;
+    ASSERT_EQ(v[0], tpl(0, 0, 1.0));
+    ASSERT_EQ(v[1], tpl(0, 1, 3.0));
+    ASSERT_EQ(v[2], tpl(1, 0, 2.0));
+    ASSERT_EQ(v[3], tpl(1, 1, 4.0));
+}
+
+
+TEST(MtxReader, ReadsSparseComplexHermitianMtxFromFile)
+{
+    using cpx = std::complex<double>;
+    using tpl = gko::matrix_data<cpx, gko::int32>::nonzero_type;
+    temporary_file file(
+        "%%MatrixMarket matrix coordinate complex hermitian\n"
+        "2 3 2\n"
+        "1 2 3.0 1.0\n"
+        "1 3 2.0 4.0\n");
+
+    auto data = gko::read_raw<cpx, gko::int32>(file.get_name());
+
+    ASSERT_EQ(data.size, gko::dim<2>(2, 3));
+    auto &v = data.nonzeros;
+    ASSERT_EQ(v[0], tpl(0, 1, cpx(3.0, 1.0)));
+    ASSERT_EQ(v[1], tpl(0, 2, cpx(2.0, 4.0)));
+    ASSERT_EQ(v[2], tpl(1, 0, cpx(3.0, -1.0)));
+    ASSERT_EQ(v[3], tpl(2, 0, cpx(2.0, -4.0)));
+}
+
+
+TEST(MtxReader, ReadsLargeSparseRealMtxFromFileInParallel)
+{
+    auto content = generate_coordinate_mtx(
+        "%%MatrixMarket matrix coordinate real general\n", 3000, false, false);
+    temporary_file file(content);
+    std::istringstream iss(content);
+
+    auto data = gko::read_raw<double, gko::int64>(file.get_name(), 4);
+
+    auto expected = gko::read_raw<double, gko::int64>(iss);
+    ASSERT_EQ(data.size, expected.size);
+    ASSERT_EQ(data.nonzeros, expected.nonzeros);
+}
+
+
+TEST(MtxReader, ReadsLargeSparseRealSymmetricMtxFromFileInParallel)
+{
+    auto content = generate_coordinate_mtx(
+        "%%MatrixMarket matrix coordinate real symmetric\n", 6000, true,
+        false);
+    temporary_file file(content);
+    std::istringstream iss(content);
+
+    auto data = gko::read_raw<float, gko::int32>(file.get_name(), 3);
+
+    auto expected = gko::read_raw<float, gko::int32>(iss);
+    ASSERT_EQ(data.size, expected.size);
+    ASSERT_EQ(data.nonzeros, expected.nonzeros);
+}
+
+
+TEST(MtxReader, ReadsLargeSparseComplexHermitianMtxFromFileInParallel)
+{
+    using cpx = std::complex<double>;
+    auto content = generate_coordinate_mtx(
+        "%%MatrixMarket matrix coordinate complex hermitian\n", 6000, true,
+        true);
+    temporary_file file(content);
+    std::istringstream iss(content);
+
+    auto data = gko::read_raw<cpx, gko::int32>(file.get_name(), 5);
+
+    auto expected = gko::read_raw<cpx, gko::int32>(iss);
+    ASSERT_EQ(data.size, expected.size);
+    ASSERT_EQ(data.nonzeros, expected.nonzeros);
+}
+
+
+TEST(MtxReader, ReportsInvalidEntryInParallelRead)
+{
+    auto content = generate_coordinate_mtx(
+        "%%MatrixMarket matrix coordinate real general\n", 3000, false, false);
+    // corrupt the value of the last entry
+    content.replace(content.rfind(' ', content.size() - 3), 1, "x");
+    temporary_file file(content);
+
+    try {
+        gko::read_raw<double, gko::int32>(file.get_name(), 4);
+        FAIL();
+    } catch (const gko::StreamError &e) {
+        ASSERT_NE(std::string{e.what()}.find("matrix entry 44999"),
+                  std::string::npos);
+    }
+}
+
+
+TEST(MtxReader, FailsWhenFileHasTooFewEntries)
+{
+    temporary_file file(
+        "%%MatrixMarket matrix coordinate real general\n"
+        "2 3 4\n"
+        "1 1 1.0\n"
+        "2 2 5.0\n");
+
+    ASSERT_THROW((gko::read_raw<double, gko::int32>(file.get_name())),
+                 gko::StreamError);
+}
+
+
+TEST(MtxReader, FailsWhenFileHasOutOfBoundsEntries)
+{
+    temporary_file file(
+        "%%MatrixMarket matrix coordinate real general\n"
+        "2 3 2\n"
+        "1 1 1.0\n"
+        "3 2 5.0\n");
+
+    ASSERT_THROW((gko::read_raw<double, gko::int32>(file.get_name())),
+                 gko::StreamError);
+}
+
+
+TEST(MtxReader, FailsWhenReadingFileWithComplexEntriesToRealMtx)
+{
+    temporary_file file(
+        "%%MatrixMarket matrix coordinate complex general\n"
+        "2 3 1\n"
+        "1 1 1.0 2.0\n");
+
+    ASSERT_THROW((gko::read_raw<double, gko::int32>(file.get_name())),
+                 gko::StreamError);
+}
+
+
+TEST(MtxReader, FailsWhenFileDoesNotExist)
+{
+    ASSERT_THROW((gko::read_raw<double, gko::int32>(
+                     std::string{"this_file_does_not_exist.mtx"})),
+                 gko::StreamError);
+}
+
+
+gko::matrix_data<double, gko::int32> get_binary_test_data()
+{
+    gko::matrix_data<double, gko::int32> data{gko::dim<2>{3, 4}};
+    // deliberately out of order, the writer sorts the entries
+    data.nonzeros.emplace_back(2, 3, 6.0);
+    data.nonzeros.emplace_back(0, 0, 1.0);
+    data.nonzeros.emplace_back(0, 2, -2.5);
+    data.nonzeros.emplace_back(2, 0, 4.0);
+    return data;
+}
+
+
+std::string write_binary_test_data()
+{
+    std::ostringstream oss;
+    gko::write_raw(oss, get_binary_test_data(), gko::layout_type::binary);
+    return oss.str();
+}
+
+
+TEST(BinaryIo, WritesAndReadsBinaryThroughStream)
+{
+    using tpl = gko::matrix_data<double, gko::int32>::nonzero_type;
+    std::istringstream iss(write_binary_test_data());
+
+    auto data = gko::read_raw<double, gko::int32>(iss);
+
+    ASSERT_EQ(data.size, gko::dim<2>(3, 4));
+    auto &v = data.nonzeros;
+    ASSERT_EQ(v.size(), 4);
+    ASSERT_EQ(v[0], tpl(0, 0, 1.0));
+    ASSERT_EQ(v[1], tpl(0, 2, -2.5));
+    ASSERT_EQ(v[2], tpl(2, 0, 4.0));
+    ASSERT_EQ(v[3], tpl(2, 3, 6.0));
+}
+
+
+TEST(BinaryIo, WritesBinaryWithAlignedArrays)
+{
+    auto content = write_binary_test_data();
+
+    // header, 4 row pointers, 4 column indexes and 4 values
+    ASSERT_EQ(content.size(), 64 + 64 + 64 + 4 * sizeof(double));
+    ASSERT_EQ(content.substr(0, 8), "GKOMTXBN");
+    const auto row_ptrs =
+        reinterpret_cast<const gko::int32 *>(content.data() + 64);
+    ASSERT_EQ(row_ptrs[0], 0);
+    ASSERT_EQ(row_ptrs[1], 2);
+    ASSERT_EQ(row_ptrs[2], 2);
+    ASSERT_EQ(row_ptrs[3], 4);
+}
+
+
+TEST(BinaryIo, ReadsBinaryFromFileWithConversion)
+{
+    using cpx = std::complex<float>;
+    using tpl = gko::matrix_data<cpx, gko::int64>::nonzero_type;
+    temporary_file file(write_binary_test_data());
+
+    auto data = gko::read_raw<cpx, gko::int64>(file.get_name());
+
+    ASSERT_EQ(data.size, gko::dim<2>(3, 4));
+    auto &v = data.nonzeros;
+    ASSERT_EQ(v.size(), 4);
+    ASSERT_EQ(v[0], tpl(0, 0, cpx{1.0}));
+    ASSERT_EQ(v[1], tpl(0, 2, cpx{-2.5}));
+    ASSERT_EQ(v[2], tpl(2, 0, cpx{4.0}));
+    ASSERT_EQ(v[3], tpl(2, 3, cpx{6.0}));
+}
+
+
+TEST(BinaryIo, FailsWhenReadingComplexBinaryToReal)
+{
+    using cpx = std::complex<double>;
+    gko::matrix_data<cpx, gko::int32> data{gko::dim<2>{1, 1}};
+    data.nonzeros.emplace_back(0, 0, cpx{1.0, 2.0});
+    std::stringstream ss;
+    gko::write_raw(ss, data, gko::layout_type::binary);
+
+    ASSERT_THROW((gko::read_raw<double, gko::int32>(ss)), gko::StreamError);
+}
+
+
+TEST(BinaryIo, FailsWhenReadingTruncatedBinary)
+{
+    auto content = write_binary_test_data();
+    std::istringstream iss(content.substr(0, content.size() - 1));
+
+    ASSERT_THROW((gko::read_raw<double, gko::int32>(iss)), gko::StreamError);
+}
+
+
+TEST(BinaryIo, MapsBinaryArraysWithoutCopy)
+{
+    auto exec = gko::ReferenceExecutor::create();
+    temporary_file file(write_binary_test_data());
+
+    auto arrays = gko::read_binary_arrays<double, gko::int32>(file.get_name(),
+                                                              exec);
+
+    ASSERT_EQ(arrays.size, gko::dim<2>(3, 4));
+    ASSERT_FALSE(arrays.values.is_owning());
+    ASSERT_FALSE(arrays.col_idxs.is_owning());
+    ASSERT_FALSE(arrays.row_ptrs.is_owning());
+    ASSERT_EQ(arrays.row_ptrs.get_num_elems(), 4);
+    ASSERT_EQ(arrays.row_ptrs.get_const_data()[3], 4);
+    ASSERT_EQ(arrays.col_idxs.get_const_data()[1], 2);
+    ASSERT_EQ(arrays.values.get_const_data()[1], -2.5);
+}
+
+
+TEST(BinaryIo, CopiesBinaryArraysWithDifferentTypes)
+{
+    auto exec = gko::ReferenceExecutor::create();
+    temporary_file file(write_binary_test_data());
+
+    auto arrays =
+        gko::read_binary_arrays<float, gko::int64>(file.get_name(), exec);
+
+    ASSERT_TRUE(arrays.values.is_owning());
+    ASSERT_TRUE(arrays.col_idxs.is_owning());
+    ASSERT_EQ(arrays.row_ptrs.get_const_data()[3], 4);
+    ASSERT_EQ(arrays.col_idxs.get_const_data()[3], 3);
+    ASSERT_EQ(arrays.values.get_const_data()[3], 6.0f);
+}
+
+
+TEST(BinaryIo, ReadsCsrFromBinaryFile)
+{
+    using Csr = gko::matrix::Csr<double, gko::int32>;
+    auto exec = gko::ReferenceExecutor::create();
+    temporary_file file(write_binary_test_data());
+
+    auto mtx = gko::read_csr<Csr>(file.get_name(), exec);
+    // modifications only affect the private mapping, not the file
+    mtx->get_values()[0] = 10.0;
+
+    GKO_ASSERT_MTX_NEAR(mtx,
+                        l({{10.0, 0.0, -2.5, 0.0},
+                           {0.0, 0.0, 0.0, 0.0},
+                           {4.0, 0.0, 0.0, 6.0}}),
+                        0.0);
+    auto reread = gko::read_raw<double, gko::int32>(file.get_name());
+    ASSERT_EQ(reread.nonzeros[0].value, 1.0);
+}
+
+
+template <typename ValueType, typename IndexType>
+void assert_csr_arrays_equal(
+    const gko::csr_arrays<ValueType, IndexType> &arrays,
+    const gko::matrix_data<ValueType, IndexType> &data)
+{
+    ASSERT_EQ(arrays.size, data.size);
+    ASSERT_EQ(arrays.row_ptrs.get_num_elems(), data.size[0] + 1);
+    ASSERT_EQ(arrays.col_idxs.get_num_elems(), data.nonzeros.size());
+    ASSERT_EQ(arrays.values.get_num_elems(), data.nonzeros.size());
+    auto row_ptrs = arrays.row_ptrs.get_const_data();
+    ASSERT_EQ(row_ptrs[0], 0);
+    for (gko::size_type row = 0; row < data.size[0]; ++row) {
+        for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+            const auto &entry = data.nonzeros[nz];
+            ASSERT_EQ(entry.row, row);
+            ASSERT_EQ(arrays.col_idxs.get_const_data()[nz], entry.column);
+            ASSERT_EQ(arrays.values.get_const_data()[nz], entry.value);
+        }
+    }
+    ASSERT_EQ(row_ptrs[data.size[0]], data.nonzeros.size());
+}
+
+
+TEST(CsrReader, ReadsLargeSparseRealMtxFromFileInParallel)
+{
+    auto exec = gko::ReferenceExecutor::create();
+    auto content = generate_coordinate_mtx(
+        "%%MatrixMarket matrix coordinate real general\n", 3000, false, false);
+    temporary_file file(content);
+    std::istringstream iss(content);
+
+    auto arrays =
+        gko::read_csr_arrays<double, gko::int64>(file.get_name(), exec, 4);
+
+    assert_csr_arrays_equal(arrays, gko::read_raw<double, gko::int64>(iss));
+}
+
+
+TEST(CsrReader, ReadsLargeSparseComplexHermitianMtxFromFileInParallel)
+{
+    using cpx = std::complex<float>;
+    auto exec = gko::ReferenceExecutor::create();
+    auto content = generate_coordinate_mtx(
+        "%%MatrixMarket matrix coordinate complex hermitian\n", 6000, true,
+        true);
+    temporary_file file(content);
+    std::istringstream iss(content);
+
+    auto arrays =
+        gko::read_csr_arrays<cpx, gko::int32>(file.get_name(), exec, 3);
+
+    assert_csr_arrays_equal(arrays, gko::read_raw<cpx, gko::int32>(iss));
+}
+
+
+TEST(CsrReader, ReadsCsrFromUnsortedMtxFileKeepingExplicitZeros)
+{
+    using Csr = gko::matrix::Csr<double, gko::int32>;
+    auto exec = gko::ReferenceExecutor::create();
+    temporary_file file(
+        "%%MatrixMarket matrix coordinate real general\n"
+        "3 4 5\n"
+        "3 4 6.0\n"
+        "1 3 -2.5\n"
+        "3 1 4.0\n"
+        "1 1 1.0\n"
+        "2 2 0.0\n");
+
+    auto mtx = gko::read_csr<Csr>(file.get_name(), exec);
+
+    ASSERT_EQ(mtx->get_num_stored_elements(), 5);
+    ASSERT_EQ(mtx->get_const_row_ptrs()[1], 2);
+    ASSERT_EQ(mtx->get_const_col_idxs()[2], 1);
+    GKO_ASSERT_MTX_NEAR(mtx,
+                        l({{1.0, 0.0, -2.5, 0.0},
+                           {0.0, 0.0, 0.0, 0.0},
+                           {4.0, 0.0, 0.0, 6.0}}),
+                        0.0);
+}
+
+
+TEST(CsrReader, ReadsCsrArraysFromDenseMtxFile)
+{
+    auto exec = gko::ReferenceExecutor::create();
+    temporary_file file(
+        "%%MatrixMarket matrix array real general\n"
+        "2 2\n"
+        "1.0\n"
+        "0.0\n"
+        "0.0\n"
+        "3.0\n");
+
+    auto arrays = gko::read_csr_arrays<double, gko::int32>(file.get_name(),
+                                                           exec);
+
+    ASSERT_EQ(arrays.size, gko::dim<2>(2, 2));
+    ASSERT_EQ(arrays.values.get_num_elems(), 2);
+    ASSERT_EQ(arrays.row_ptrs.get_const_data()[1], 1);
+    ASSERT_EQ(arrays.col_idxs.get_const_data()[1], 1);
+    ASSERT_EQ(arrays.values.get_const_data()[1], 3.0);
+}
+
+
+TEST(CsrReader, FailsWhenSymmetricEntriesExceedTheRows)
+{
+    auto exec = gko::ReferenceExecutor::create();
+    temporary_file file(
+        "%%MatrixMarket matrix coordinate real symmetric\n"
+        "2 3 1\n"
+        "2 3 1.0\n");
+
+    ASSERT_THROW((gko::read_csr_arrays<double, gko::int32>(file.get_name(),
+                                                           exec)),
+                 gko::StreamError);
+}
+
+
 TEST(MatrixData, WritesDoubleRealMatrixToMatrixMarketArray)
 {
     // clang-format off
@@ -0,0 +1,249 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/base/parallel_assembly_data.hpp>
+
+
+#include <thread>
+#include <vector>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/matrix_assembly_data.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class ParallelAssemblyData : public ::testing::Test {
+protected:
+    using value_type = double;
+    using index_type = gko::int32;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using assembly_data = gko::parallel_assembly_data<value_type, index_type>;
+
+    ParallelAssemblyData() : exec(gko::ReferenceExecutor::create()) {}
+
+    // adds the element matrices [1 -1; -1 1] of a 1D Laplacian with
+    // num_elements elements, distributed over all threads
+    template <typename AssemblyData>
+    static void add_laplacian(AssemblyData &data, index_type num_elements)
+    {
+        std::vector<std::thread> threads;
+        const auto num_threads = data.get_num_threads();
+        for (gko::size_type tid = 0; tid < num_threads; ++tid) {
+            threads.emplace_back([&data, num_elements, num_threads, tid] {
+                for (auto el = static_cast<index_type>(tid); el < num_elements;
+                     el += num_threads) {
+                    data.add_value(tid, el, el, 1.0);
+                    data.add_value(tid, el, el + 1, -1.0);
+                    data.add_value(tid, el + 1, el, -1.0);
+                    data.add_value(tid, el + 1, el + 1, 1.0);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::unique_ptr<Csr> create_laplacian(index_type num_elements)
+    {
+        gko::matrix_assembly_data<value_type, index_type> data(
+            gko::dim<2>(num_elements + 1));
+        for (index_type el = 0; el < num_elements; ++el) {
+            data.add_value(el, el, 1.0);
+            data.add_value(el, el + 1, -1.0);
+            data.add_value(el + 1, el, -1.0);
+            data.add_value(el + 1, el + 1, 1.0);
+        }
+        auto mtx = Csr::create(exec);
+        mtx->read(data);
+        return mtx;
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+};
+
+
+TEST_F(ParallelAssemblyData, InitializesEmpty)
+{
+    assembly_data data(gko::dim<2>{3, 5}, 4);
+
+    ASSERT_EQ(data.get_size(), gko::dim<2>(3, 5));
+    ASSERT_EQ(data.get_num_threads(), 4);
+    ASSERT_EQ(data.get_num_added_values(), 0);
+    ASSERT_FALSE(data.has_pattern());
+}
+
+
+TEST_F(ParallelAssemblyData, AssemblesCsrWithDuplicates)
+{
+    assembly_data data(gko::dim<2>{3, 4}, 2);
+    data.add_value(1, 2, 3, 2.0);
+    data.add_value(0, 0, 2, 1.0);
+    data.add_value(0, 2, 0, 4.0);
+    data.add_value(1, 0, 0, 3.0);
+    data.add_value(0, 2, 3, 1.5);
+    data.add_value(1, 0, 2, -3.0);
+    data.add_value(0, 0, 0, 1.0);
+
+    auto mtx = data.assemble(exec);
+
+    ASSERT_EQ(data.get_num_added_values(), 7);
+    ASSERT_EQ(mtx->get_num_stored_elements(), 4);
+    GKO_ASSERT_MTX_NEAR(mtx,
+                        l({{4.0, 0.0, -2.0, 0.0},
+                           {0.0, 0.0, 0.0, 0.0},
+                           {4.0, 0.0, 0.0, 3.5}}),
+                        0.0);
+}
+
+
+TEST_F(ParallelAssemblyData, AssemblesWithMoreThreadsThanRows)
+{
+    assembly_data data(gko::dim<2>{2, 2}, 8);
+    data.add_value(7, 1, 0, 2.0);
+    data.add_value(3, 1, 0, 1.0);
+
+    auto mtx = data.assemble(exec);
+
+    GKO_ASSERT_MTX_NEAR(mtx, l({{0.0, 0.0}, {3.0, 0.0}}), 0.0);
+    ASSERT_EQ(mtx->get_num_stored_elements(), 1);
+}
+
+
+TEST_F(ParallelAssemblyData, AssemblesConcurrentlyAddedValues)
+{
+    assembly_data data(gko::dim<2>(1001), 4);
+
+    add_laplacian(data, 1000);
+    auto mtx = data.assemble(exec);
+
+    GKO_ASSERT_MTX_NEAR(mtx, create_laplacian(1000), 0.0);
+    ASSERT_EQ(mtx->get_num_stored_elements(), 3001);
+}
+
+
+TEST_F(ParallelAssemblyData, AssemblesIntoPrescribedPattern)
+{
+    auto pattern = create_laplacian(1000);
+    assembly_data data(pattern.get(), 3);
+
+    add_laplacian(data, 999);
+    auto mtx = data.assemble(exec);
+
+    ASSERT_TRUE(data.has_pattern());
+    GKO_ASSERT_MTX_EQ_SPARSITY(mtx, pattern);
+    // the last element was not added, so the entries only it contributes to
+    // are zero
+    ASSERT_EQ(mtx->get_const_values()[2996], -1.0);
+    ASSERT_EQ(mtx->get_const_values()[2997], 1.0);
+    ASSERT_EQ(mtx->get_const_values()[2998], 0.0);
+    ASSERT_EQ(mtx->get_const_values()[2999], 0.0);
+    ASSERT_EQ(mtx->get_const_values()[3000], 0.0);
+    ASSERT_EQ(mtx->get_const_values()[1499], -1.0);
+    ASSERT_EQ(mtx->get_const_values()[1500], 2.0);
+    ASSERT_EQ(mtx->get_const_values()[1501], -1.0);
+}
+
+
+TEST_F(ParallelAssemblyData, ReassemblesAfterClear)
+{
+    auto pattern = create_laplacian(100);
+    assembly_data data(pattern.get(), 2);
+    add_laplacian(data, 100);
+    data.assemble(exec);
+
+    data.clear();
+    add_laplacian(data, 100);
+    auto mtx = data.assemble(exec);
+
+    ASSERT_EQ(data.get_num_added_values(), 400);
+    GKO_ASSERT_MTX_NEAR(mtx, pattern, 0.0);
+}
+
+
+TEST_F(ParallelAssemblyData, AssemblesValuesIntoExistingMatrix)
+{
+    auto mtx = create_laplacian(100);
+    auto srow = mtx->get_const_srow();
+    assembly_data data(mtx.get(), 2);
+    add_laplacian(data, 100);
+    add_laplacian(data, 100);
+
+    data.assemble_values(mtx.get());
+
+    auto expected = create_laplacian(100);
+    for (gko::size_type nz = 0; nz < mtx->get_num_stored_elements(); ++nz) {
+        ASSERT_EQ(mtx->get_const_values()[nz],
+                  2.0 * expected->get_const_values()[nz]);
+    }
+    ASSERT_EQ(mtx->get_const_srow(), srow);
+}
+
+
+TEST_F(ParallelAssemblyData, ThrowsWhenAssemblingValuesWithoutPattern)
+{
+    auto mtx = create_laplacian(10);
+    assembly_data data(mtx->get_size(), 1);
+
+    ASSERT_THROW(data.assemble_values(mtx.get()), gko::NotSupported);
+}
+
+
+TEST_F(ParallelAssemblyData, ThrowsForEntryOutsideOfPattern)
+{
+    auto pattern = create_laplacian(10);
+    assembly_data data(pattern.get(), 1);
+
+    ASSERT_THROW(data.add_value(0, 0, 2, 1.0), gko::BadDimension);
+}
+
+
+TEST_F(ParallelAssemblyData, ThrowsForEntryOutsideOfMatrix)
+{
+    assembly_data data(gko::dim<2>{3, 4}, 1);
+
+    ASSERT_THROW(data.add_value(0, 3, 0, 1.0), gko::OutOfBoundsError);
+    ASSERT_THROW(data.add_value(0, 0, 4, 1.0), gko::OutOfBoundsError);
+}
+
+
+}  // namespace
@@ -221,6 +221,24 @@ TYPED_TEST(Csr, CanBeReadFromMatrixData)
 }
 
 
+TYPED_TEST(Csr, CanBeReadFromUnsortedMatrixData)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto m = Mtx::create(this->exec,
+                         std::make_shared<typename Mtx::load_balance>(2));
+
+    m->read({{2, 3},
+             {{1, 2, 0.0},
+              {0, 2, 2.0},
+              {1, 1, 5.0},
+              {0, 0, 1.0},
+              {1, 0, 0.0},
+              {0, 1, 3.0}}});
+
+    this->assert_equal_to_original_mtx(m.get());
+}
+
+
 TYPED_TEST(Csr, CanBeReadFromMatrixAssemblyData)
 {
     using Mtx = typename TestFixture::Mtx;
@@ -242,6 +260,85 @@ TYPED_TEST(Csr, CanBeReadFromMatrixAssemblyData)
 }
 
 
+TYPED_TEST(Csr, ReadsValuesKeepingPattern)
+{
+    using value_type = typename TestFixture::value_type;
+    auto srow = this->mtx->get_const_srow();
+
+    this->mtx->read_values(
+        gko::Array<value_type>{this->exec, {2.0, 6.0, 4.0, 10.0}});
+
+    auto v = this->mtx->get_const_values();
+    EXPECT_EQ(v[0], value_type{2.0});
+    EXPECT_EQ(v[1], value_type{6.0});
+    EXPECT_EQ(v[2], value_type{4.0});
+    EXPECT_EQ(v[3], value_type{10.0});
+    EXPECT_EQ(this->mtx->get_const_col_idxs()[3], 1);
+    EXPECT_EQ(this->mtx->get_const_row_ptrs()[1], 3);
+    EXPECT_EQ(this->mtx->get_const_srow(), srow);
+}
+
+
+TYPED_TEST(Csr, ReadsValuesFromMatrixData)
+{
+    using value_type = typename TestFixture::value_type;
+
+    this->mtx->read_values({{2, 3},
+                            {{0, 2, 4.0},
+                             {1, 1, 5.0},
+                             {0, 0, 1.0},
+                             {1, 2, 0.0},
+                             {1, 1, 1.0}}});
+
+    auto v = this->mtx->get_const_values();
+    EXPECT_EQ(v[0], value_type{1.0});
+    EXPECT_EQ(v[1], value_type{0.0});
+    EXPECT_EQ(v[2], value_type{4.0});
+    EXPECT_EQ(v[3], value_type{6.0});
+    EXPECT_EQ(this->mtx->get_num_stored_elements(), 4);
+}
+
+
+TYPED_TEST(Csr, ThrowsWhenReadingValueOutsideOfPattern)
+{
+    ASSERT_THROW(this->mtx->read_values({{2, 3}, {{1, 0, 1.0}}}),
+                 gko::BadDimension);
+    this->assert_equal_to_original_mtx(this->mtx.get());
+}
+
+
+TYPED_TEST(Csr, ReadsValuesThroughValueMap)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto map = this->mtx->compute_value_map(
+        gko::Array<index_type>{this->exec, {1, 0, 0, 1, 0}},
+        gko::Array<index_type>{this->exec, {1, 2, 0, 1, 2}});
+
+    this->mtx->read_values(
+        map, gko::Array<value_type>{this->exec, {1.0, 2.0, 3.0, 4.0, 5.0}});
+
+    GKO_ASSERT_ARRAY_EQ(map,
+                        gko::Array<index_type>(this->exec, {3, 2, 0, 3, 2}));
+    auto v = this->mtx->get_const_values();
+    EXPECT_EQ(v[0], value_type{3.0});
+    EXPECT_EQ(v[1], value_type{0.0});
+    EXPECT_EQ(v[2], value_type{7.0});
+    EXPECT_EQ(v[3], value_type{5.0});
+}
+
+
+TYPED_TEST(Csr, ThrowsWhenComputingValueMapOutsideOfPattern)
+{
+    using index_type = typename TestFixture::index_type;
+
+    ASSERT_THROW(this->mtx->compute_value_map(
+                     gko::Array<index_type>{this->exec, {0, 2}},
+                     gko::Array<index_type>{this->exec, {0, 0}}),
+                 gko::BadDimension);
+}
+
+
 TYPED_TEST(Csr, GeneratesCorrectMatrixData)
 {
     using value_type = typename TestFixture::value_type;
@@ -237,6 +237,28 @@ TYPED_TEST(Hybrid, CanBeReadFromMatrixDataAutomatically)
 }
 
 
+TYPED_TEST(Hybrid, CanBeReadFromMatrixDataAutomaticallyForCpu)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto m = Mtx::create(
+        this->exec, std::make_shared<typename Mtx::automatic>(this->exec));
+    m->read({{4, 4},
+             {{0, 0, 1.0},
+              {1, 0, 2.0},
+              {1, 1, 3.0},
+              {2, 1, 4.0},
+              {2, 2, 5.0},
+              {3, 0, 6.0},
+              {3, 1, 7.0},
+              {3, 2, 8.0},
+              {3, 3, 9.0}}});
+
+    // the storage-minimal partition is used for all value and index types
+    ASSERT_EQ(m->get_ell_num_stored_elements_per_row(), 2);
+    ASSERT_EQ(m->get_coo_num_stored_elements(), 2);
+}
+
+
 TYPED_TEST(Hybrid, CanBeReadFromMatrixDataByColumns2)
 {
     using Mtx = typename TestFixture::Mtx;
@@ -514,4 +536,19 @@ TYPED_TEST(Hybrid, GetCorrectAutomatic)
 }
 
 
+TYPED_TEST(Hybrid, GetCorrectAutomaticForCpu)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Mtx2 =
+        gko::matrix::Hybrid<typename TestFixture::value_type, gko::int64>;
+    using strategy = typename Mtx::automatic;
+    using strategy2 = typename Mtx2::automatic;
+
+    auto mtx = Mtx::create(this->exec, std::make_shared<strategy>(this->exec));
+    auto mtx2_stra = gko::as<strategy2>(mtx->template get_strategy<Mtx2>());
+
+    ASSERT_EQ(mtx2_stra->get_executor(), this->exec);
+}
+
+
 }  // namespace
@@ -0,0 +1,274 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/stencil.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueType>
+class Stencil : public ::testing::Test {
+protected:
+    using value_type = ValueType;
+    using Mtx = gko::matrix::Stencil<value_type>;
+
+    Stencil()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(Mtx::create(exec, gko::dim<3>{4, 3, 1},
+                          gko::matrix::stencil_shape::five_point_2d,
+                          gko::Array<value_type>{exec, {-1, -1, 4, -1, -1}}))
+    {}
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<Mtx> mtx;
+
+    void assert_equal_to_original_mtx(const Mtx *m)
+    {
+        auto o = m->get_const_offsets();
+        auto c = m->get_const_coefficients();
+        ASSERT_EQ(m->get_size(), gko::dim<2>(12, 12));
+        ASSERT_EQ(m->get_grid_size(), gko::dim<3>(4, 3, 1));
+        ASSERT_EQ(m->get_num_points(), 5);
+        ASSERT_EQ(m->get_num_stored_coefficients(), 5);
+        ASSERT_FALSE(m->has_variable_coefficients());
+        EXPECT_EQ(o[0], 0);
+        EXPECT_EQ(o[1], -1);
+        EXPECT_EQ(o[2], 0);
+        EXPECT_EQ(o[3], -1);
+        EXPECT_EQ(o[4], 0);
+        EXPECT_EQ(o[5], 0);
+        EXPECT_EQ(o[6], 0);
+        EXPECT_EQ(o[7], 0);
+        EXPECT_EQ(o[8], 0);
+        EXPECT_EQ(o[9], 1);
+        EXPECT_EQ(o[10], 0);
+        EXPECT_EQ(o[11], 0);
+        EXPECT_EQ(o[12], 0);
+        EXPECT_EQ(o[13], 1);
+        EXPECT_EQ(o[14], 0);
+        EXPECT_EQ(c[0], value_type{-1.0});
+        EXPECT_EQ(c[1], value_type{-1.0});
+        EXPECT_EQ(c[2], value_type{4.0});
+        EXPECT_EQ(c[3], value_type{-1.0});
+        EXPECT_EQ(c[4], value_type{-1.0});
+    }
+
+    void assert_empty(const Mtx *m)
+    {
+        ASSERT_EQ(m->get_size(), gko::dim<2>(0, 0));
+        ASSERT_EQ(m->get_num_points(), 0);
+        ASSERT_EQ(m->get_num_stored_coefficients(), 0);
+        ASSERT_EQ(m->get_const_offsets(), nullptr);
+        ASSERT_EQ(m->get_const_coefficients(), nullptr);
+    }
+};
+
+TYPED_TEST_SUITE(Stencil, gko::test::ValueTypes);
+
+
+TYPED_TEST(Stencil, KnowsItsSize)
+{
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(12, 12));
+    ASSERT_EQ(this->mtx->get_grid_size(), gko::dim<3>(4, 3, 1));
+}
+
+
+TYPED_TEST(Stencil, ContainsCorrectData)
+{
+    this->assert_equal_to_original_mtx(this->mtx.get());
+}
+
+
+TYPED_TEST(Stencil, CanBeEmpty)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto mtx = Mtx::create(this->exec);
+
+    this->assert_empty(mtx.get());
+}
+
+
+TYPED_TEST(Stencil, HasCorrectThreePointShape)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = Mtx::create(this->exec, gko::dim<3>{5, 1, 1},
+                           gko::matrix::stencil_shape::three_point_1d,
+                           gko::Array<value_type>{this->exec, {-1, 2, -1}});
+    auto o = mtx->get_const_offsets();
+
+    ASSERT_EQ(mtx->get_size(), gko::dim<2>(5, 5));
+    ASSERT_EQ(mtx->get_num_points(), 3);
+    EXPECT_EQ(o[0], -1);
+    EXPECT_EQ(o[3], 0);
+    EXPECT_EQ(o[6], 1);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(o[3 * i + 1], 0);
+        EXPECT_EQ(o[3 * i + 2], 0);
+    }
+}
+
+
+TYPED_TEST(Stencil, HasCorrectNumberOfPointsForShapes)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    gko::Array<value_type> coeffs9{this->exec, 9};
+    gko::Array<value_type> coeffs7{this->exec, 7};
+    gko::Array<value_type> coeffs27{this->exec, 27};
+
+    auto mtx9 = Mtx::create(this->exec, gko::dim<3>{3, 3, 1},
+                            gko::matrix::stencil_shape::nine_point_2d,
+                            coeffs9);
+    auto mtx7 = Mtx::create(this->exec, gko::dim<3>{3, 3, 3},
+                            gko::matrix::stencil_shape::seven_point_3d,
+                            coeffs7);
+    auto mtx27 = Mtx::create(this->exec, gko::dim<3>{3, 3, 3},
+                             gko::matrix::stencil_shape::twenty_seven_point_3d,
+                             coeffs27);
+
+    ASSERT_EQ(mtx9->get_num_points(), 9);
+    ASSERT_EQ(mtx7->get_num_points(), 7);
+    ASSERT_EQ(mtx27->get_num_points(), 27);
+    ASSERT_EQ(mtx27->get_size(), gko::dim<2>(27, 27));
+}
+
+
+TYPED_TEST(Stencil, CanBeCreatedWithVariableCoefficients)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+
+    auto mtx = Mtx::create(this->exec, gko::dim<3>{2, 1, 1},
+                           gko::matrix::stencil_shape::three_point_1d,
+                           gko::Array<value_type>{this->exec, 6});
+
+    ASSERT_TRUE(mtx->has_variable_coefficients());
+    ASSERT_EQ(mtx->get_num_stored_coefficients(), 6);
+}
+
+
+TYPED_TEST(Stencil, ThrowsOnWrongNumberOfCoefficients)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+
+    ASSERT_THROW(Mtx::create(this->exec, gko::dim<3>{2, 1, 1},
+                             gko::matrix::stencil_shape::three_point_1d,
+                             gko::Array<value_type>{this->exec, 4}),
+                 gko::ValueMismatch);
+}
+
+
+TYPED_TEST(Stencil, ThrowsOnDuplicateOffsets)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+
+    ASSERT_THROW(Mtx::create(this->exec, gko::dim<3>{4, 1, 1},
+                             gko::Array<gko::int32>{this->exec,
+                                                    {-1, 0, 0, 0, 0, 0, -1, 0,
+                                                     0}},
+                             gko::Array<value_type>{this->exec, {1, 2, 3}}),
+                 gko::ValueMismatch);
+}
+
+
+TYPED_TEST(Stencil, CanBeCreatedFromExistingData)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    gko::int32 offsets[] = {0, 0, 0, 1, 0, 0};
+    value_type coeffs[] = {1.0, 2.0};
+
+    auto mtx = Mtx::create(this->exec, gko::dim<3>{3, 1, 1},
+                           gko::Array<gko::int32>::view(this->exec, 6, offsets),
+                           gko::Array<value_type>::view(this->exec, 2, coeffs));
+
+    ASSERT_EQ(mtx->get_const_offsets(), offsets);
+    ASSERT_EQ(mtx->get_const_coefficients(), coeffs);
+    ASSERT_EQ(mtx->get_num_points(), 2);
+}
+
+
+TYPED_TEST(Stencil, CanBeCopied)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(this->mtx.get());
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->mtx->get_coefficients()[1] = 5.0;
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(Stencil, CanBeMoved)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(std::move(this->mtx));
+
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(Stencil, CanBeCloned)
+{
+    using Mtx = typename TestFixture::Mtx;
+
+    auto clone = this->mtx->clone();
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->mtx->get_coefficients()[1] = 5.0;
+    this->assert_equal_to_original_mtx(dynamic_cast<Mtx *>(clone.get()));
+}
+
+
+TYPED_TEST(Stencil, CanBeCleared)
+{
+    this->mtx->clear();
+
+    this->assert_empty(this->mtx.get());
+}
+
+
+}  // namespace
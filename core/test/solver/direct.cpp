@@ -0,0 +1,158 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/direct.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class Direct : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Solver = gko::solver::Direct<value_type, index_type>;
+
+    Direct()
+        : exec(gko::ReferenceExecutor::create()),
+          direct_factory(Solver::build().on(exec))
+    {}
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<typename Solver::Factory> direct_factory;
+};
+
+TYPED_TEST_SUITE(Direct, gko::test::ValueIndexTypes);
+
+
+TYPED_TEST(Direct, DirectFactoryKnowsItsExecutor)
+{
+    ASSERT_EQ(this->direct_factory->get_executor(), this->exec);
+}
+
+
+TYPED_TEST(Direct, DirectFactoryHasDefaultParameters)
+{
+    auto &params = this->direct_factory->get_parameters();
+
+    ASSERT_EQ(params.factorization, gko::solver::factorization_type::lu);
+    ASSERT_EQ(params.reordering, nullptr);
+    ASSERT_FALSE(params.skip_reordering);
+    ASSERT_EQ(params.max_supernode_size, 64);
+}
+
+
+TYPED_TEST(Direct, CanSetParameters)
+{
+    using Solver = typename TestFixture::Solver;
+    std::shared_ptr<typename Solver::reordering_type::Factory> reordering =
+        Solver::reordering_type::build().on(this->exec);
+
+    auto factory =
+        Solver::build()
+            .with_factorization(gko::solver::factorization_type::cholesky)
+            .with_reordering(reordering)
+            .with_skip_reordering(true)
+            .with_max_supernode_size(8u)
+            .on(this->exec);
+
+    auto &params = factory->get_parameters();
+    ASSERT_EQ(params.factorization, gko::solver::factorization_type::cholesky);
+    ASSERT_EQ(params.reordering, reordering);
+    ASSERT_TRUE(params.skip_reordering);
+    ASSERT_EQ(params.max_supernode_size, 8);
+}
+
+
+TYPED_TEST(Direct, ThrowsOnRectangularMatrixInFactory)
+{
+    using Mtx = gko::matrix::Dense<typename TestFixture::value_type>;
+    std::shared_ptr<Mtx> rectangular_matrix =
+        Mtx::create(this->exec, gko::dim<2>{1, 2});
+
+    ASSERT_THROW(this->direct_factory->generate(rectangular_matrix),
+                 gko::DimensionMismatch);
+}
+
+
+TYPED_TEST(Direct, CanBeGeneratedFromEmptyMatrix)
+{
+    using Mtx = gko::matrix::Csr<typename TestFixture::value_type,
+                                 typename TestFixture::index_type>;
+    std::shared_ptr<Mtx> empty_matrix = Mtx::create(this->exec);
+
+    auto solver = this->direct_factory->generate(empty_matrix);
+
+    ASSERT_EQ(solver->get_size(), gko::dim<2>{});
+    ASSERT_EQ(solver->get_num_supernodes(), 0);
+    ASSERT_EQ(solver->get_num_factor_elements(), 0);
+}
+
+
+TYPED_TEST(Direct, CanBeCopied)
+{
+    using Mtx = gko::matrix::Csr<typename TestFixture::value_type,
+                                 typename TestFixture::index_type>;
+    using Solver = typename TestFixture::Solver;
+    std::shared_ptr<Mtx> mtx = gko::initialize<Mtx>(
+        {{2.0, -1.0, 0.0}, {-1.0, 2.0, -1.0}, {0.0, -1.0, 2.0}}, this->exec);
+    auto solver = this->direct_factory->generate(mtx);
+    auto copy = Solver::build().on(this->exec)->generate(
+        gko::share(Mtx::create(this->exec)));
+
+    copy->copy_from(solver.get());
+
+    ASSERT_EQ(copy->get_size(), gko::dim<2>(3, 3));
+    ASSERT_EQ(copy->get_num_supernodes(), solver->get_num_supernodes());
+    ASSERT_EQ(copy->get_num_factor_elements(),
+              solver->get_num_factor_elements());
+}
+
+
+}  // namespace
@@ -0,0 +1,263 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/multigrid.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+#include <ginkgo/core/multigrid/amgx_pgm.hpp>
+#include <ginkgo/core/preconditioner/jacobi.hpp>
+#include <ginkgo/core/solver/ir.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename T>
+class Multigrid : public ::testing::Test {
+protected:
+    using value_type = T;
+    using Csr = gko::matrix::Csr<value_type, gko::int32>;
+    using Solver = gko::solver::Multigrid<value_type>;
+    using AmgxPgm = gko::multigrid::AmgxPgm<value_type, gko::int32>;
+    using Smoother = gko::solver::Ir<value_type>;
+    using Jacobi = gko::preconditioner::Jacobi<value_type, gko::int32>;
+
+    Multigrid()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(gko::share(Csr::create(exec))),
+          smoother_factory(
+              Smoother::build()
+                  .with_solver(Jacobi::build().with_max_block_size(1u).on(exec))
+                  .with_relaxation_factor(value_type{0.9})
+                  .with_criteria(
+                      gko::stop::Iteration::build().with_max_iters(1u).on(
+                          exec))
+                  .on(exec)),
+          mg_factory(
+              Solver::build()
+                  .with_mg_level(AmgxPgm::build().with_deterministic(true).on(
+                      exec))
+                  .with_pre_smoother(smoother_factory)
+                  .with_criteria(
+                      gko::stop::Iteration::build().with_max_iters(1u).on(
+                          exec))
+                  .on(exec))
+    {
+        // 1D Laplacian
+        gko::matrix_data<value_type, gko::int32> data{gko::dim<2>{32}};
+        for (int i = 0; i < 32; ++i) {
+            if (i > 0) {
+                data.nonzeros.emplace_back(i, i - 1, -1.0);
+            }
+            data.nonzeros.emplace_back(i, i, 2.0);
+            if (i < 31) {
+                data.nonzeros.emplace_back(i, i + 1, -1.0);
+            }
+        }
+        mtx->read(data);
+    }
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::shared_ptr<Csr> mtx;
+    std::shared_ptr<typename Smoother::Factory> smoother_factory;
+    std::unique_ptr<typename Solver::Factory> mg_factory;
+};
+
+TYPED_TEST_SUITE(Multigrid, gko::test::ValueTypes);
+
+
+TYPED_TEST(Multigrid, MultigridFactoryKnowsItsExecutor)
+{
+    ASSERT_EQ(this->mg_factory->get_executor(), this->exec);
+}
+
+
+TYPED_TEST(Multigrid, GeneratesHierarchy)
+{
+    auto solver = this->mg_factory->generate(this->mtx);
+
+    auto levels = solver->get_mg_level_list();
+    ASSERT_GT(levels.size(), 1);
+    ASSERT_EQ(levels[0]->get_fine_op(), this->mtx);
+    for (gko::size_type i = 1; i < levels.size(); ++i) {
+        ASSERT_EQ(levels[i]->get_fine_op(), levels[i - 1]->get_coarse_op());
+        ASSERT_LT(levels[i]->get_fine_op()->get_size()[0],
+                  levels[i - 1]->get_fine_op()->get_size()[0]);
+    }
+    ASSERT_LE(levels.back()->get_coarse_op()->get_size()[0], 2);
+    ASSERT_EQ(solver->get_coarsest_solver()->get_size(),
+              levels.back()->get_coarse_op()->get_size());
+}
+
+
+TYPED_TEST(Multigrid, RespectsMaxLevels)
+{
+    using Solver = typename TestFixture::Solver;
+    using AmgxPgm = typename TestFixture::AmgxPgm;
+    auto solver =
+        Solver::build()
+            .with_mg_level(AmgxPgm::build().on(this->exec))
+            .with_max_levels(1u)
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(1u).on(this->exec))
+            .on(this->exec)
+            ->generate(this->mtx);
+
+    ASSERT_EQ(solver->get_mg_level_list().size(), 1);
+}
+
+
+TYPED_TEST(Multigrid, RespectsMinCoarseRows)
+{
+    using Solver = typename TestFixture::Solver;
+    using AmgxPgm = typename TestFixture::AmgxPgm;
+    auto solver =
+        Solver::build()
+            .with_mg_level(AmgxPgm::build().on(this->exec))
+            .with_min_coarse_rows(32u)
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(1u).on(this->exec))
+            .on(this->exec)
+            ->generate(this->mtx);
+
+    ASSERT_EQ(solver->get_mg_level_list().size(), 0);
+    ASSERT_EQ(solver->get_coarsest_solver()->get_size(), gko::dim<2>(32, 32));
+}
+
+
+TYPED_TEST(Multigrid, UsesPreSmootherAsPostSmoother)
+{
+    auto solver = this->mg_factory->generate(this->mtx);
+
+    auto pre = solver->get_pre_smoother_list();
+    auto post = solver->get_post_smoother_list();
+    ASSERT_EQ(pre.size(), solver->get_mg_level_list().size());
+    ASSERT_EQ(post.size(), pre.size());
+    for (gko::size_type i = 0; i < pre.size(); ++i) {
+        ASSERT_NE(pre[i], nullptr);
+        ASSERT_EQ(pre[i], post[i]);
+        ASSERT_EQ(pre[i]->get_size(),
+                  solver->get_mg_level_list()[i]->get_fine_op()->get_size());
+    }
+}
+
+
+TYPED_TEST(Multigrid, CanSkipPostSmoothing)
+{
+    using Solver = typename TestFixture::Solver;
+    using AmgxPgm = typename TestFixture::AmgxPgm;
+    auto solver =
+        Solver::build()
+            .with_mg_level(AmgxPgm::build().on(this->exec))
+            .with_pre_smoother(this->smoother_factory)
+            .with_post_uses_pre(false)
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(1u).on(this->exec))
+            .on(this->exec)
+            ->generate(this->mtx);
+
+    for (auto post : solver->get_post_smoother_list()) {
+        ASSERT_EQ(post, nullptr);
+    }
+}
+
+
+TYPED_TEST(Multigrid, UsesIdentityAsDefaultCoarsestSolver)
+{
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->mg_factory->generate(this->mtx);
+
+    ASSERT_NE(dynamic_cast<const gko::matrix::Identity<value_type> *>(
+                  solver->get_coarsest_solver().get()),
+              nullptr);
+}
+
+
+TYPED_TEST(Multigrid, ApplyUsesInitialGuessUnlessZeroGuess)
+{
+    using Solver = typename TestFixture::Solver;
+    using AmgxPgm = typename TestFixture::AmgxPgm;
+    auto solver = this->mg_factory->generate(this->mtx);
+    auto zero_guess_solver =
+        Solver::build()
+            .with_mg_level(AmgxPgm::build().on(this->exec))
+            .with_zero_initial_guess(true)
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(1u).on(this->exec))
+            .on(this->exec)
+            ->generate(this->mtx);
+
+    ASSERT_TRUE(solver->apply_uses_initial_guess());
+    ASSERT_FALSE(zero_guess_solver->apply_uses_initial_guess());
+}
+
+
+TYPED_TEST(Multigrid, CanBeCloned)
+{
+    using Solver = typename TestFixture::Solver;
+    auto solver = this->mg_factory->generate(this->mtx);
+
+    auto clone = gko::as<Solver>(solver->clone());
+
+    ASSERT_EQ(clone->get_system_matrix(), this->mtx);
+    ASSERT_EQ(clone->get_mg_level_list().size(),
+              solver->get_mg_level_list().size());
+}
+
+
+TYPED_TEST(Multigrid, ThrowsForLevelFactoryWithoutMultigridLevel)
+{
+    using Solver = typename TestFixture::Solver;
+    using Jacobi = typename TestFixture::Jacobi;
+    auto factory =
+        Solver::build()
+            .with_mg_level(Jacobi::build().on(this->exec))
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(1u).on(this->exec))
+            .on(this->exec);
+
+    ASSERT_THROW(factory->generate(this->mtx), gko::NotSupported);
+}
+
+
+}  // namespace
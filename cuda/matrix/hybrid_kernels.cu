@@ -69,6 +69,34 @@ constexpr int warps_in_block = 4;
 #include "common/matrix/hybrid_kernels.hpp.inc"
 
 
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const CudaExecutor> exec,
+          const matrix::Hybrid<ValueType, IndexType> *a,
+          const matrix::Dense<ValueType> *b, matrix::Dense<ValueType> *c)
+{
+    ell::spmv(exec, a->get_ell(), b, c);
+    coo::spmv2(exec, a->get_coo(), b, c);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_HYBRID_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const CudaExecutor> exec,
+                   const matrix::Dense<ValueType> *alpha,
+                   const matrix::Hybrid<ValueType, IndexType> *a,
+                   const matrix::Dense<ValueType> *b,
+                   const matrix::Dense<ValueType> *beta,
+                   matrix::Dense<ValueType> *c)
+{
+    ell::advanced_spmv(exec, alpha, a->get_ell(), b, beta, c);
+    coo::advanced_spmv2(exec, alpha, a->get_coo(), b, c);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_HYBRID_ADVANCED_SPMV_KERNEL);
+
+
 template <typename ValueType, typename IndexType>
 void convert_to_dense(std::shared_ptr<const CudaExecutor> exec,
                       const matrix::Hybrid<ValueType, IndexType> *source,
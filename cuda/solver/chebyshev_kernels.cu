@@ -0,0 +1,103 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/solver/chebyshev_kernels.hpp"
+
+
+#include <ginkgo/core/base/math.hpp>
+
+
+#include "cuda/base/math.hpp"
+#include "cuda/base/types.hpp"
+#include "cuda/components/thread_ids.cuh"
+
+
+namespace gko {
+namespace kernels {
+namespace cuda {
+/**
+ * @brief The Chebyshev solver namespace.
+ *
+ * @ingroup chebyshev
+ */
+namespace chebyshev {
+
+
+constexpr int default_block_size = 512;
+
+
+#include "common/solver/chebyshev_kernels.hpp.inc"
+
+
+template <typename ValueType>
+void initialize(std::shared_ptr<const CudaExecutor> exec,
+                const matrix::Dense<ValueType> *b, matrix::Dense<ValueType> *r,
+                matrix::Dense<ValueType> *d,
+                Array<stopping_status> *stop_status)
+{
+    const dim3 block_size(default_block_size, 1, 1);
+    const dim3 grid_size(
+        ceildiv(b->get_size()[0] * b->get_stride(), block_size.x), 1, 1);
+
+    initialize_kernel<<<grid_size, block_size, 0, 0>>>(
+        b->get_size()[0], b->get_size()[1], b->get_stride(),
+        as_cuda_type(b->get_const_values()), as_cuda_type(r->get_values()),
+        as_cuda_type(d->get_values()), as_cuda_type(stop_status->get_data()));
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CHEBYSHEV_INITIALIZE_KERNEL);
+
+
+template <typename ValueType>
+void step(std::shared_ptr<const CudaExecutor> exec,
+          matrix::Dense<ValueType> *x, matrix::Dense<ValueType> *d,
+          const matrix::Dense<ValueType> *z, ValueType d_coeff,
+          ValueType z_coeff, const Array<stopping_status> *stop_status)
+{
+    const dim3 block_size(default_block_size, 1, 1);
+    const dim3 grid_size(
+        ceildiv(d->get_size()[0] * d->get_stride(), block_size.x), 1, 1);
+
+    step_kernel<<<grid_size, block_size, 0, 0>>>(
+        d->get_size()[0], d->get_size()[1], d->get_stride(), x->get_stride(),
+        as_cuda_type(x->get_values()), as_cuda_type(d->get_values()),
+        as_cuda_type(z->get_const_values()), as_cuda_type(d_coeff),
+        as_cuda_type(z_coeff), as_cuda_type(stop_status->get_const_data()));
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CHEBYSHEV_STEP_KERNEL);
+
+
+}  // namespace chebyshev
+}  // namespace cuda
+}  // namespace kernels
+}  // namespace gko
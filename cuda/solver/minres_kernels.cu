@@ -0,0 +1,185 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/solver/minres_kernels.hpp"
+
+
+#include <ginkgo/core/base/math.hpp>
+
+
+#include "cuda/base/math.hpp"
+#include "cuda/base/types.hpp"
+#include "cuda/components/thread_ids.cuh"
+
+
+namespace gko {
+namespace kernels {
+namespace cuda {
+/**
+ * @brief The MINRES solver namespace.
+ *
+ * @ingroup minres
+ */
+namespace minres {
+
+
+constexpr int default_block_size = 512;
+
+
+#include "common/solver/minres_kernels.hpp.inc"
+
+
+template <typename ValueType>
+void initialize_1(std::shared_ptr<const CudaExecutor> exec,
+                  const matrix::Dense<ValueType> *b,
+                  matrix::Dense<ValueType> *r, matrix::Dense<ValueType> *r_prev,
+                  matrix::Dense<ValueType> *w, matrix::Dense<ValueType> *w_prev,
+                  matrix::Dense<ValueType> *prev_beta,
+                  matrix::Dense<ValueType> *delta_bar,
+                  matrix::Dense<ValueType> *eps, matrix::Dense<ValueType> *cos,
+                  matrix::Dense<ValueType> *sin,
+                  Array<stopping_status> *stop_status)
+{
+    const dim3 block_size(default_block_size, 1, 1);
+    const dim3 grid_size(
+        ceildiv(b->get_size()[0] * b->get_stride(), block_size.x), 1, 1);
+
+    initialize_1_kernel<<<grid_size, block_size, 0, 0>>>(
+        b->get_size()[0], b->get_size()[1], b->get_stride(),
+        as_cuda_type(b->get_const_values()), as_cuda_type(r->get_values()),
+        as_cuda_type(r_prev->get_values()), as_cuda_type(w->get_values()),
+        as_cuda_type(w_prev->get_values()),
+        as_cuda_type(prev_beta->get_values()),
+        as_cuda_type(delta_bar->get_values()), as_cuda_type(eps->get_values()),
+        as_cuda_type(cos->get_values()), as_cuda_type(sin->get_values()),
+        as_cuda_type(stop_status->get_data()));
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_INITIALIZE_1_KERNEL);
+
+
+template <typename ValueType>
+void initialize_2(std::shared_ptr<const CudaExecutor> exec,
+                  matrix::Dense<ValueType> *beta,
+                  matrix::Dense<ValueType> *phi_bar,
+                  matrix::Dense<remove_complex<ValueType>> *residual_norm)
+{
+    const dim3 block_size(default_block_size, 1, 1);
+    const dim3 grid_size(ceildiv(beta->get_size()[1], block_size.x), 1, 1);
+
+    initialize_2_kernel<<<grid_size, block_size, 0, 0>>>(
+        beta->get_size()[1], as_cuda_type(beta->get_values()),
+        as_cuda_type(phi_bar->get_values()),
+        as_cuda_type(residual_norm->get_values()));
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_INITIALIZE_2_KERNEL);
+
+
+template <typename ValueType>
+void step_1(std::shared_ptr<const CudaExecutor> exec,
+            matrix::Dense<ValueType> *q, const matrix::Dense<ValueType> *z,
+            const matrix::Dense<ValueType> *r, matrix::Dense<ValueType> *r_prev,
+            const matrix::Dense<ValueType> *alpha,
+            const matrix::Dense<ValueType> *beta,
+            const matrix::Dense<ValueType> *prev_beta,
+            const Array<stopping_status> *stop_status)
+{
+    const dim3 block_size(default_block_size, 1, 1);
+    const dim3 grid_size(
+        ceildiv(q->get_size()[0] * q->get_stride(), block_size.x), 1, 1);
+
+    step_1_kernel<<<grid_size, block_size, 0, 0>>>(
+        q->get_size()[0], q->get_size()[1], q->get_stride(),
+        as_cuda_type(q->get_values()), as_cuda_type(z->get_const_values()),
+        as_cuda_type(r->get_const_values()), as_cuda_type(r_prev->get_values()),
+        as_cuda_type(alpha->get_const_values()),
+        as_cuda_type(beta->get_const_values()),
+        as_cuda_type(prev_beta->get_const_values()),
+        as_cuda_type(stop_status->get_const_data()));
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_STEP_1_KERNEL);
+
+
+template <typename ValueType>
+void step_2(std::shared_ptr<const CudaExecutor> exec,
+            matrix::Dense<ValueType> *x, const matrix::Dense<ValueType> *v,
+            const matrix::Dense<ValueType> *w, matrix::Dense<ValueType> *w_prev,
+            const matrix::Dense<ValueType> *alpha,
+            const matrix::Dense<ValueType> *beta,
+            matrix::Dense<ValueType> *next_beta,
+            matrix::Dense<ValueType> *delta_bar, matrix::Dense<ValueType> *eps,
+            matrix::Dense<ValueType> *cos, matrix::Dense<ValueType> *sin,
+            matrix::Dense<ValueType> *phi_bar,
+            matrix::Dense<remove_complex<ValueType>> *residual_norm,
+            const Array<stopping_status> *stop_status)
+{
+    const dim3 block_size(default_block_size, 1, 1);
+    const dim3 grid_size(
+        ceildiv(v->get_size()[0] * v->get_stride(), block_size.x), 1, 1);
+    const dim3 scalar_grid_size(ceildiv(v->get_size()[1], block_size.x), 1,
+                                1);
+
+    // the vectors are updated before the coefficients they depend on
+    step_2_kernel<<<grid_size, block_size, 0, 0>>>(
+        v->get_size()[0], v->get_size()[1], v->get_stride(), x->get_stride(),
+        as_cuda_type(x->get_values()), as_cuda_type(v->get_const_values()),
+        as_cuda_type(w->get_const_values()), as_cuda_type(w_prev->get_values()),
+        as_cuda_type(alpha->get_const_values()),
+        as_cuda_type(beta->get_const_values()),
+        as_cuda_type(next_beta->get_const_values()),
+        as_cuda_type(delta_bar->get_const_values()),
+        as_cuda_type(eps->get_const_values()),
+        as_cuda_type(cos->get_const_values()),
+        as_cuda_type(sin->get_const_values()),
+        as_cuda_type(phi_bar->get_const_values()),
+        as_cuda_type(stop_status->get_const_data()));
+
+    step_2_update_kernel<<<scalar_grid_size, block_size, 0, 0>>>(
+        v->get_size()[1], as_cuda_type(alpha->get_const_values()),
+        as_cuda_type(beta->get_const_values()),
+        as_cuda_type(next_beta->get_values()),
+        as_cuda_type(delta_bar->get_values()), as_cuda_type(eps->get_values()),
+        as_cuda_type(cos->get_values()), as_cuda_type(sin->get_values()),
+        as_cuda_type(phi_bar->get_values()),
+        as_cuda_type(residual_norm->get_values()),
+        as_cuda_type(stop_status->get_const_data()));
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_STEP_2_KERNEL);
+
+
+}  // namespace minres
+}  // namespace cuda
+}  // namespace kernels
+}  // namespace gko
@@ -0,0 +1,108 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/solver/minres_kernels.hpp"
+
+
+#include <CL/sycl.hpp>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace dpcpp {
+/**
+ * @brief The MINRES solver namespace.
+ *
+ * @ingroup minres
+ */
+namespace minres {
+
+
+template <typename ValueType>
+void initialize_1(std::shared_ptr<const DpcppExecutor> exec,
+                  const matrix::Dense<ValueType> *b,
+                  matrix::Dense<ValueType> *r, matrix::Dense<ValueType> *r_prev,
+                  matrix::Dense<ValueType> *w, matrix::Dense<ValueType> *w_prev,
+                  matrix::Dense<ValueType> *prev_beta,
+                  matrix::Dense<ValueType> *delta_bar,
+                  matrix::Dense<ValueType> *eps, matrix::Dense<ValueType> *cos,
+                  matrix::Dense<ValueType> *sin,
+                  Array<stopping_status> *stop_status) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_INITIALIZE_1_KERNEL);
+
+
+template <typename ValueType>
+void initialize_2(std::shared_ptr<const DpcppExecutor> exec,
+                  matrix::Dense<ValueType> *beta,
+                  matrix::Dense<ValueType> *phi_bar,
+                  matrix::Dense<remove_complex<ValueType>> *residual_norm)
+    GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_INITIALIZE_2_KERNEL);
+
+
+template <typename ValueType>
+void step_1(std::shared_ptr<const DpcppExecutor> exec,
+            matrix::Dense<ValueType> *q, const matrix::Dense<ValueType> *z,
+            const matrix::Dense<ValueType> *r, matrix::Dense<ValueType> *r_prev,
+            const matrix::Dense<ValueType> *alpha,
+            const matrix::Dense<ValueType> *beta,
+            const matrix::Dense<ValueType> *prev_beta,
+            const Array<stopping_status> *stop_status) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_STEP_1_KERNEL);
+
+
+template <typename ValueType>
+void step_2(std::shared_ptr<const DpcppExecutor> exec,
+            matrix::Dense<ValueType> *x, const matrix::Dense<ValueType> *v,
+            const matrix::Dense<ValueType> *w, matrix::Dense<ValueType> *w_prev,
+            const matrix::Dense<ValueType> *alpha,
+            const matrix::Dense<ValueType> *beta,
+            matrix::Dense<ValueType> *next_beta,
+            matrix::Dense<ValueType> *delta_bar, matrix::Dense<ValueType> *eps,
+            matrix::Dense<ValueType> *cos, matrix::Dense<ValueType> *sin,
+            matrix::Dense<ValueType> *phi_bar,
+            matrix::Dense<remove_complex<ValueType>> *residual_norm,
+            const Array<stopping_status> *stop_status) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_STEP_2_KERNEL);
+
+
+}  // namespace minres
+}  // namespace dpcpp
+}  // namespace kernels
+}  // namespace gko
@@ -35,8 +35,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <istream>
+#include <memory>
+#include <string>
 
 
+#include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/matrix_data.hpp>
 
 
@@ -54,6 +57,9 @@ namespace gko {
  * @return A matrix_data structure containing the matrix. The nonzero elements
  *         are sorted in lexicographic order of their (row, colum) indexes.
  *
+ * @note Data in Ginkgo's binary format (see layout_type::binary) is detected
+ *       automatically and read without parsing.
+ *
  * @note This is an advanced routine that will return the raw matrix data
  *       structure. Consider using gko::read instead.
  */
@@ -61,6 +67,38 @@ template <typename ValueType = default_precision, typename IndexType = int32>
 matrix_data<ValueType, IndexType> read_raw(std::istream &is);
 
 
+/**
+ * Reads a matrix stored in matrix market format from a file.
+ *
+ * Instead of extracting the entries one token at a time from a stream, the
+ * file is mapped into memory (or read in one piece where memory mapping is
+ * not available), the coordinate entries are split at line boundaries and
+ * parsed by several threads, which also expand symmetric, skew-symmetric and
+ * hermitian storage. The entries are then brought into row-major order by a
+ * parallel counting sort. Dense (array) files are read as in the stream-based
+ * overload, files in Ginkgo's binary format (see layout_type::binary) are
+ * detected automatically and read without parsing.
+ *
+ * @tparam ValueType  type of matrix values
+ * @tparam IndexType  type of matrix indexes
+ *
+ * @param filename  path of the file from which to read the data
+ * @param num_threads  number of threads used for parsing, 0 uses one thread per
+ *                     hardware thread (small files are always read by fewer
+ *                     threads)
+ *
+ * @return A matrix_data structure containing the matrix. The nonzero elements
+ *         are sorted in lexicographic order of their (row, colum) indexes.
+ *
+ * @note This is an advanced routine that will return the raw matrix data
+ *       structure. Consider using gko::read instead, which forwards to this
+ *       overload when given a file name instead of a stream.
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+matrix_data<ValueType, IndexType> read_raw(const std::string &filename,
+                                           size_type num_threads = 0);
+
+
 /**
  * Specifies the layout type when writing data in matrix market format.
  */
@@ -72,10 +110,120 @@ enum class layout_type {
     /**
      * The matrix should be written as a sparse matrix in coordinate format.
      */
-    coordinate
+    coordinate,
+    /**
+     * The matrix should be written in Ginkgo's binary format, which stores
+     * the arrays of the matrix in CSR format. It consists of a 64 byte header
+     *
+     * | bytes | content                                                     |
+     * |-------|-------------------------------------------------------------|
+     * | 0-7   | the characters `GKOMTXBN`                                   |
+     * | 8-11  | the byte order mark 0x01020304 (as uint32)                  |
+     * | 12-15 | the format version, currently 1                             |
+     * | 16-19 | the storage layout, currently always 0 (CSR)                |
+     * | 20-23 | the value type: 0 float, 1 double, 2 complex<float>,        |
+     * |       | 3 complex<double>                                           |
+     * | 24-27 | the size of an index in bytes (4 or 8)                      |
+     * | 28-31 | reserved                                                    |
+     * | 32-55 | number of rows, columns and stored elements (each uint64)   |
+     * | 56-63 | reserved                                                    |
+     *
+     * followed by the row pointers, column indexes and values, each of them
+     * starting at an offset that is a multiple of 64 bytes, so the arrays can
+     * be used directly from a memory-mapped file (see gko::read_csr).
+     * All data is stored in the native byte order of the writing system.
+     *
+     * @note The output stream needs to be opened in binary mode.
+     */
+    binary
+};
+
+
+/**
+ * The arrays of a sparse matrix in CSR format, which can be used to create a
+ * matrix::Csr without copying them.
+ *
+ * @tparam ValueType  type of matrix values
+ * @tparam IndexType  type of matrix indexes
+ */
+template <typename ValueType, typename IndexType>
+struct csr_arrays {
+    /**
+     * Size of the matrix.
+     */
+    dim<2> size;
+
+    /**
+     * The values of the stored elements.
+     */
+    Array<ValueType> values;
+
+    /**
+     * The column indexes of the stored elements.
+     */
+    Array<IndexType> col_idxs;
+
+    /**
+     * The row pointers of the matrix.
+     */
+    Array<IndexType> row_ptrs;
 };
 
 
+/**
+ * Loads the CSR arrays of a matrix stored in Ginkgo's binary format (see
+ * layout_type::binary) from a file.
+ *
+ * If exec is a host executor and the value and index types match those in
+ * the file, the file is mapped into memory and the arrays are created on top
+ * of the mapping without copying any data. The mapping is private, so
+ * modifying the arrays never changes the file, and it is released when the
+ * last of the arrays is destroyed. Otherwise, the data is converted to the
+ * requested types and copied to exec.
+ *
+ * @tparam ValueType  type of matrix values
+ * @tparam IndexType  type of matrix indexes
+ *
+ * @param filename  path of the file from which to read the data
+ * @param exec  executor on which the arrays should be located
+ *
+ * @return the arrays of the matrix
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+csr_arrays<ValueType, IndexType> read_binary_arrays(
+    const std::string &filename, std::shared_ptr<const Executor> exec);
+
+
+/**
+ * Reads the CSR arrays of a matrix stored in matrix market format or in
+ * Ginkgo's binary format from a file.
+ *
+ * Binary files are loaded by gko::read_binary_arrays. Coordinate files are
+ * mapped into memory and read in parallel in two passes: the first one only
+ * parses the coordinates to count the entries of each row, the second one
+ * parses the entries again and scatters them directly into the final arrays,
+ * whose rows are then sorted by column. In contrast to reading a matrix_data
+ * structure first, the entries are never stored in between, which keeps the
+ * peak memory consumption at about the size of the resulting matrix.
+ * Explicitly stored zeros are kept. Dense (array) files are read through a
+ * matrix_data structure.
+ *
+ * @tparam ValueType  type of matrix values
+ * @tparam IndexType  type of matrix indexes
+ *
+ * @param filename  path of the file from which to read the data
+ * @param exec  executor on which the arrays should be located
+ * @param num_threads  number of threads used for parsing, 0 uses one thread per
+ *                     hardware thread
+ *
+ * @return the arrays of the matrix, with the columns of each row sorted
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+csr_arrays<ValueType, IndexType> read_csr_arrays(
+    const std::string &filename, std::shared_ptr<const Executor> exec,
+    size_type num_threads = 0);
+
+
 /**
  * Writes a matrix_data structure to a stream in matrix market format.
  *
@@ -84,7 +232,8 @@ enum class layout_type {
  *
  * @param os  output stream where the data is to be written
  * @param data  the matrix data to write
- * @param layout  the layout used in the output
+ * @param layout  the layout used in the output, or layout_type::binary to
+ *                write Ginkgo's binary format instead
  *
  * @note This is an advanced routine that writes the raw matrix data structure.
  *       If you are trying to write an existing matrix, consider using
@@ -104,7 +253,8 @@ void write_raw(std::ostream &os, const matrix_data<ValueType, IndexType> &data,
  * @tparam MatrixArgs  additional argument types passed to MatrixType
  *                     constructor
  *
- * @param is  input stream from which to read the data
+ * @param is  input stream from which to read the data, or the name of a file,
+ *            which is then read in parallel by the file-based gko::read_raw
  * @param args  additional arguments passed to MatrixType constructor
  *
  * @return A MatrixType LinOp filled with data from filename
@@ -119,6 +269,37 @@ inline std::unique_ptr<MatrixType> read(StreamType &&is, MatrixArgs &&... args)
 }
 
 
+/**
+ * Reads a matrix stored in matrix market format or in Ginkgo's binary format
+ * (see layout_type::binary) from a file directly into CSR arrays (see
+ * gko::read_csr_arrays), without copying the data of binary files if
+ * possible.
+ *
+ * @tparam MatrixType  a LinOp type that can be created from CSR arrays, i.e.
+ *                     matrix::Csr
+ * @tparam MatrixArgs  additional argument types passed to MatrixType
+ *                     constructor after the arrays
+ *
+ * @param filename  path of the file from which to read the data
+ * @param exec  executor on which the matrix should be created
+ * @param args  additional arguments passed to MatrixType constructor
+ *
+ * @return A MatrixType LinOp filled with data from filename
+ */
+template <typename MatrixType, typename... MatrixArgs>
+inline std::unique_ptr<MatrixType> read_csr(
+    const std::string &filename, std::shared_ptr<const Executor> exec,
+    MatrixArgs &&... args)
+{
+    auto arrays = read_csr_arrays<typename MatrixType::value_type,
+                                  typename MatrixType::index_type>(filename,
+                                                                   exec);
+    return MatrixType::create(
+        exec, arrays.size, std::move(arrays.values), std::move(arrays.col_idxs),
+        std::move(arrays.row_ptrs), std::forward<MatrixArgs>(args)...);
+}
+
+
 /**
  * Reads a matrix stored in matrix market format from an input stream.
  *
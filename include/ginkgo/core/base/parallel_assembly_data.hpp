@@ -0,0 +1,255 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_BASE_PARALLEL_ASSEMBLY_DATA_HPP_
+#define GKO_PUBLIC_CORE_BASE_PARALLEL_ASSEMBLY_DATA_HPP_
+
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+#include <ginkgo/core/base/dim.hpp>
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+namespace gko {
+
+
+/**
+ * This structure is used to assemble a sparse matrix from many contributions
+ * that are added concurrently by several threads, as it is the case for
+ * finite element assembly.
+ *
+ * In contrast to matrix_assembly_data, which stores the entries in a hash map,
+ * each thread appends its contributions to its own buffer, so adding a value
+ * neither allocates a node nor requires synchronization. Duplicate entries are
+ * only combined when the matrix is assembled: the buffers are sorted and
+ * reduced in parallel, and the rows of the matrix are then merged from all
+ * buffers in parallel directly into the arrays of a matrix::Csr.
+ *
+ * If the sparsity pattern of the matrix is known in advance, it can be
+ * prescribed when creating the structure. Each contribution is then mapped to
+ * its position in the pattern when it is added, and assembling the matrix only
+ * accumulates the values into the existing pattern.
+ *
+ * A thread may only add values through its own thread ID, but different
+ * threads can add values at the same time. Assembling the matrix, clearing
+ * the values and all other operations must not run concurrently with adding
+ * values.
+ *
+ * @tparam ValueType  type of matrix values stored in the structure
+ * @tparam IndexType  type of matrix indexes stored in the structure
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class parallel_assembly_data {
+public:
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using matrix_type = matrix::Csr<ValueType, IndexType>;
+
+    /**
+     * Creates an empty structure for a matrix with an arbitrary sparsity
+     * pattern.
+     *
+     * @param size  the dimensions of the matrix
+     * @param num_threads  the number of threads adding values, which is also
+     *                     used for assembling the matrix. 0 uses one thread per
+     *                     hardware thread
+     */
+    explicit parallel_assembly_data(dim<2> size, size_type num_threads = 0);
+
+    /**
+     * Creates an empty structure for a matrix with a prescribed sparsity
+     * pattern.
+     *
+     * @param pattern  the matrix whose sparsity pattern (but not its values)
+     *                 is used for the assembled matrix. Its columns must be
+     *                 sorted within each row.
+     * @param num_threads  the number of threads adding values, which is also
+     *                     used for assembling the matrix. 0 uses one thread per
+     *                     hardware thread
+     */
+    explicit parallel_assembly_data(const matrix_type *pattern,
+                                    size_type num_threads = 0);
+
+    /**
+     * Reserves space for a number of values to be added by a thread.
+     *
+     * @param thread_id  the ID of the thread, in [0, get_num_threads())
+     * @param num_values  the number of values the thread will add
+     */
+    void reserve(size_type thread_id, size_type num_values);
+
+    /**
+     * Adds a value to the matrix entry at (row, col).
+     *
+     * Values added to the same entry, by the same or different threads, are
+     * summed up when the matrix is assembled.
+     *
+     * @param thread_id  the ID of the calling thread, in [0, get_num_threads())
+     * @param row  the row where the value should be added
+     * @param col  the column where the value should be added
+     * @param val  the value to be added to (row, col)
+     *
+     * @throw OutOfBoundsError  if (row, col) is outside of the matrix
+     * @throw BadDimension  if a sparsity pattern was prescribed and does not
+     *                      contain (row, col)
+     */
+    void add_value(size_type thread_id, index_type row, index_type col,
+                   value_type val)
+    {
+        if (static_cast<size_type>(row) >= size_[0]) {
+            throw OutOfBoundsError(__FILE__, __LINE__, row, size_[0]);
+        }
+        if (static_cast<size_type>(col) >= size_[1]) {
+            throw OutOfBoundsError(__FILE__, __LINE__, col, size_[1]);
+        }
+        auto &buffer = buffers_[thread_id];
+        if (has_pattern()) {
+            buffer.pattern_values.emplace_back(find_position(row, col), val);
+        } else {
+            buffer.values.push_back({row, col, val});
+        }
+    }
+
+    /**
+     * Removes all values that have been added, but keeps the prescribed
+     * sparsity pattern and the memory of the buffers for the next assembly.
+     */
+    void clear();
+
+    /**
+     * Assembles the matrix from all values that have been added.
+     *
+     * Entries that were added several times are summed up, the columns of
+     * each row are sorted. If a sparsity pattern was prescribed, the matrix
+     * has exactly this pattern, with zeros for entries no value was added to.
+     * The added values are kept, so more values can be added and the matrix
+     * assembled again.
+     *
+     * @param exec  the executor on which the matrix should be created
+     * @param strategy  the strategy of the matrix
+     *
+     * @return the assembled matrix
+     */
+    std::unique_ptr<matrix_type> assemble(
+        std::shared_ptr<const Executor> exec,
+        std::shared_ptr<typename matrix_type::strategy_type> strategy =
+            std::make_shared<typename matrix_type::sparselib>());
+
+    /**
+     * Assembles the values added to a prescribed sparsity pattern into an
+     * existing matrix with this pattern, replacing its values (see
+     * matrix::Csr::read_values).
+     *
+     * @param mtx  the matrix whose values should be replaced
+     *
+     * @throw NotSupported  if no sparsity pattern was prescribed
+     */
+    void assemble_values(matrix_type *mtx);
+
+    /** @return the dimensions of the matrix being assembled */
+    dim<2> get_size() const noexcept { return size_; }
+
+    /** @return the number of threads that can add values */
+    size_type get_num_threads() const noexcept { return buffers_.size(); }
+
+    /** @return true iff a sparsity pattern was prescribed */
+    bool has_pattern() const noexcept { return !pattern_row_ptrs_.empty(); }
+
+    /**
+     * @return the number of values that have been added (counting values added
+     *         to the same entry separately)
+     */
+    size_type get_num_added_values() const noexcept;
+
+private:
+    struct entry {
+        index_type row;
+        index_type column;
+        value_type value;
+    };
+
+    /**
+     * The values added by a single thread. The buffer is padded to avoid
+     * false sharing between threads: as its alignment cannot be controlled,
+     * it spans two cache lines.
+     */
+    struct thread_buffer {
+        std::vector<entry> values;
+        std::vector<std::pair<index_type, value_type>> pattern_values;
+        char padding[128 - sizeof(std::vector<entry>) -
+                     sizeof(std::vector<std::pair<index_type, value_type>>)];
+    };
+
+    index_type find_position(index_type row, index_type col) const
+    {
+        const auto begin = pattern_col_idxs_.data() + pattern_row_ptrs_[row];
+        const auto end = pattern_col_idxs_.data() + pattern_row_ptrs_[row + 1];
+        const auto it = std::lower_bound(begin, end, col);
+        if (it == end || *it != col) {
+            throw_not_in_pattern(row, col);
+        }
+        return static_cast<index_type>(it - pattern_col_idxs_.data());
+    }
+
+    [[noreturn]] void throw_not_in_pattern(index_type row,
+                                           index_type col) const;
+
+    /**
+     * Sorts the buffers and sums up their values into the arrays of a CSR
+     * matrix on the host.
+     */
+    void assemble_arrays(Array<ValueType> &values, Array<IndexType> &col_idxs,
+                         Array<IndexType> &row_ptrs);
+
+    /**
+     * Combines the values added to the same position of the sparsity pattern.
+     */
+    void assemble_pattern_values(Array<ValueType> &values);
+
+    dim<2> size_;
+    std::vector<thread_buffer> buffers_;
+    std::vector<index_type> pattern_row_ptrs_;
+    std::vector<index_type> pattern_col_idxs_;
+};
+
+
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_BASE_PARALLEL_ASSEMBLY_DATA_HPP_
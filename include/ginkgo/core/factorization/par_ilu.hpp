@@ -122,6 +122,28 @@ public:
     static std::unique_ptr<Composition<ValueType>> create(Args &&... args) =
         delete;
 
+    /**
+     * Recomputes the factors for a new system matrix with the same sparsity
+     * pattern as the one they were generated from, e.g. the matrix of the next
+     * time step or Newton iteration.
+     *
+     * The sparsity pattern of the factors is reused, so the symbolic
+     * factorization and the allocation of the factors are skipped. The
+     * asynchronous sweeps start from the current factors instead of the
+     * entries of the system matrix, so fewer iterations are usually needed
+     * for matrices whose values change only slightly.
+     *
+     * @param system_matrix  the new system matrix, which must be convertible
+     *                       to a Csr matrix and have the same sparsity
+     *                       pattern as the previous one
+     *
+     * @note The factors are updated in place, so all objects sharing them
+     *       (see get_l_factor and get_u_factor) observe the new values. Objects
+     *       generated from the factors, like triangular solvers, may need to
+     *       be generated again.
+     */
+    void refactorize(std::shared_ptr<const LinOp> system_matrix);
+
     GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
     {
         /**
@@ -124,6 +124,33 @@ public:
     static std::unique_ptr<Composition<ValueType>> create(Args &&... args) =
         delete;
 
+    /**
+     * Recomputes the factors for a new system matrix with the same sparsity
+     * pattern as the one they were generated from, e.g. the matrix of the next
+     * time step or Newton iteration.
+     *
+     * The iterations start from the current factors instead of the
+     * incomplete factorization with the sparsity pattern of the system matrix,
+     * so fewer iterations are usually needed for matrices whose values change
+     * only slightly. If the pattern of the factors is kept, candidate
+     * selection and threshold filtering are skipped entirely and only the
+     * values are updated by asynchronous sweeps, reusing the factors' storage.
+     *
+     * @param system_matrix  the new system matrix, which must be convertible
+     *                       to a Csr matrix and have the same sparsity
+     *                       pattern as the previous one
+     * @param keep_pattern  whether the sparsity pattern of the factors should
+     *                      be frozen
+     *
+     * @note If the pattern is kept, the factors are updated in place, so all
+     *       objects sharing them (see get_l_factor and get_u_factor)
+     *       observe the new values, otherwise they are replaced by new
+     *       objects. Objects generated from the factors, like triangular
+     *       solvers, may need to be generated again.
+     */
+    void refactorize(std::shared_ptr<const LinOp> system_matrix,
+                     bool keep_pattern = true);
+
     GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
     {
         /**
@@ -61,6 +61,9 @@ class Sellp;
 template <typename ValueType, typename IndexType>
 class SparsityCsr;
 
+template <typename ValueType>
+class Stencil;
+
 template <typename ValueType, typename IndexType>
 class Csr;
 
@@ -141,6 +144,7 @@ class Csr : public EnableLinOp<Csr<ValueType, IndexType>>,
     friend class Hybrid<ValueType, IndexType>;
     friend class Sellp<ValueType, IndexType>;
     friend class SparsityCsr<ValueType, IndexType>;
+    friend class Stencil<ValueType>;
     friend class CsrBuilder<ValueType, IndexType>;
     friend class Csr<to_complex<ValueType>, IndexType>;
 
@@ -732,6 +736,75 @@ public:
      */
     bool is_sorted_by_column_index() const;
 
+    /**
+     * Replaces the values of the matrix, keeping its sparsity pattern.
+     *
+     * As the data of the strategy (like the starting rows of the load_balance
+     * strategy) only depends on the sparsity pattern, it is kept as well,
+     * which makes this much cheaper than reading the whole matrix again.
+     *
+     * @param values  the new values in the order of the stored elements
+     *
+     * @note LinOps generated from this matrix, like preconditioners, solvers
+     *       or its transpose, keep using the old values until they are
+     *       generated again.
+     */
+    void read_values(const Array<value_type> &values);
+
+    /**
+     * Replaces the values of the matrix by the entries of a matrix_data
+     * structure, keeping its sparsity pattern (see
+     * read_values(const Array<value_type> &)).
+     *
+     * Stored elements without an entry in data are set to zero, values of
+     * duplicate entries are summed up. The matrix needs to be sorted by column
+     * index.
+     *
+     * @param data  the new entries, which need to be part of the sparsity
+     *              pattern unless their value is zero
+     *
+     * @throw BadDimension  if data contains a nonzero entry outside of the
+     *                      sparsity pattern
+     */
+    void read_values(const mat_data &data);
+
+    /**
+     * Computes the positions of a list of entries in the sparsity pattern.
+     *
+     * The result can be used to replace the values of the matrix repeatedly
+     * by read_values(const Array<index_type> &, const Array<value_type> &)
+     * without searching the sparsity pattern again, e.g. for the element
+     * contributions of a finite element assembly. The matrix needs to be
+     * sorted by column index.
+     *
+     * @param row_idxs  the row indexes of the entries
+     * @param col_idxs  the column indexes of the entries
+     *
+     * @return the position of each entry among the stored elements, located
+     *         on the host
+     *
+     * @throw BadDimension  if an entry is not part of the sparsity pattern
+     */
+    Array<index_type> compute_value_map(
+        const Array<index_type> &row_idxs,
+        const Array<index_type> &col_idxs) const;
+
+    /**
+     * Replaces the values of the matrix by a list of values scattered into
+     * the stored elements, keeping its sparsity pattern (see
+     * read_values(const Array<value_type> &)).
+     *
+     * Each value is added to the stored element given by the value map, so
+     * the values of duplicate entries are summed up. Stored elements no value
+     * is mapped to are set to zero.
+     *
+     * @param value_map  the position of each value among the stored elements,
+     *                   as computed by compute_value_map
+     * @param values  the values to scatter into the matrix
+     */
+    void read_values(const Array<index_type> &value_map,
+                     const Array<value_type> &values);
+
     /**
      * Returns the values of the matrix.
      *
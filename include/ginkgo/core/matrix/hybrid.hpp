@@ -360,22 +360,54 @@ public:
     /**
      * automatic is a strategy_type which decides the number of stored elements
      * per row of the ell part automatically.
+     *
+     * By default, the partition is tuned for GPUs, where the COO part is
+     * processed with atomic operations and the ELL part should contain most
+     * nonzeros. If it is created for a CPU executor, the partition is tuned for
+     * the fused CPU SpMV, which traverses the ELL and COO part of each row
+     * together without any atomic operations. Its runtime is determined by the
+     * amount of memory read, so the minimal_storage_limit partition is used.
      */
     class automatic : public strategy_type {
     public:
         /**
-         * Creates an automatic strategy.
+         * Creates an automatic strategy tuned for GPUs.
          */
-        automatic() : strategy_(imbalance_bounded_limit(1.0 / 3.0, 0.001)) {}
+        automatic()
+            : strategy_(std::make_shared<imbalance_bounded_limit>(1.0 / 3.0,
+                                                                  0.001))
+        {}
+
+        /**
+         * Creates an automatic strategy tuned for the given executor.
+         *
+         * @param exec  the executor the matrix will be used on. If it is
+         *              nullptr, the strategy is tuned for GPUs.
+         */
+        explicit automatic(std::shared_ptr<const Executor> exec) : automatic()
+        {
+            exec_ = std::move(exec);
+            if (std::dynamic_pointer_cast<const OmpExecutor>(exec_)) {
+                strategy_ = std::make_shared<minimal_storage_limit>();
+            }
+        }
 
         size_type compute_ell_num_stored_elements_per_row(
             Array<size_type> *row_nnz) const override
         {
-            return strategy_.compute_ell_num_stored_elements_per_row(row_nnz);
+            return strategy_->compute_ell_num_stored_elements_per_row(row_nnz);
         }
 
+        /**
+         * Get the executor the strategy is tuned for
+         *
+         * @return the executor, or nullptr if the strategy is tuned for GPUs
+         */
+        std::shared_ptr<const Executor> get_executor() const { return exec_; }
+
     private:
-        imbalance_bounded_limit strategy_;
+        std::shared_ptr<const Executor> exec_;
+        std::shared_ptr<strategy_type> strategy_;
     };
 
     friend class Hybrid<next_precision<ValueType>, IndexType>;
@@ -756,8 +788,9 @@ Hybrid<ValueType, IndexType>::get_strategy() const
         "The given `HybType` type must be of type `matrix::Hybrid`!");
 
     std::shared_ptr<typename HybType::strategy_type> strategy;
-    if (std::dynamic_pointer_cast<automatic>(strategy_)) {
-        strategy = std::make_shared<typename HybType::automatic>();
+    if (auto temp = std::dynamic_pointer_cast<automatic>(strategy_)) {
+        strategy = std::make_shared<typename HybType::automatic>(
+            temp->get_executor());
     } else if (auto temp = std::dynamic_pointer_cast<minimal_storage_limit>(
                    strategy_)) {
         // minimal_storage_limit is related to ValueType and IndexType size.
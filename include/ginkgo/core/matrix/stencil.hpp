@@ -0,0 +1,323 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_MATRIX_STENCIL_HPP_
+#define GKO_PUBLIC_CORE_MATRIX_STENCIL_HPP_
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+
+
+namespace gko {
+namespace matrix {
+
+
+template <typename ValueType, typename IndexType>
+class Csr;
+
+template <typename ValueType>
+class Dense;
+
+template <typename ValueType>
+class Diagonal;
+
+
+/**
+ * The predefined stencil shapes supported by the Stencil matrix.
+ *
+ * The points of each shape are ordered lexicographically by their
+ * (z, y, x)-offset, i.e. in the same order as the column indices of the
+ * corresponding row of the assembled matrix. For example, the points of
+ * `five_point_2d` are ordered as (bottom, left, center, right, top).
+ */
+enum class stencil_shape {
+    /** {-1, 0, 1} in x-direction */
+    three_point_1d,
+    /** center and its four direct neighbors in the x-y-plane */
+    five_point_2d,
+    /** center and all eight neighbors in the x-y-plane */
+    nine_point_2d,
+    /** center and its six direct neighbors */
+    seven_point_3d,
+    /** center and all 26 neighbors */
+    twenty_seven_point_3d
+};
+
+
+/**
+ * Stencil is a matrix-free representation of a discretization stencil on a
+ * regular 1D, 2D or 3D grid.
+ *
+ * The grid has `grid_size[0] x grid_size[1] x grid_size[2]` nodes, which are
+ * numbered with x as the fastest running index, i.e. the node (x, y, z) is
+ * the row `x + grid_size[0] * (y + grid_size[1] * z)` of the operator.
+ * 1D and 2D grids use an extent of 1 in the unused dimensions.
+ *
+ * The stencil consists of `num_points` points, each of which is described by
+ * an (x, y, z)-offset relative to the center node. Neighbors outside of the
+ * grid are ignored, which corresponds to homogeneous Dirichlet boundary
+ * conditions.
+ *
+ * The coefficients can either be constant, in which case one value is stored
+ * per stencil point, or variable, in which case `num_points` arrays of
+ * `num_rows` values each are stored back to back, i.e. the coefficient of
+ * point `p` in row `row` is stored at `p * num_rows + row`.
+ *
+ * Compared to an assembled Csr matrix, no index information needs to be
+ * loaded during the application, and the access pattern to the input vector
+ * is known a priori, which enables cache blocking and vectorization.
+ *
+ * The diagonal can be extracted without assembling the matrix, which is used
+ * by scalar Jacobi (`max_block_size == 1`). Block Jacobi and all other
+ * preconditioners that require a Csr matrix convert the Stencil to Csr during
+ * their generation, i.e. they assemble the matrix explicitly.
+ *
+ * @note The Stencil format is currently only implemented for the reference
+ *       and OpenMP executors. Applying, converting or extracting the diagonal
+ *       of a Stencil on a CUDA, HIP or DPC++ executor throws NotImplemented.
+ *
+ * @tparam ValueType  precision of matrix elements
+ *
+ * @ingroup stencil
+ * @ingroup mat_formats
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision>
+class Stencil : public EnableLinOp<Stencil<ValueType>>,
+                public EnableCreateMethod<Stencil<ValueType>>,
+                public ConvertibleTo<Csr<ValueType, int32>>,
+                public ConvertibleTo<Csr<ValueType, int64>>,
+                public DiagonalExtractable<ValueType>,
+                public WritableToMatrixData<ValueType, int32>,
+                public WritableToMatrixData<ValueType, int64> {
+    friend class EnablePolymorphicObject<Stencil, LinOp>;
+    friend class EnableCreateMethod<Stencil>;
+
+public:
+    using EnableLinOp<Stencil>::convert_to;
+    using EnableLinOp<Stencil>::move_to;
+
+    using value_type = ValueType;
+    using index_type = int64;
+    using mat_data = gko::matrix_data<ValueType, int64>;
+    using mat_data32 = gko::matrix_data<ValueType, int32>;
+
+    void convert_to(Csr<ValueType, int32> *result) const override;
+
+    void move_to(Csr<ValueType, int32> *result) override;
+
+    void convert_to(Csr<ValueType, int64> *result) const override;
+
+    void move_to(Csr<ValueType, int64> *result) override;
+
+    std::unique_ptr<Diagonal<ValueType>> extract_diagonal() const override;
+
+    void write(mat_data &data) const override;
+
+    void write(mat_data32 &data) const override;
+
+    /**
+     * Returns the number of grid nodes in each dimension.
+     *
+     * @return the grid size
+     */
+    const dim<3> &get_grid_size() const noexcept { return grid_size_; }
+
+    /**
+     * Returns the number of points of the stencil.
+     *
+     * @return the number of stencil points
+     */
+    size_type get_num_points() const noexcept
+    {
+        return offsets_.get_num_elems() / 3;
+    }
+
+    /**
+     * Returns true if the coefficients vary from row to row.
+     *
+     * @return true if the coefficients vary from row to row
+     */
+    bool has_variable_coefficients() const noexcept
+    {
+        return coefficients_.get_num_elems() > this->get_num_points();
+    }
+
+    /**
+     * Returns a pointer to the array of point offsets, stored as consecutive
+     * (x, y, z)-triplets.
+     *
+     * @return the pointer to the array of point offsets
+     */
+    const int32 *get_const_offsets() const noexcept
+    {
+        return offsets_.get_const_data();
+    }
+
+    /**
+     * Returns a pointer to the array of coefficients of the stencil.
+     *
+     * @return the pointer to the array of coefficients
+     */
+    value_type *get_coefficients() noexcept
+    {
+        return coefficients_.get_data();
+    }
+
+    /**
+     * @copydoc get_coefficients()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const value_type *get_const_coefficients() const noexcept
+    {
+        return coefficients_.get_const_data();
+    }
+
+    /**
+     * Returns the number of elements explicitly stored in the coefficient
+     * array.
+     *
+     * @return the number of elements explicitly stored in the coefficient
+     *         array
+     */
+    size_type get_num_stored_coefficients() const noexcept
+    {
+        return coefficients_.get_num_elems();
+    }
+
+protected:
+    /**
+     * Creates an empty Stencil matrix.
+     *
+     * @param exec  Executor associated to the matrix
+     */
+    explicit Stencil(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<Stencil>(exec),
+          offsets_(exec),
+          coefficients_(exec)
+    {}
+
+    /**
+     * Creates a Stencil matrix with one of the predefined shapes.
+     *
+     * @tparam CoefficientArray  type of array of coefficients
+     *
+     * @param exec  Executor associated to the matrix
+     * @param grid_size  number of grid nodes in each dimension
+     * @param shape  the shape of the stencil
+     * @param coefficients  the constant or variable stencil coefficients
+     */
+    template <typename CoefficientArray>
+    Stencil(std::shared_ptr<const Executor> exec, const dim<3> &grid_size,
+            stencil_shape shape, CoefficientArray &&coefficients)
+        : Stencil(exec, grid_size, make_shape_offsets(exec, shape),
+                  std::forward<CoefficientArray>(coefficients))
+    {}
+
+    /**
+     * Creates a Stencil matrix from already allocated (and initialized)
+     * offset and coefficient arrays.
+     *
+     * @tparam OffsetArray  type of array of offsets
+     * @tparam CoefficientArray  type of array of coefficients
+     *
+     * @param exec  Executor associated to the matrix
+     * @param grid_size  number of grid nodes in each dimension
+     * @param offsets  the (x, y, z)-offsets of all stencil points, which
+     *                 need to be distinct
+     * @param coefficients  the constant or variable stencil coefficients
+     *
+     * @note If one of the arrays is not an rvalue, not an array of the correct
+     *       type, or is on the wrong executor, an internal copy will be
+     *       created, and the original array data will not be used in the
+     *       matrix.
+     */
+    template <typename OffsetArray, typename CoefficientArray>
+    Stencil(std::shared_ptr<const Executor> exec, const dim<3> &grid_size,
+            OffsetArray &&offsets, CoefficientArray &&coefficients)
+        : EnableLinOp<Stencil>(
+              exec, dim<2>{grid_size[0] * grid_size[1] * grid_size[2]}),
+          grid_size_{grid_size},
+          offsets_{exec, std::forward<OffsetArray>(offsets)},
+          coefficients_{exec, std::forward<CoefficientArray>(coefficients)}
+    {
+        GKO_ASSERT_EQ(offsets_.get_num_elems() % 3, 0);
+        GKO_ASSERT_EQ(count_distinct_points(offsets_), this->get_num_points());
+        if (coefficients_.get_num_elems() != this->get_num_points()) {
+            GKO_ASSERT_EQ(coefficients_.get_num_elems(),
+                          this->get_num_points() * this->get_size()[0]);
+        }
+    }
+
+    /**
+     * Returns the offsets of the predefined stencil shape.
+     *
+     * @param exec  Executor on which the offsets are stored
+     * @param shape  the shape of the stencil
+     *
+     * @return the offsets of all stencil points of the shape
+     */
+    static Array<int32> make_shape_offsets(
+        std::shared_ptr<const Executor> exec, stencil_shape shape);
+
+    /**
+     * Returns the number of distinct offsets in an array of stencil offsets.
+     * Each point of a stencil needs to have a distinct offset, otherwise the
+     * assembled matrix would contain duplicate entries.
+     *
+     * @param offsets  the (x, y, z)-offsets of all stencil points
+     *
+     * @return the number of distinct (x, y, z)-offsets
+     */
+    static size_type count_distinct_points(const Array<int32> &offsets);
+
+    void apply_impl(const LinOp *b, LinOp *x) const override;
+
+    void apply_impl(const LinOp *alpha, const LinOp *b, const LinOp *beta,
+                    LinOp *x) const override;
+
+private:
+    dim<3> grid_size_;
+    Array<int32> offsets_;
+    Array<value_type> coefficients_;
+};
+
+
+}  // namespace matrix
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_MATRIX_STENCIL_HPP_
@@ -293,6 +293,30 @@ public:
 
     std::unique_ptr<LinOp> conj_transpose() const override;
 
+    /**
+     * Regenerates the preconditioner from a new system matrix with the same
+     * block-diagonal structure.
+     *
+     * The block pointers found (or given) when the preconditioner was generated
+     * are reused, so block detection is skipped, and the blocks are inverted
+     * directly into the existing storage without reallocating it. For the
+     * adaptive variant, the storage precisions chosen for the blocks can be
+     * kept as well, which skips the precision detection.
+     *
+     * @param system_matrix  the new system matrix, which needs to be of the
+     *                       same size as the preconditioner (it is sorted
+     *                       as in generation, unless `skip_sorting` is set)
+     * @param keep_precisions  if `true`, the blocks are stored in the same
+     *                         precisions as before, otherwise the precisions
+     *                         are chosen again as requested by the
+     *                         `storage_optimization` parameter. Only relevant
+     *                         for the adaptive variant.
+     *
+     * @note The condition numbers of the blocks are recomputed in both cases.
+     */
+    void regenerate(std::shared_ptr<const LinOp> system_matrix,
+                    bool keep_precisions = true);
+
     GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
     {
         /**
@@ -500,7 +524,8 @@ protected:
         : EnableLinOp<Jacobi>(exec),
           num_blocks_{},
           blocks_(exec),
-          conditioning_(exec)
+          conditioning_(exec),
+          precision_requests_(exec)
     {
         parameters_.block_pointers.set_executor(exec);
         parameters_.storage_optimization.block_wise.set_executor(exec);
@@ -524,7 +549,8 @@ protected:
           blocks_(factory->get_executor(),
                   storage_scheme_.compute_storage_space(
                       parameters_.block_pointers.get_num_elems() - 1)),
-          conditioning_(factory->get_executor())
+          conditioning_(factory->get_executor()),
+          precision_requests_(factory->get_executor())
     {
         parameters_.block_pointers.set_executor(this->get_executor());
         parameters_.storage_optimization.block_wise.set_executor(
@@ -604,6 +630,7 @@ private:
     size_type num_blocks_;
     Array<value_type> blocks_;
     Array<remove_complex<value_type>> conditioning_;
+    Array<precision_reduction> precision_requests_;
 };
 
 
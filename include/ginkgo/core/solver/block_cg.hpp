@@ -0,0 +1,230 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_SOLVER_BLOCK_CG_HPP_
+#define GKO_PUBLIC_CORE_SOLVER_BLOCK_CG_HPP_
+
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/criterion.hpp>
+
+
+namespace gko {
+namespace solver {
+
+
+/**
+ * The block conjugate gradient method (Block CG) solves symmetric
+ * (hermitian) positive definite systems with several right-hand sides at
+ * once. In contrast to Cg, which runs an independent recurrence for every
+ * column of the right-hand side, Block CG searches for the solution in the
+ * block Krylov space spanned by all residuals, so every right-hand side
+ * benefits from the search directions of the others. For `s` right-hand sides
+ * and a system of size `n`, the method terminates after at most `n / s`
+ * iterations in exact arithmetic, and it usually needs considerably fewer
+ * iterations (and thus sparse matrix-vector products) than Cg.
+ *
+ * The search directions `P` are kept as a block with orthonormal columns,
+ * which results in the breakdown-free variant of the method:
+ *
+ * ```
+ * R = B - A X
+ * P = orth(M R)
+ * while not converged:
+ *     Q = A P
+ *     Delta = P^H Q
+ *     X = X + P Delta^-1 P^H R
+ *     R = R - Q Delta^-1 P^H R
+ *     Z = M R
+ *     P = orth(Z - P Delta^-1 Q^H Z)
+ * ```
+ *
+ * `orth` computes an orthonormal basis of the block by a Cholesky QR
+ * factorization with symmetric pivoting, which is rank-revealing: columns
+ * that are linearly dependent on the others up to the relative
+ * `deflation_tolerance` are dropped from the block. This happens when some
+ * of the right-hand sides are (nearly) linearly dependent or when parts of
+ * the solution have converged, and it prevents the breakdown of the
+ * original method by O'Leary, which needs to invert the (then singular) block
+ * inner products. All block operations are matrix-matrix products of Dense
+ * matrices, the small `s x s` systems are solved on the host.
+ *
+ * The stopping criterion is evaluated for every column of the residual, the
+ * iteration stops once all columns have converged.
+ *
+ * @tparam ValueType  precision of matrix elements
+ *
+ * @ingroup solvers
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision>
+class BlockCg : public EnableLinOp<BlockCg<ValueType>>,
+                public Preconditionable {
+    friend class EnableLinOp<BlockCg>;
+    friend class EnablePolymorphicObject<BlockCg, LinOp>;
+
+public:
+    using value_type = ValueType;
+
+    /**
+     * Gets the system operator (matrix) of the linear system.
+     *
+     * @return the system operator (matrix)
+     */
+    std::shared_ptr<const LinOp> get_system_matrix() const
+    {
+        return system_matrix_;
+    }
+
+    /**
+     * Return true as iterative solvers use the data in x as an initial guess.
+     *
+     * @return true as iterative solvers use the data in x as an initial guess.
+     */
+    bool apply_uses_initial_guess() const override { return true; }
+
+    /**
+     * Gets the stopping criterion factory of the solver.
+     *
+     * @return the stopping criterion factory
+     */
+    std::shared_ptr<const stop::CriterionFactory> get_stop_criterion_factory()
+        const
+    {
+        return stop_criterion_factory_;
+    }
+
+    /**
+     * Sets the stopping criterion of the solver.
+     *
+     * @param other  the new stopping criterion factory
+     */
+    void set_stop_criterion_factory(
+        std::shared_ptr<const stop::CriterionFactory> other)
+    {
+        stop_criterion_factory_ = std::move(other);
+    }
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * Criterion factories.
+         */
+        std::vector<std::shared_ptr<const stop::CriterionFactory>>
+            GKO_FACTORY_PARAMETER_VECTOR(criteria, nullptr);
+
+        /**
+         * Preconditioner factory.
+         */
+        std::shared_ptr<const LinOpFactory> GKO_FACTORY_PARAMETER_SCALAR(
+            preconditioner, nullptr);
+
+        /**
+         * Already generated preconditioner. If one is provided, the factory
+         * `preconditioner` will be ignored.
+         */
+        std::shared_ptr<const LinOp> GKO_FACTORY_PARAMETER_SCALAR(
+            generated_preconditioner, nullptr);
+
+        /**
+         * Relative tolerance below which a column of the block of search
+         * directions is considered linearly dependent on the others and
+         * removed. The norm of the column, after orthogonalizing it against
+         * the previously chosen columns, is compared to the largest column
+         * norm in the block.
+         */
+        remove_complex<ValueType> GKO_FACTORY_PARAMETER_SCALAR(
+            deflation_tolerance,
+            std::sqrt(
+                std::numeric_limits<remove_complex<ValueType>>::epsilon()));
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(BlockCg, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    void apply_impl(const LinOp *b, LinOp *x) const override;
+
+    void apply_dense_impl(const matrix::Dense<ValueType> *b,
+                          matrix::Dense<ValueType> *x) const;
+
+    void apply_impl(const LinOp *alpha, const LinOp *b, const LinOp *beta,
+                    LinOp *x) const override;
+
+    explicit BlockCg(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<BlockCg>(std::move(exec))
+    {}
+
+    explicit BlockCg(const Factory *factory,
+                     std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<BlockCg>(factory->get_executor(),
+                               gko::transpose(system_matrix->get_size())),
+          parameters_{factory->get_parameters()},
+          system_matrix_{std::move(system_matrix)}
+    {
+        GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix_);
+        if (parameters_.generated_preconditioner) {
+            GKO_ASSERT_EQUAL_DIMENSIONS(parameters_.generated_preconditioner,
+                                        this);
+            set_preconditioner(parameters_.generated_preconditioner);
+        } else if (parameters_.preconditioner) {
+            set_preconditioner(
+                parameters_.preconditioner->generate(system_matrix_));
+        } else {
+            set_preconditioner(matrix::Identity<ValueType>::create(
+                this->get_executor(), this->get_size()));
+        }
+        stop_criterion_factory_ =
+            stop::combine(std::move(parameters_.criteria));
+    }
+
+private:
+    std::shared_ptr<const LinOp> system_matrix_{};
+    std::shared_ptr<const stop::CriterionFactory> stop_criterion_factory_{};
+};
+
+
+}  // namespace solver
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_SOLVER_BLOCK_CG_HPP_
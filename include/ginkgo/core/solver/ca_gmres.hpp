@@ -0,0 +1,275 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_SOLVER_CA_GMRES_HPP_
+#define GKO_PUBLIC_CORE_SOLVER_CA_GMRES_HPP_
+
+
+#include <algorithm>
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/criterion.hpp>
+
+
+namespace gko {
+namespace solver {
+
+
+namespace ca_gmres {
+
+
+/**
+ * Describes the polynomial basis used to generate the `step_size` Krylov
+ * vectors of a block.
+ *
+ * - monomial: v_{k+1} = A v_k / sigma, with a scaling factor sigma that
+ *             estimates the norm of A. It quickly becomes ill-conditioned,
+ *             which limits the usable step size to about 5.
+ * - newton: v_{k+1} = (A - theta_k I) v_k / sigma, where the shifts theta_k
+ *           are Ritz values of the first restart cycle (which uses the
+ *           monomial basis) in Leja ordering. It allows larger step sizes.
+ *           For real value types, complex conjugate pairs of shifts are
+ *           applied in real arithmetic.
+ */
+enum class basis { monomial, newton };
+
+
+}  // namespace ca_gmres
+
+
+/**
+ * CA-GMRES, the communication-avoiding (or s-step) generalized minimal
+ * residual method, is a variant of restarted GMRES for nonsymmetric linear
+ * systems that reduces the number of global reductions (and thus of
+ * synchronization points).
+ *
+ * Gmres orthogonalizes each new Krylov vector against all previous ones by
+ * modified Gram-Schmidt, which needs one reduction per basis vector, i.e.
+ * O(k^2) reductions per restart cycle of length k. CA-GMRES instead generates
+ * `step_size` (s) vectors at once from the last basis vector by a sequence of
+ * (preconditioned) sparse matrix-vector products without any inner products
+ * (the matrix powers kernel), using the monomial or the Newton basis (see
+ * ca_gmres::basis). The block of s vectors is then orthogonalized against the
+ * previous basis and internally by block classical Gram-Schmidt with a
+ * Cholesky QR factorization, applied twice for stability (BCGS-PIP2). Each
+ * pass computes all inner products of the block in a single matrix-matrix
+ * product, so a block of s vectors needs two reductions instead of O(s k).
+ * The upper Hessenberg matrix of the Arnoldi relation is recovered from the
+ * change of basis, and the least-squares problem is solved with Givens
+ * rotations after each block as in Gmres.
+ *
+ * The stopping criterion is checked after each block using the implicit
+ * residual norm, so the number of iterations is a multiple of `step_size`
+ * within a restart cycle. The Krylov dimension is rounded up to a multiple
+ * of `step_size`. Multiple right-hand sides are solved one after the other.
+ *
+ * If the block of new vectors turns out to be numerically rank-deficient, it
+ * is truncated to its linearly independent part.
+ *
+ * @tparam ValueType  precision of matrix elements
+ *
+ * @ingroup solvers
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision>
+class CaGmres : public EnableLinOp<CaGmres<ValueType>>,
+                public Preconditionable {
+    friend class EnableLinOp<CaGmres>;
+    friend class EnablePolymorphicObject<CaGmres, LinOp>;
+
+public:
+    using value_type = ValueType;
+
+    /**
+     * Gets the system operator (matrix) of the linear system.
+     *
+     * @return the system operator (matrix)
+     */
+    std::shared_ptr<const LinOp> get_system_matrix() const
+    {
+        return system_matrix_;
+    }
+
+    /**
+     * Return true as iterative solvers use the data in x as an initial guess.
+     *
+     * @return true as iterative solvers use the data in x as an initial guess.
+     */
+    bool apply_uses_initial_guess() const override { return true; }
+
+    /**
+     * Gets the krylov dimension of the solver, which is a multiple of the
+     * step size.
+     *
+     * @return the krylov dimension
+     */
+    size_type get_krylov_dim() const { return krylov_dim_; }
+
+    /**
+     * Gets the number of Krylov vectors generated per block.
+     *
+     * @return the step size
+     */
+    size_type get_step_size() const { return step_size_; }
+
+    /**
+     * Gets the stopping criterion factory of the solver.
+     *
+     * @return the stopping criterion factory
+     */
+    std::shared_ptr<const stop::CriterionFactory> get_stop_criterion_factory()
+        const
+    {
+        return stop_criterion_factory_;
+    }
+
+    /**
+     * Sets the stopping criterion of the solver.
+     *
+     * @param other  the new stopping criterion factory
+     */
+    void set_stop_criterion_factory(
+        std::shared_ptr<const stop::CriterionFactory> other)
+    {
+        stop_criterion_factory_ = std::move(other);
+    }
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * Criterion factories.
+         */
+        std::vector<std::shared_ptr<const stop::CriterionFactory>>
+            GKO_FACTORY_PARAMETER_VECTOR(criteria, nullptr);
+
+        /**
+         * Preconditioner factory.
+         */
+        std::shared_ptr<const LinOpFactory> GKO_FACTORY_PARAMETER_SCALAR(
+            preconditioner, nullptr);
+
+        /**
+         * Already generated preconditioner. If one is provided, the factory
+         * `preconditioner` will be ignored.
+         */
+        std::shared_ptr<const LinOp> GKO_FACTORY_PARAMETER_SCALAR(
+            generated_preconditioner, nullptr);
+
+        /**
+         * Krylov dimension, i.e. the length of a restart cycle. It is rounded
+         * up to a multiple of `step_size`.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(krylov_dim, 100u);
+
+        /**
+         * Number of Krylov vectors generated and orthogonalized as one block.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(step_size, 5u);
+
+        /**
+         * Polynomial basis used to generate the Krylov vectors of a block.
+         */
+        ca_gmres::basis GKO_FACTORY_PARAMETER_SCALAR(basis,
+                                                     ca_gmres::basis::newton);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(CaGmres, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    void apply_impl(const LinOp *b, LinOp *x) const override;
+
+    void apply_dense_impl(const matrix::Dense<ValueType> *b,
+                          matrix::Dense<ValueType> *x) const;
+
+    /**
+     * Solves the system for a single right-hand side.
+     */
+    void solve_single(const matrix::Dense<ValueType> *b,
+                      matrix::Dense<ValueType> *x) const;
+
+    void apply_impl(const LinOp *alpha, const LinOp *b, const LinOp *beta,
+                    LinOp *x) const override;
+
+    explicit CaGmres(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<CaGmres>(std::move(exec))
+    {}
+
+    explicit CaGmres(const Factory *factory,
+                     std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<CaGmres>(factory->get_executor(),
+                               gko::transpose(system_matrix->get_size())),
+          parameters_{factory->get_parameters()},
+          system_matrix_{std::move(system_matrix)}
+    {
+        GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix_);
+        if (parameters_.step_size == 0) {
+            GKO_NOT_SUPPORTED(parameters_.step_size);
+        }
+        if (parameters_.generated_preconditioner) {
+            GKO_ASSERT_EQUAL_DIMENSIONS(parameters_.generated_preconditioner,
+                                        this);
+            set_preconditioner(parameters_.generated_preconditioner);
+        } else if (parameters_.preconditioner) {
+            set_preconditioner(
+                parameters_.preconditioner->generate(system_matrix_));
+        } else {
+            set_preconditioner(matrix::Identity<ValueType>::create(
+                this->get_executor(), this->get_size()));
+        }
+        step_size_ = parameters_.step_size;
+        const auto krylov_dim = std::max(parameters_.krylov_dim, size_type{1});
+        krylov_dim_ = (krylov_dim + step_size_ - 1) / step_size_ * step_size_;
+        stop_criterion_factory_ =
+            stop::combine(std::move(parameters_.criteria));
+    }
+
+private:
+    std::shared_ptr<const LinOp> system_matrix_{};
+    std::shared_ptr<const stop::CriterionFactory> stop_criterion_factory_{};
+    size_type krylov_dim_{};
+    size_type step_size_{};
+};
+
+
+}  // namespace solver
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_SOLVER_CA_GMRES_HPP_
@@ -0,0 +1,303 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_SOLVER_CHEBYSHEV_HPP_
+#define GKO_PUBLIC_CORE_SOLVER_CHEBYSHEV_HPP_
+
+
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/criterion.hpp>
+
+
+namespace gko {
+namespace solver {
+
+
+/**
+ * The Chebyshev iteration is an iterative method for systems whose
+ * (preconditioned) operator has a spectrum contained in a known interval
+ * `[lower, upper]` of the positive real axis, e.g. symmetric positive
+ * definite systems. It minimizes the worst-case error over this interval by
+ * using the scaled and shifted Chebyshev polynomials, whose coefficients only
+ * depend on the interval. In contrast to Krylov methods like Cg, an iteration
+ * thus needs no inner products, which makes the method attractive as a
+ * smoother in multigrid methods and whenever global reductions limit the
+ * scalability.
+ *
+ * With `theta = (upper + lower) / 2`, `delta = (upper - lower) / 2` and
+ * `sigma = theta / delta`, the preconditioned iteration reads
+ *
+ * ```
+ * r = b - A x
+ * rho = 1 / sigma
+ * d = 1 / theta * M r
+ * while not converged:
+ *     x = x + d
+ *     r = r - A d
+ *     rho_new = 1 / (2 sigma - rho)
+ *     d = rho_new * rho * d + 2 rho_new / delta * M r
+ *     rho = rho_new
+ * ```
+ *
+ * The updates of `d` and `x` are fused into a single kernel.
+ *
+ * If the eigenvalue bounds of the preconditioned operator `M A` are not given
+ * as parameters, they are estimated when the solver is generated: a few
+ * iterations of the preconditioned conjugate gradient method are run on an
+ * arbitrary right-hand side, and the extreme eigenvalues of the Lanczos matrix
+ * built from its coefficients are computed. As these estimates lie within the
+ * spectrum, the interval is widened by a safety factor. For smoothing, only
+ * the upper part of the spectrum needs to be damped, which can be requested
+ * via the `eigenvalue_ratio` parameter.
+ *
+ * When used as a preconditioner or smoother with `zero_initial_guess` set and
+ * a stopping criterion of `k` iterations, the solver applies a fixed
+ * polynomial of degree `k - 1` in `M A` (times `M`), i.e. `k` determines the
+ * polynomial degree.
+ *
+ * @tparam ValueType  precision of matrix elements
+ *
+ * @ingroup solvers
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision>
+class Chebyshev : public EnableLinOp<Chebyshev<ValueType>>,
+                  public Preconditionable {
+    friend class EnableLinOp<Chebyshev>;
+    friend class EnablePolymorphicObject<Chebyshev, LinOp>;
+
+public:
+    using value_type = ValueType;
+
+    /**
+     * Gets the system operator (matrix) of the linear system.
+     *
+     * @return the system operator (matrix)
+     */
+    std::shared_ptr<const LinOp> get_system_matrix() const
+    {
+        return system_matrix_;
+    }
+
+    /**
+     * Returns the lower bound of the eigenvalue interval used by the
+     * iteration, i.e. either the given or the estimated bound.
+     *
+     * @return the lower bound of the eigenvalue interval
+     */
+    remove_complex<ValueType> get_lower_eigenvalue() const noexcept
+    {
+        return lower_eigenvalue_;
+    }
+
+    /**
+     * Returns the upper bound of the eigenvalue interval used by the
+     * iteration, i.e. either the given or the estimated bound.
+     *
+     * @return the upper bound of the eigenvalue interval
+     */
+    remove_complex<ValueType> get_upper_eigenvalue() const noexcept
+    {
+        return upper_eigenvalue_;
+    }
+
+    /**
+     * Returns true unless `zero_initial_guess` is set, as the solver uses the
+     * data in x as an initial guess in this case.
+     *
+     * @return whether the solver uses the data in x as an initial guess
+     */
+    bool apply_uses_initial_guess() const override
+    {
+        return !parameters_.zero_initial_guess;
+    }
+
+    /**
+     * Gets the stopping criterion factory of the solver.
+     *
+     * @return the stopping criterion factory
+     */
+    std::shared_ptr<const stop::CriterionFactory> get_stop_criterion_factory()
+        const
+    {
+        return stop_criterion_factory_;
+    }
+
+    /**
+     * Sets the stopping criterion of the solver.
+     *
+     * @param other  the new stopping criterion factory
+     */
+    void set_stop_criterion_factory(
+        std::shared_ptr<const stop::CriterionFactory> other)
+    {
+        stop_criterion_factory_ = std::move(other);
+    }
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * Criterion factories.
+         */
+        std::vector<std::shared_ptr<const stop::CriterionFactory>>
+            GKO_FACTORY_PARAMETER_VECTOR(criteria, nullptr);
+
+        /**
+         * Preconditioner factory.
+         */
+        std::shared_ptr<const LinOpFactory> GKO_FACTORY_PARAMETER_SCALAR(
+            preconditioner, nullptr);
+
+        /**
+         * Already generated preconditioner. If one is provided, the factory
+         * `preconditioner` will be ignored.
+         */
+        std::shared_ptr<const LinOp> GKO_FACTORY_PARAMETER_SCALAR(
+            generated_preconditioner, nullptr);
+
+        /**
+         * Lower bound of the eigenvalues of the preconditioned operator. If
+         * it is not smaller than `upper_eigenvalue`, both bounds are
+         * estimated.
+         */
+        remove_complex<ValueType> GKO_FACTORY_PARAMETER_SCALAR(
+            lower_eigenvalue, zero<remove_complex<ValueType>>());
+
+        /**
+         * Upper bound of the eigenvalues of the preconditioned operator. If
+         * it is not larger than `lower_eigenvalue`, both bounds are
+         * estimated.
+         */
+        remove_complex<ValueType> GKO_FACTORY_PARAMETER_SCALAR(
+            upper_eigenvalue, zero<remove_complex<ValueType>>());
+
+        /**
+         * Number of conjugate gradient iterations used to estimate the
+         * eigenvalue bounds.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(num_estimation_iterations,
+                                               10u);
+
+        /**
+         * Relative amount by which the estimated interval is widened on both
+         * sides.
+         */
+        remove_complex<ValueType> GKO_FACTORY_PARAMETER_SCALAR(
+            estimation_safety_factor,
+            static_cast<remove_complex<ValueType>>(0.1));
+
+        /**
+         * If positive, the lower bound is not estimated, but set to the upper
+         * bound divided by this ratio. Values around 30 are typical for
+         * smoothers, which only need to damp the upper part of the spectrum.
+         * Only used if the bounds are estimated.
+         */
+        remove_complex<ValueType> GKO_FACTORY_PARAMETER_SCALAR(
+            eigenvalue_ratio, zero<remove_complex<ValueType>>());
+
+        /**
+         * If set, the content of x is ignored and every application starts
+         * from a zero initial guess.
+         */
+        bool GKO_FACTORY_PARAMETER_SCALAR(zero_initial_guess, false);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(Chebyshev, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    void apply_impl(const LinOp *b, LinOp *x) const override;
+
+    void apply_dense_impl(const matrix::Dense<ValueType> *b,
+                          matrix::Dense<ValueType> *x) const;
+
+    void apply_impl(const LinOp *alpha, const LinOp *b, const LinOp *beta,
+                    LinOp *x) const override;
+
+    /**
+     * Estimates the eigenvalue bounds of the preconditioned system matrix.
+     */
+    void estimate_eigenvalues();
+
+    explicit Chebyshev(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<Chebyshev>(std::move(exec))
+    {}
+
+    explicit Chebyshev(const Factory *factory,
+                       std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<Chebyshev>(factory->get_executor(),
+                                 gko::transpose(system_matrix->get_size())),
+          parameters_{factory->get_parameters()},
+          system_matrix_{std::move(system_matrix)},
+          lower_eigenvalue_{parameters_.lower_eigenvalue},
+          upper_eigenvalue_{parameters_.upper_eigenvalue}
+    {
+        GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix_);
+        if (parameters_.generated_preconditioner) {
+            GKO_ASSERT_EQUAL_DIMENSIONS(parameters_.generated_preconditioner,
+                                        this);
+            set_preconditioner(parameters_.generated_preconditioner);
+        } else if (parameters_.preconditioner) {
+            set_preconditioner(
+                parameters_.preconditioner->generate(system_matrix_));
+        } else {
+            set_preconditioner(matrix::Identity<ValueType>::create(
+                this->get_executor(), this->get_size()));
+        }
+        stop_criterion_factory_ =
+            stop::combine(std::move(parameters_.criteria));
+        if (!(lower_eigenvalue_ < upper_eigenvalue_)) {
+            this->estimate_eigenvalues();
+        }
+    }
+
+private:
+    std::shared_ptr<const LinOp> system_matrix_{};
+    std::shared_ptr<const stop::CriterionFactory> stop_criterion_factory_{};
+    remove_complex<ValueType> lower_eigenvalue_{};
+    remove_complex<ValueType> upper_eigenvalue_{};
+};
+
+
+}  // namespace solver
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_SOLVER_CHEBYSHEV_HPP_
@@ -0,0 +1,258 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_SOLVER_DIRECT_HPP_
+#define GKO_PUBLIC_CORE_SOLVER_DIRECT_HPP_
+
+
+#include <memory>
+
+
+#include <ginkgo/core/base/abstract_factory.hpp>
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/dim.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/polymorphic_object.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/reorder/rcm.hpp>
+
+
+namespace gko {
+namespace solver {
+
+
+/**
+ * The factorization computed by the Direct solver.
+ */
+enum class factorization_type {
+    /**
+     * LU factorization with partial pivoting restricted to the diagonal
+     * blocks of the supernodes, suitable for general matrices.
+     */
+    lu,
+    /**
+     * Cholesky factorization L L^H, suitable for symmetric (or hermitian)
+     * positive definite matrices. Only the lower triangle of the matrix is
+     * accessed.
+     */
+    cholesky
+};
+
+
+template <typename IndexType>
+struct SupernodalSymbolic;
+
+
+/**
+ * Direct is a sparse direct solver based on a supernodal LU or Cholesky
+ * factorization of the system matrix.
+ *
+ * The generation consists of a symbolic analysis followed by the numeric
+ * factorization. The symbolic analysis orders the matrix with a fill-reducing
+ * reordering (see the reorder module) and a postorder of the elimination tree
+ * of the symmetrized sparsity pattern, computes the sparsity pattern of the
+ * factors and groups columns with identical patterns into supernodes. The
+ * numeric factorization is multifrontal: the entries of each supernode and the
+ * update matrices of its children in the elimination tree are assembled into a
+ * dense frontal matrix, which is partially factorized with dense block
+ * operations. Independent subtrees of the elimination tree are factorized in
+ * parallel. The triangular solves process the dense blocks of one supernode at
+ * a time.
+ *
+ * The symbolic analysis only depends on the sparsity pattern, so it can be
+ * reused for a sequence of matrices with the same pattern (see refactorize).
+ *
+ * For LU, the pivots are searched within the diagonal block of each supernode
+ * only, which preserves the symbolic analysis. Pivots whose magnitude falls
+ * below machine precision times the largest entry of the matrix are replaced
+ * by this value (see get_num_perturbed_pivots). In this case, the solver only
+ * computes an approximate solution and should be used as a preconditioner of
+ * an iterative solver like Ir or Gmres to recover the accuracy.
+ *
+ * @note The factorization and the triangular solves are always computed on the
+ *       host, i.e. the master executor of the solver's executor. The right
+ *       hand sides and solutions are copied if the executor is a device
+ *       executor.
+ *
+ * @tparam ValueType  precision of matrix elements
+ * @tparam IndexType  precision of matrix indices
+ *
+ * @ingroup solvers
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class Direct : public EnableLinOp<Direct<ValueType, IndexType>> {
+    friend class EnableLinOp<Direct>;
+    friend class EnablePolymorphicObject<Direct, LinOp>;
+
+public:
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using matrix_type = matrix::Csr<ValueType, IndexType>;
+    using reordering_type = reorder::Rcm<ValueType, IndexType>;
+
+    /**
+     * Returns the number of supernodes found by the symbolic analysis.
+     *
+     * @return the number of supernodes
+     */
+    size_type get_num_supernodes() const;
+
+    /**
+     * Returns the number of stored entries in the factors, including the
+     * explicit zeros in the dense blocks of the supernodes.
+     *
+     * @return the number of stored entries in the factors
+     */
+    size_type get_num_factor_elements() const
+    {
+        return factors_.get_num_elems();
+    }
+
+    /**
+     * Returns the number of pivots that were perturbed by the last numeric
+     * factorization because their magnitude was too small.
+     *
+     * @return the number of perturbed pivots
+     */
+    size_type get_num_perturbed_pivots() const { return num_perturbed_; }
+
+    /**
+     * Recomputes the numeric factorization for a new system matrix with the
+     * same sparsity pattern as the one the solver was generated from, e.g. the
+     * matrix of the next time step or Newton iteration.
+     *
+     * The symbolic analysis, i.e. the reordering, the supernodes and the
+     * assembly of the frontal matrices, is reused.
+     *
+     * @param system_matrix  the new system matrix, which must be convertible
+     *                       to a Csr matrix and have the same sparsity
+     *                       pattern as the previous one
+     */
+    void refactorize(std::shared_ptr<const LinOp> system_matrix);
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * The factorization that is computed.
+         */
+        factorization_type GKO_FACTORY_PARAMETER_SCALAR(
+            factorization, factorization_type::lu);
+
+        /**
+         * The fill-reducing reordering applied to the symmetrized sparsity
+         * pattern of the system matrix. If it is not set, a reorder::Rcm with
+         * default parameters is used.
+         */
+        std::shared_ptr<const typename reordering_type::Factory>
+            GKO_FACTORY_PARAMETER_SCALAR(reordering, nullptr);
+
+        /**
+         * If set to true, no fill-reducing reordering is applied. The columns
+         * are still reordered by a postorder of the elimination tree, which
+         * does not change the fill-in.
+         */
+        bool GKO_FACTORY_PARAMETER_SCALAR(skip_reordering, false);
+
+        /**
+         * The maximal number of columns of a supernode. Larger supernodes
+         * allow for more efficient dense operations, smaller supernodes for
+         * more parallelism and restrict the pivot search.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(max_supernode_size, 64u);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(Direct, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    void apply_impl(const LinOp *b, LinOp *x) const override;
+
+    void apply_impl(const LinOp *alpha, const LinOp *b, const LinOp *beta,
+                    LinOp *x) const override;
+
+    /**
+     * Computes the symbolic analysis of the system matrix.
+     */
+    void analyze(const matrix_type *system_matrix);
+
+    /**
+     * Computes the numeric factorization of the system matrix.
+     */
+    void factorize(const matrix_type *system_matrix);
+
+    explicit Direct(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<Direct>(std::move(exec)),
+          factors_{this->get_executor()->get_master()},
+          pivots_{this->get_executor()->get_master()}
+    {
+        auto empty_matrix =
+            matrix_type::create(this->get_executor()->get_master());
+        this->analyze(empty_matrix.get());
+        this->factorize(empty_matrix.get());
+    }
+
+    explicit Direct(const Factory *factory,
+                    std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<Direct>(factory->get_executor(),
+                              gko::transpose(system_matrix->get_size())),
+          parameters_{factory->get_parameters()},
+          factors_{this->get_executor()->get_master()},
+          pivots_{this->get_executor()->get_master()}
+    {
+        GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix);
+        // The factorization is always computed on the host
+        const auto host = this->get_executor()->get_master();
+        std::shared_ptr<const matrix_type> host_matrix =
+            matrix_type::create(host);
+        if (system_matrix->get_size()) {
+            host_matrix = copy_and_convert_to<matrix_type>(host, system_matrix);
+        }
+        this->analyze(host_matrix.get());
+        this->factorize(host_matrix.get());
+    }
+
+private:
+    std::shared_ptr<const SupernodalSymbolic<IndexType>> symbolic_;
+    Array<ValueType> factors_;
+    Array<IndexType> pivots_;
+    size_type num_perturbed_{};
+};
+
+
+}  // namespace solver
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_SOLVER_DIRECT_HPP_
@@ -0,0 +1,300 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_SOLVER_GCRO_DR_HPP_
+#define GKO_PUBLIC_CORE_SOLVER_GCRO_DR_HPP_
+
+
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/log/logger.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/criterion.hpp>
+
+
+namespace gko {
+namespace solver {
+
+
+/**
+ * GCRO-DR (generalized conjugate residual with inner orthogonalization and
+ * deflated restarting) is a restarted GMRES method which recycles a subspace
+ * between restart cycles, between calls to apply and between linear systems
+ * of a sequence of slowly changing matrices.
+ *
+ * The solver keeps a recycle space U of at most `recycle_dim` vectors with
+ * C = A M U orthonormal, where M is the preconditioner (applied from the
+ * right). Each restart cycle first removes the part of the residual in the
+ * range of C, and then builds a Krylov subspace of dimension
+ * `krylov_dim - k` (k is the current size of U) with the operator
+ * (I - C C^H) A M. The minimal residual solution is computed over the
+ * combined space, and the recycle space is updated by the harmonic Ritz
+ * vectors of A M with respect to it that belong to the harmonic Ritz values
+ * of smallest magnitude. Deflating these slowly converging modes avoids
+ * rediscovering them in every restart cycle and for every new right-hand
+ * side or matrix.
+ *
+ * The recycle space is stored in the solver and reused by all subsequent
+ * applications. When the system matrix changes, e.g. in the next step of a
+ * time-dependent simulation, regenerate can be used to replace the matrix
+ * while keeping the recycle space. Multiple right-hand sides are solved one
+ * after the other, each of them profiting from the space recycled by the
+ * previous ones.
+ *
+ * @note As the recycle space is updated in apply, concurrent applications of
+ *       the same solver object are not supported.
+ *
+ * @tparam ValueType  precision of matrix elements
+ *
+ * @ingroup solvers
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision>
+class GcroDr : public EnableLinOp<GcroDr<ValueType>>, public Preconditionable {
+    friend class EnableLinOp<GcroDr>;
+    friend class EnablePolymorphicObject<GcroDr, LinOp>;
+
+public:
+    using value_type = ValueType;
+
+    /**
+     * Gets the system operator (matrix) of the linear system.
+     *
+     * @return the system operator (matrix)
+     */
+    std::shared_ptr<const LinOp> get_system_matrix() const
+    {
+        return system_matrix_;
+    }
+
+    /**
+     * Return true as iterative solvers use the data in x as an initial guess.
+     *
+     * @return true as iterative solvers use the data in x as an initial guess.
+     */
+    bool apply_uses_initial_guess() const override { return true; }
+
+    /**
+     * Gets the maximal dimension of the search space (recycle space and
+     * Krylov subspace) of a restart cycle.
+     *
+     * @return the krylov dimension
+     */
+    size_type get_krylov_dim() const { return parameters_.krylov_dim; }
+
+    /**
+     * Gets the maximal number of vectors of the recycle space.
+     *
+     * @return the recycle dimension
+     */
+    size_type get_recycle_dim() const { return parameters_.recycle_dim; }
+
+    /**
+     * Gets the number of vectors in the current recycle space.
+     *
+     * @return the number of recycled vectors, 0 before the first application
+     */
+    size_type get_num_recycled_vectors() const
+    {
+        return recycle_space_ ? recycle_space_->get_size()[0] : 0;
+    }
+
+    /**
+     * Returns a copy of the current recycle space U, where C = A M U has
+     * orthonormal columns.
+     *
+     * @return the recycle space with one vector per column, or nullptr if it
+     *         is empty
+     */
+    std::unique_ptr<matrix::Dense<ValueType>> get_recycle_space() const;
+
+    /**
+     * Discards the recycle space, the next application starts with a plain
+     * GMRES cycle.
+     */
+    void clear_recycle_space();
+
+    /**
+     * Replaces the system matrix, while keeping the recycle space.
+     *
+     * The image C = A M U of the recycle space is recomputed and
+     * orthonormalized for the new matrix, which needs one application of
+     * the preconditioner and the matrix per recycled vector. If the
+     * preconditioner was generated by the solver from the `preconditioner`
+     * factory, it is generated again from the new matrix, a preconditioner
+     * given as `generated_preconditioner` is kept.
+     *
+     * @param system_matrix  the new system matrix, which needs to be of the
+     *                       same size as the previous one
+     */
+    void regenerate(std::shared_ptr<const LinOp> system_matrix);
+
+    /**
+     * Sets the preconditioner and updates the image of the recycle space.
+     *
+     * @param new_precond  the new preconditioner
+     */
+    void set_preconditioner(std::shared_ptr<const LinOp> new_precond) override;
+
+    /**
+     * Gets the stopping criterion factory of the solver.
+     *
+     * @return the stopping criterion factory
+     */
+    std::shared_ptr<const stop::CriterionFactory> get_stop_criterion_factory()
+        const
+    {
+        return stop_criterion_factory_;
+    }
+
+    /**
+     * Sets the stopping criterion of the solver.
+     *
+     * @param other  the new stopping criterion factory
+     */
+    void set_stop_criterion_factory(
+        std::shared_ptr<const stop::CriterionFactory> other)
+    {
+        stop_criterion_factory_ = std::move(other);
+    }
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * Criterion factories.
+         */
+        std::vector<std::shared_ptr<const stop::CriterionFactory>>
+            GKO_FACTORY_PARAMETER_VECTOR(criteria, nullptr);
+
+        /**
+         * Preconditioner factory.
+         */
+        std::shared_ptr<const LinOpFactory> GKO_FACTORY_PARAMETER_SCALAR(
+            preconditioner, nullptr);
+
+        /**
+         * Already generated preconditioner. If one is provided, the factory
+         * `preconditioner` will be ignored.
+         */
+        std::shared_ptr<const LinOp> GKO_FACTORY_PARAMETER_SCALAR(
+            generated_preconditioner, nullptr);
+
+        /**
+         * Maximal dimension of the search space of a restart cycle, i.e. the
+         * number of recycled vectors plus the dimension of the Krylov
+         * subspace.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(krylov_dim, 100u);
+
+        /**
+         * Maximal number of vectors of the recycle space. It has to be
+         * smaller than `krylov_dim`, 0 disables recycling.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(recycle_dim, 10u);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(GcroDr, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    void apply_impl(const LinOp *b, LinOp *x) const override;
+
+    void apply_dense_impl(const matrix::Dense<ValueType> *b,
+                          matrix::Dense<ValueType> *x) const;
+
+    /**
+     * Solves the system for a single right-hand side.
+     */
+    void solve_single(const matrix::Dense<ValueType> *b,
+                      matrix::Dense<ValueType> *x) const;
+
+    void apply_impl(const LinOp *alpha, const LinOp *b, const LinOp *beta,
+                    LinOp *x) const override;
+
+    /**
+     * Recomputes C = A M U and orthonormalizes it, U is transformed
+     * accordingly. Vectors of U whose images are linearly dependent are
+     * dropped.
+     */
+    void update_recycle_image();
+
+    explicit GcroDr(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<GcroDr>(std::move(exec))
+    {}
+
+    explicit GcroDr(const Factory *factory,
+                    std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<GcroDr>(factory->get_executor(),
+                              gko::transpose(system_matrix->get_size())),
+          parameters_{factory->get_parameters()},
+          system_matrix_{std::move(system_matrix)}
+    {
+        GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix_);
+        if (parameters_.krylov_dim == 0 ||
+            parameters_.recycle_dim >= parameters_.krylov_dim) {
+            GKO_NOT_SUPPORTED(parameters_.recycle_dim);
+        }
+        if (parameters_.generated_preconditioner) {
+            GKO_ASSERT_EQUAL_DIMENSIONS(parameters_.generated_preconditioner,
+                                        this);
+            set_preconditioner(parameters_.generated_preconditioner);
+        } else if (parameters_.preconditioner) {
+            set_preconditioner(
+                parameters_.preconditioner->generate(system_matrix_));
+        } else {
+            set_preconditioner(matrix::Identity<ValueType>::create(
+                this->get_executor(), this->get_size()));
+        }
+        stop_criterion_factory_ =
+            stop::combine(std::move(parameters_.criteria));
+    }
+
+private:
+    std::shared_ptr<const LinOp> system_matrix_{};
+    std::shared_ptr<const stop::CriterionFactory> stop_criterion_factory_{};
+    // the vectors of U and C are stored as rows, both are replaced instead of
+    // modified, so copies of the solver can share them
+    mutable std::shared_ptr<const matrix::Dense<ValueType>> recycle_space_{};
+    mutable std::shared_ptr<const matrix::Dense<ValueType>> recycle_image_{};
+};
+
+
+}  // namespace solver
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_SOLVER_GCRO_DR_HPP_
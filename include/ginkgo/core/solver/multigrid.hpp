@@ -0,0 +1,384 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#ifndef GKO_PUBLIC_CORE_SOLVER_MULTIGRID_HPP_
+#define GKO_PUBLIC_CORE_SOLVER_MULTIGRID_HPP_
+
+
+#include <vector>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/multigrid/multigrid_level.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/criterion.hpp>
+
+
+namespace gko {
+namespace solver {
+
+
+/**
+ * The cycle type used by the Multigrid solver to traverse the hierarchy.
+ */
+enum class multigrid_cycle {
+    /**
+     * The coarse level correction is computed by a single cycle on the next
+     * coarser level.
+     */
+    v,
+    /**
+     * The coarse level correction is computed by two cycles on the next
+     * coarser level.
+     */
+    w,
+    /**
+     * The coarse level correction is computed by an F-cycle followed by a
+     * V-cycle on the next coarser level.
+     */
+    f
+};
+
+
+/**
+ * Multigrid methods solve a linear system by combining a few smoothing steps,
+ * which dampen the high-frequency components of the error, with a correction
+ * computed on a coarser representation of the system, on which the remaining
+ * smooth error components can be reduced cheaply.
+ *
+ * The hierarchy is built from the `mg_level` factories (e.g.
+ * multigrid::AmgxPgm), each of which generates a multigrid::MultigridLevel
+ * from the operator of the current level, providing the restriction,
+ * prolongation and coarse operators. The coarsening stops once `max_levels`
+ * levels have been created, the coarse operator has at most `min_coarse_rows`
+ * rows, or a level does not reduce the number of rows anymore. The
+ * `coarsest_solver` is used on the remaining coarse operator.
+ *
+ * One iteration of the solver executes one cycle on the finest level:
+ *
+ * ```
+ * cycle(level, b, x):
+ *     if level is the coarsest level:
+ *         x = coarsest_solver(b)
+ *         return
+ *     x = pre_smoother(b, x)
+ *     r = b - A x
+ *     g = restrict(r)
+ *     e = 0
+ *     cycle(level + 1, g, e)                    # V-cycle
+ *     # W-cycle: cycle(level + 1, g, e) twice
+ *     # F-cycle: F-cycle(level + 1, g, e), then V-cycle(level + 1, g, e)
+ *     x = x + prolong(e)
+ *     x = post_smoother(b, x)
+ * ```
+ *
+ * Smoothers and the coarsest solver that use the initial guess (like Ir) are
+ * applied to the current solution directly, all others are applied as a
+ * correction `x = x + S(b - A x)`. A weighted Jacobi smoother can thus be
+ * obtained from Ir with a preconditioner::Jacobi inner solver, a relaxation
+ * factor and a single iteration.
+ *
+ * The work vectors of all levels are allocated by the first application and
+ * reused as long as the number of right-hand sides does not change. Thus, a
+ * single Multigrid object must not be applied concurrently.
+ *
+ * To use the solver as a preconditioner of Krylov solvers like Cg or Gmres,
+ * set `zero_initial_guess` (so it acts as a fixed linear operator) and use a
+ * stopping criterion of a single iteration.
+ *
+ * @tparam ValueType  precision of matrix elements
+ *
+ * @ingroup solvers
+ * @ingroup Multigrid
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision>
+class Multigrid : public EnableLinOp<Multigrid<ValueType>> {
+    friend class EnableLinOp<Multigrid>;
+    friend class EnablePolymorphicObject<Multigrid, LinOp>;
+
+public:
+    using value_type = ValueType;
+
+    /**
+     * Returns the system operator (matrix) of the linear system.
+     *
+     * @return the system operator (matrix)
+     */
+    std::shared_ptr<const LinOp> get_system_matrix() const
+    {
+        return system_matrix_;
+    }
+
+    /**
+     * Returns the multigrid levels, starting with the finest one.
+     *
+     * @return the multigrid levels
+     */
+    std::vector<std::shared_ptr<const multigrid::MultigridLevel>>
+    get_mg_level_list() const
+    {
+        return mg_level_list_;
+    }
+
+    /**
+     * Returns the pre-smoothers of the levels, which may be `nullptr` for
+     * levels without pre-smoothing.
+     *
+     * @return the pre-smoothers of the levels
+     */
+    std::vector<std::shared_ptr<const LinOp>> get_pre_smoother_list() const
+    {
+        return pre_smoother_list_;
+    }
+
+    /**
+     * Returns the post-smoothers of the levels, which may be `nullptr` for
+     * levels without post-smoothing.
+     *
+     * @return the post-smoothers of the levels
+     */
+    std::vector<std::shared_ptr<const LinOp>> get_post_smoother_list() const
+    {
+        return post_smoother_list_;
+    }
+
+    /**
+     * Returns the solver used on the coarsest level.
+     *
+     * @return the solver used on the coarsest level
+     */
+    std::shared_ptr<const LinOp> get_coarsest_solver() const
+    {
+        return coarsest_solver_;
+    }
+
+    /**
+     * Returns true unless `zero_initial_guess` is set, as the solver uses the
+     * data in x as an initial guess in this case.
+     *
+     * @return whether the solver uses the data in x as an initial guess
+     */
+    bool apply_uses_initial_guess() const override
+    {
+        return !parameters_.zero_initial_guess;
+    }
+
+    /**
+     * Gets the stopping criterion factory of the solver.
+     *
+     * @return the stopping criterion factory
+     */
+    std::shared_ptr<const stop::CriterionFactory> get_stop_criterion_factory()
+        const
+    {
+        return stop_criterion_factory_;
+    }
+
+    /**
+     * Sets the stopping criterion of the solver.
+     *
+     * @param other  the new stopping criterion factory
+     */
+    void set_stop_criterion_factory(
+        std::shared_ptr<const stop::CriterionFactory> other)
+    {
+        stop_criterion_factory_ = std::move(other);
+    }
+
+    GKO_CREATE_FACTORY_PARAMETERS(parameters, Factory)
+    {
+        /**
+         * Criterion factories.
+         */
+        std::vector<std::shared_ptr<const stop::CriterionFactory>>
+            GKO_FACTORY_PARAMETER_VECTOR(criteria, nullptr);
+
+        /**
+         * Factories generating the multigrid levels. The i-th factory is used
+         * on the i-th level, the last one is used for all remaining levels.
+         */
+        std::vector<std::shared_ptr<const LinOpFactory>>
+            GKO_FACTORY_PARAMETER_VECTOR(mg_level, nullptr);
+
+        /**
+         * Factories generating the pre-smoothers. The i-th factory is used on
+         * the i-th level, the last one is used for all remaining levels. If no
+         * factory is given, or a factory is `nullptr`, the corresponding
+         * levels are not pre-smoothed.
+         */
+        std::vector<std::shared_ptr<const LinOpFactory>>
+            GKO_FACTORY_PARAMETER_VECTOR(pre_smoother, nullptr);
+
+        /**
+         * Factories generating the post-smoothers, with the same semantics as
+         * `pre_smoother`. Only used if `post_uses_pre` is `false`.
+         */
+        std::vector<std::shared_ptr<const LinOpFactory>>
+            GKO_FACTORY_PARAMETER_VECTOR(post_smoother, nullptr);
+
+        /**
+         * Whether the pre-smoothers are also used as post-smoothers.
+         */
+        bool GKO_FACTORY_PARAMETER_SCALAR(post_uses_pre, true);
+
+        /**
+         * Factory generating the solver on the coarsest level. If not set,
+         * the coarsest level is handled by the identity operator.
+         */
+        std::shared_ptr<const LinOpFactory> GKO_FACTORY_PARAMETER_SCALAR(
+            coarsest_solver, nullptr);
+
+        /**
+         * The maximum number of levels, i.e. of coarsening steps.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(max_levels, 10u);
+
+        /**
+         * The coarsening stops once the coarse operator has at most this many
+         * rows.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(min_coarse_rows, 2u);
+
+        /**
+         * The cycle type used in every iteration.
+         */
+        multigrid_cycle GKO_FACTORY_PARAMETER_SCALAR(cycle,
+                                                     multigrid_cycle::v);
+
+        /**
+         * If set, the content of x is ignored and every application starts
+         * from a zero initial guess.
+         */
+        bool GKO_FACTORY_PARAMETER_SCALAR(zero_initial_guess, false);
+    };
+    GKO_ENABLE_LIN_OP_FACTORY(Multigrid, parameters, Factory);
+    GKO_ENABLE_BUILD_METHOD(Factory);
+
+protected:
+    void apply_impl(const LinOp *b, LinOp *x) const override;
+
+    void apply_dense_impl(const matrix::Dense<ValueType> *b,
+                          matrix::Dense<ValueType> *x) const;
+
+    void apply_impl(const LinOp *alpha, const LinOp *b, const LinOp *beta,
+                    LinOp *x) const override;
+
+    /**
+     * Runs a cycle of the given type on a level of the hierarchy.
+     *
+     * @param cycle  the cycle type
+     * @param level  the index of the level, the number of levels refers to
+     *               the coarsest level
+     * @param b  the right-hand side on the level
+     * @param x  the solution on the level, used as initial guess
+     */
+    void run_cycle(multigrid_cycle cycle, size_type level,
+                   const matrix::Dense<ValueType> *b,
+                   matrix::Dense<ValueType> *x) const;
+
+    /**
+     * Builds the multigrid hierarchy.
+     */
+    void generate();
+
+    explicit Multigrid(std::shared_ptr<const Executor> exec)
+        : EnableLinOp<Multigrid>(std::move(exec))
+    {}
+
+    explicit Multigrid(const Factory *factory,
+                       std::shared_ptr<const LinOp> system_matrix)
+        : EnableLinOp<Multigrid>(factory->get_executor(),
+                                 gko::transpose(system_matrix->get_size())),
+          parameters_{factory->get_parameters()},
+          system_matrix_{std::move(system_matrix)}
+    {
+        GKO_ASSERT_IS_SQUARE_MATRIX(system_matrix_);
+        stop_criterion_factory_ =
+            stop::combine(std::move(parameters_.criteria));
+        this->generate();
+    }
+
+private:
+    /**
+     * The work vectors of a level: the right-hand side and the solution (both
+     * unused on the finest level) and the residual.
+     */
+    struct level_workspace {
+        std::unique_ptr<matrix::Dense<ValueType>> b;
+        std::unique_ptr<matrix::Dense<ValueType>> x;
+        std::unique_ptr<matrix::Dense<ValueType>> r;
+    };
+
+    /**
+     * The work vectors of all levels. They are not part of the state of the
+     * solver, so copies start without work vectors.
+     */
+    struct workspace_type {
+        workspace_type() = default;
+
+        workspace_type(const workspace_type &) {}
+
+        workspace_type(workspace_type &&) = default;
+
+        workspace_type &operator=(const workspace_type &)
+        {
+            levels.clear();
+            return *this;
+        }
+
+        workspace_type &operator=(workspace_type &&) = default;
+
+        std::vector<level_workspace> levels;
+    };
+
+    std::shared_ptr<const LinOp> system_matrix_{};
+    std::vector<std::shared_ptr<const multigrid::MultigridLevel>>
+        mg_level_list_{};
+    std::vector<std::shared_ptr<const LinOp>> pre_smoother_list_{};
+    std::vector<std::shared_ptr<const LinOp>> post_smoother_list_{};
+    std::shared_ptr<const LinOp> coarsest_solver_{};
+    std::shared_ptr<const stop::CriterionFactory> stop_criterion_factory_{};
+    std::shared_ptr<const matrix::Dense<ValueType>> one_op_{};
+    std::shared_ptr<const matrix::Dense<ValueType>> neg_one_op_{};
+    mutable workspace_type workspace_{};
+};
+
+
+}  // namespace solver
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_SOLVER_MULTIGRID_HPP_
@@ -37,9 +37,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <omp.h>
 
 
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
 #include <ginkgo/core/base/types.hpp>
 
 
+#include "core/components/prefix_sum.hpp"
+
+
 namespace gko {
 namespace kernels {
 namespace omp {
@@ -113,6 +118,82 @@ inline void convert_ptrs_to_idxs(const IndexType *ptrs, size_type num_rows,
 }
 
 
+/**
+ * @internal
+ *
+ * Transposes a CSR sparsity pattern in parallel. It computes the row pointers
+ * `trans_row_ptrs` (of size `num_cols + 1`) of the transposed pattern and calls
+ * `scatter(nz, trans_nz, row)` for each nonzero `nz` of the original row `row`,
+ * where `trans_nz` is its position in the transposed pattern.
+ *
+ * The rows are split into chunks with the same number of nonzeros. Each chunk
+ * counts its nonzeros per column in a separate histogram, and a prefix sum over
+ * the columns and chunks yields the output position of each chunk within each
+ * transposed row. Since the chunks traverse their rows in increasing order, the
+ * transposed pattern is sorted by column index, and the result does not depend
+ * on the number of threads.
+ */
+template <typename IndexType, typename ScatterFn>
+inline void transpose_pattern(std::shared_ptr<const OmpExecutor> exec,
+                              size_type num_rows, size_type num_cols,
+                              const IndexType *row_ptrs,
+                              const IndexType *col_idxs,
+                              IndexType *trans_row_ptrs, ScatterFn scatter)
+{
+    const auto num_chunks = static_cast<size_type>(omp_get_max_threads());
+    const auto nnz = static_cast<size_type>(row_ptrs[num_rows]);
+    Array<size_type> chunk_rows(exec, num_chunks + 1);
+    Array<IndexType> histograms(exec, num_chunks * num_cols);
+    const auto chunk_rows_data = chunk_rows.get_data();
+    const auto histogram_data = histograms.get_data();
+
+    // split the rows into chunks of (roughly) equal number of nonzeros
+    for (size_type chunk = 0; chunk <= num_chunks; ++chunk) {
+        const auto chunk_nnz = static_cast<IndexType>(nnz * chunk / num_chunks);
+        chunk_rows_data[chunk] =
+            std::lower_bound(row_ptrs, row_ptrs + num_rows, chunk_nnz) -
+            row_ptrs;
+    }
+    chunk_rows_data[num_chunks] = num_rows;
+
+#pragma omp parallel for schedule(static, 1)
+    for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+        const auto histogram = histogram_data + chunk * num_cols;
+        std::fill_n(histogram, num_cols, IndexType{});
+        for (auto nz = row_ptrs[chunk_rows_data[chunk]];
+             nz < row_ptrs[chunk_rows_data[chunk + 1]]; ++nz) {
+            histogram[col_idxs[nz]]++;
+        }
+    }
+
+    // turn the histograms into offsets of the chunks within each column
+#pragma omp parallel for
+    for (size_type col = 0; col < num_cols; ++col) {
+        IndexType count{};
+        for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+            const auto chunk_count = histogram_data[chunk * num_cols + col];
+            histogram_data[chunk * num_cols + col] = count;
+            count += chunk_count;
+        }
+        trans_row_ptrs[col] = count;
+    }
+    components::prefix_sum(exec, trans_row_ptrs, num_cols + 1);
+
+#pragma omp parallel for schedule(static, 1)
+    for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+        const auto histogram = histogram_data + chunk * num_cols;
+        for (auto row = chunk_rows_data[chunk];
+             row < chunk_rows_data[chunk + 1]; ++row) {
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+                const auto col = col_idxs[nz];
+                scatter(nz, trans_row_ptrs[col] + histogram[col]++,
+                        static_cast<IndexType>(row));
+            }
+        }
+    }
+}
+
+
 }  // namespace omp
 }  // namespace kernels
 }  // namespace gko
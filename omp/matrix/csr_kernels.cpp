@@ -435,46 +435,23 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_CONVERT_TO_ELL_KERNEL);
 
 
-template <typename ValueType, typename IndexType, typename UnaryOperator>
-inline void convert_csr_to_csc(size_type num_rows, const IndexType *row_ptrs,
-                               const IndexType *col_idxs,
-                               const ValueType *csr_vals, IndexType *row_idxs,
-                               IndexType *col_ptrs, ValueType *csc_vals,
-                               UnaryOperator op)
-{
-    for (size_type row = 0; row < num_rows; ++row) {
-        for (auto i = row_ptrs[row]; i < row_ptrs[row + 1]; ++i) {
-            const auto dest_idx = col_ptrs[col_idxs[i]]++;
-            row_idxs[dest_idx] = row;
-            csc_vals[dest_idx] = op(csr_vals[i]);
-        }
-    }
-}
-
-
 template <typename ValueType, typename IndexType, typename UnaryOperator>
 void transpose_and_transform(std::shared_ptr<const OmpExecutor> exec,
                              matrix::Csr<ValueType, IndexType> *trans,
                              const matrix::Csr<ValueType, IndexType> *orig,
                              UnaryOperator op)
 {
-    auto trans_row_ptrs = trans->get_row_ptrs();
-    auto orig_row_ptrs = orig->get_const_row_ptrs();
     auto trans_col_idxs = trans->get_col_idxs();
-    auto orig_col_idxs = orig->get_const_col_idxs();
     auto trans_vals = trans->get_values();
     auto orig_vals = orig->get_const_values();
 
-    auto orig_num_cols = orig->get_size()[1];
-    auto orig_num_rows = orig->get_size()[0];
-    auto orig_nnz = orig_row_ptrs[orig_num_rows];
-
-    trans_row_ptrs[0] = 0;
-    convert_unsorted_idxs_to_ptrs(orig_col_idxs, orig_nnz, trans_row_ptrs + 1,
-                                  orig_num_cols);
-
-    convert_csr_to_csc(orig_num_rows, orig_row_ptrs, orig_col_idxs, orig_vals,
-                       trans_col_idxs, trans_row_ptrs + 1, trans_vals, op);
+    transpose_pattern(exec, orig->get_size()[0], orig->get_size()[1],
+                      orig->get_const_row_ptrs(), orig->get_const_col_idxs(),
+                      trans->get_row_ptrs(),
+                      [&](IndexType nz, IndexType trans_nz, IndexType row) {
+                          trans_col_idxs[trans_nz] = row;
+                          trans_vals[trans_nz] = op(orig_vals[nz]);
+                      });
 }
 
 
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <algorithm>
+#include <array>
 #include <numeric>
 #include <utility>
 
@@ -47,6 +48,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ginkgo/core/matrix/csr.hpp>
 
 
+#include "accessor/block_col_major.hpp"
+#include "accessor/range.hpp"
+#include "omp/components/format_conversion.hpp"
+
+
 namespace gko {
 namespace kernels {
 namespace omp {
@@ -99,27 +105,45 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_FBCSR_CONVERT_TO_CSR_KERNEL);
 
 
-template <typename ValueType, typename IndexType, typename UnaryOperator>
-inline void convert_fbcsr_to_csc(
-    size_type num_rows, const IndexType *const row_ptrs,
-    const IndexType *const col_idxs, const ValueType *const fbcsr_vals,
-    IndexType *const row_idxs, IndexType *const col_ptrs,
-    ValueType *const csc_vals, UnaryOperator op) GKO_NOT_IMPLEMENTED;
-
-
 template <typename ValueType, typename IndexType, typename UnaryOperator>
 void transpose_and_transform(
     std::shared_ptr<const OmpExecutor> exec,
     matrix::Fbcsr<ValueType, IndexType> *const trans,
-    const matrix::Fbcsr<ValueType, IndexType> *const orig,
-    UnaryOperator op) GKO_NOT_IMPLEMENTED;
+    const matrix::Fbcsr<ValueType, IndexType> *const orig, UnaryOperator op)
+{
+    const int bs = orig->get_block_size();
+    const auto nbnz = orig->get_num_stored_blocks();
+    const std::array<size_type, 3> value_size{
+        nbnz, static_cast<size_type>(bs), static_cast<size_type>(bs)};
+    const acc::range<acc::block_col_major<const ValueType, 3>> orig_vals{
+        value_size, orig->get_const_values()};
+    const acc::range<acc::block_col_major<ValueType, 3>> trans_vals{
+        value_size, trans->get_values()};
+    auto trans_col_idxs = trans->get_col_idxs();
+
+    transpose_pattern(exec, orig->get_num_block_rows(),
+                      orig->get_num_block_cols(), orig->get_const_row_ptrs(),
+                      orig->get_const_col_idxs(), trans->get_row_ptrs(),
+                      [&](IndexType nz, IndexType trans_nz, IndexType row) {
+                          trans_col_idxs[trans_nz] = row;
+                          for (int ib = 0; ib < bs; ib++) {
+                              for (int jb = 0; jb < bs; jb++) {
+                                  trans_vals(trans_nz, ib, jb) =
+                                      op(orig_vals(nz, jb, ib));
+                              }
+                          }
+                      });
+}
 
 
 template <typename ValueType, typename IndexType>
 void transpose(std::shared_ptr<const OmpExecutor> exec,
                const matrix::Fbcsr<ValueType, IndexType> *const orig,
                matrix::Fbcsr<ValueType, IndexType> *const trans)
-    GKO_NOT_IMPLEMENTED;
+{
+    transpose_and_transform(exec, trans, orig,
+                            [](const ValueType x) { return x; });
+}
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_FBCSR_TRANSPOSE_KERNEL);
@@ -129,7 +153,10 @@ template <typename ValueType, typename IndexType>
 void conj_transpose(std::shared_ptr<const OmpExecutor> exec,
                     const matrix::Fbcsr<ValueType, IndexType> *const orig,
                     matrix::Fbcsr<ValueType, IndexType> *const trans)
-    GKO_NOT_IMPLEMENTED;
+{
+    transpose_and_transform(exec, trans, orig,
+                            [](const ValueType x) { return conj(x); });
+}
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_FBCSR_CONJ_TRANSPOSE_KERNEL);
@@ -33,6 +33,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "core/matrix/hybrid_kernels.hpp"
 
 
+#include <algorithm>
+#include <array>
+
+
 #include <omp.h>
 
 
@@ -55,6 +59,112 @@ namespace omp {
  * @ingroup hybrid
  */
 namespace hybrid {
+namespace {
+
+
+/**
+ * Number of consecutive rows processed together by the fused SpMV. The ELL
+ * part is stored column-major, so the entries of one ELL slot are contiguous
+ * for the rows of a block, and the inner loops over the rows of a block can be
+ * vectorized for all SIMD widths up to 512 bit.
+ */
+constexpr int64 rows_per_block = 64;
+
+
+/**
+ * Computes the product of the Hybrid matrix with b in a single traversal over
+ * the rows: for each block of rows, the ELL slots and the (row-sorted) COO
+ * entries belonging to these rows are accumulated in a thread-local buffer,
+ * and the result of each row is passed to `finalize(row, col, value)`.
+ * Since each block of rows is owned by a single thread, no atomic operations
+ * are necessary for the COO part.
+ */
+template <typename ValueType, typename IndexType, typename Finalize>
+void fused_spmv(const matrix::Hybrid<ValueType, IndexType> *a,
+                const matrix::Dense<ValueType> *b, Finalize finalize)
+{
+    const auto num_rows = static_cast<int64>(a->get_size()[0]);
+    const auto num_rhs = b->get_size()[1];
+    const auto ell_stride = a->get_ell_stride();
+    const auto ell_num_stored_elements_per_row =
+        a->get_ell_num_stored_elements_per_row();
+    const auto ell_val = a->get_const_ell_values();
+    const auto ell_col = a->get_const_ell_col_idxs();
+    const auto coo_val = a->get_const_coo_values();
+    const auto coo_col = a->get_const_coo_col_idxs();
+    const auto coo_row = a->get_const_coo_row_idxs();
+    const auto coo_row_end = coo_row + a->get_coo_num_stored_elements();
+    const auto num_blocks = ceildiv(num_rows, rows_per_block);
+
+#pragma omp parallel
+    {
+        std::array<ValueType, rows_per_block> partial;
+#pragma omp for schedule(static)
+        for (int64 block = 0; block < num_blocks; ++block) {
+            const auto begin = block * rows_per_block;
+            const auto size = std::min(rows_per_block, num_rows - begin);
+            const auto coo_begin = std::lower_bound(
+                coo_row, coo_row_end, static_cast<IndexType>(begin));
+            const auto coo_end =
+                std::lower_bound(coo_begin, coo_row_end,
+                                 static_cast<IndexType>(begin + size));
+            for (size_type j = 0; j < num_rhs; ++j) {
+                std::fill_n(partial.begin(), size, zero<ValueType>());
+                for (size_type i = 0; i < ell_num_stored_elements_per_row;
+                     ++i) {
+                    const auto vals = ell_val + i * ell_stride + begin;
+                    const auto cols = ell_col + i * ell_stride + begin;
+                    for (int64 row = 0; row < size; ++row) {
+                        partial[row] += vals[row] * b->at(cols[row], j);
+                    }
+                }
+                for (auto nz = coo_begin - coo_row; nz < coo_end - coo_row;
+                     ++nz) {
+                    partial[coo_row[nz] - begin] +=
+                        coo_val[nz] * b->at(coo_col[nz], j);
+                }
+                for (int64 row = 0; row < size; ++row) {
+                    finalize(begin + row, j, partial[row]);
+                }
+            }
+        }
+    }
+}
+
+
+}  // namespace
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const OmpExecutor> exec,
+          const matrix::Hybrid<ValueType, IndexType> *a,
+          const matrix::Dense<ValueType> *b, matrix::Dense<ValueType> *c)
+{
+    fused_spmv(a, b, [c](int64 row, size_type j, ValueType value) {
+        c->at(row, j) = value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_HYBRID_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
+                   const matrix::Dense<ValueType> *alpha,
+                   const matrix::Hybrid<ValueType, IndexType> *a,
+                   const matrix::Dense<ValueType> *b,
+                   const matrix::Dense<ValueType> *beta,
+                   matrix::Dense<ValueType> *c)
+{
+    const auto alpha_val = alpha->at(0, 0);
+    const auto beta_val = beta->at(0, 0);
+    fused_spmv(a, b, [&](int64 row, size_type j, ValueType value) {
+        c->at(row, j) = beta_val * c->at(row, j) + alpha_val * value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_HYBRID_ADVANCED_SPMV_KERNEL);
 
 
 template <typename ValueType, typename IndexType>
@@ -180,42 +180,20 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_SPARSITY_CSR_REMOVE_DIAGONAL_ELEMENTS_KERNEL);
 
 
-template <typename IndexType>
-inline void convert_sparsity_to_csc(size_type num_rows,
-                                    const IndexType *row_ptrs,
-                                    const IndexType *col_idxs,
-                                    IndexType *row_idxs, IndexType *col_ptrs)
-{
-    for (size_type row = 0; row < num_rows; ++row) {
-        for (auto i = row_ptrs[row]; i < row_ptrs[row + 1]; ++i) {
-            const auto dest_idx = col_ptrs[col_idxs[i]]++;
-            row_idxs[dest_idx] = row;
-        }
-    }
-}
-
-
 template <typename ValueType, typename IndexType>
 void transpose_and_transform(
     std::shared_ptr<const OmpExecutor> exec,
     matrix::SparsityCsr<ValueType, IndexType> *trans,
     const matrix::SparsityCsr<ValueType, IndexType> *orig)
 {
-    auto trans_row_ptrs = trans->get_row_ptrs();
-    auto orig_row_ptrs = orig->get_const_row_ptrs();
     auto trans_col_idxs = trans->get_col_idxs();
-    auto orig_col_idxs = orig->get_const_col_idxs();
-
-    auto orig_num_cols = orig->get_size()[1];
-    auto orig_num_rows = orig->get_size()[0];
-    auto orig_nnz = orig_row_ptrs[orig_num_rows];
-
-    trans_row_ptrs[0] = 0;
-    convert_unsorted_idxs_to_ptrs(orig_col_idxs, orig_nnz, trans_row_ptrs + 1,
-                                  orig_num_cols);
 
-    convert_sparsity_to_csc(orig_num_rows, orig_row_ptrs, orig_col_idxs,
-                            trans_col_idxs, trans_row_ptrs + 1);
+    transpose_pattern(exec, orig->get_size()[0], orig->get_size()[1],
+                      orig->get_const_row_ptrs(), orig->get_const_col_idxs(),
+                      trans->get_row_ptrs(),
+                      [&](IndexType nz, IndexType trans_nz, IndexType row) {
+                          trans_col_idxs[trans_nz] = row;
+                      });
 }
 
 
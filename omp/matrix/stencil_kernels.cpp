@@ -0,0 +1,364 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/stencil_kernels.hpp"
+
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
+
+
+#include "core/components/prefix_sum.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The Stencil matrix format namespace.
+ *
+ * @ingroup stencil
+ */
+namespace stencil {
+namespace {
+
+
+/**
+ * Number of grid nodes in x-direction processed at once. All stencil points
+ * are applied to one block before moving to the next one, so the block of the
+ * output vector stays in the L1 cache.
+ */
+constexpr size_type block_size = 512;
+
+
+/**
+ * The stencil points in the order of their column offset, together with
+ * their offsets within the grid.
+ */
+struct sorted_points {
+    template <typename ValueType>
+    explicit sorted_points(const matrix::Stencil<ValueType> *a)
+        : order(a->get_num_points()), linear_offsets(a->get_num_points())
+    {
+        const auto grid = a->get_grid_size();
+        const auto offsets = a->get_const_offsets();
+        for (size_type point = 0; point < order.size(); ++point) {
+            linear_offsets[point] =
+                offsets[3 * point] +
+                static_cast<int64>(grid[0]) *
+                    (offsets[3 * point + 1] +
+                     static_cast<int64>(grid[1]) * offsets[3 * point + 2]);
+        }
+        std::iota(order.begin(), order.end(), size_type{});
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_type p1, size_type p2) {
+                             return linear_offsets[p1] < linear_offsets[p2];
+                         });
+    }
+
+    std::vector<size_type> order;
+    std::vector<int64> linear_offsets;
+};
+
+
+/**
+ * Returns the half-open range of nodes within [begin, end) on the grid line
+ * (y, z) whose neighbor described by `offsets` lies within the grid. The range
+ * is empty if the neighboring line lies outside of the grid.
+ */
+inline std::pair<int64, int64> get_valid_range(const dim<3> &grid,
+                                               const int32 *offsets, int64 y,
+                                               int64 z, int64 begin,
+                                               int64 end)
+{
+    const auto ny = y + offsets[1];
+    const auto nz = z + offsets[2];
+    if (ny < 0 || nz < 0 || ny >= static_cast<int64>(grid[1]) ||
+        nz >= static_cast<int64>(grid[2])) {
+        return {0, 0};
+    }
+    return {std::max(begin, -static_cast<int64>(offsets[0])),
+            std::min(end, static_cast<int64>(grid[0]) - offsets[0])};
+}
+
+
+template <typename ValueType>
+inline void add_scaled_line(int64 length, ValueType weight,
+                            const ValueType *GKO_RESTRICT in,
+                            size_type in_stride, ValueType *GKO_RESTRICT out,
+                            size_type out_stride)
+{
+    if (in_stride == 1 && out_stride == 1) {
+        for (int64 i = 0; i < length; ++i) {
+            out[i] += weight * in[i];
+        }
+    } else {
+        for (int64 i = 0; i < length; ++i) {
+            out[i * out_stride] += weight * in[i * in_stride];
+        }
+    }
+}
+
+
+template <typename ValueType>
+inline void add_scaled_line(int64 length, ValueType weight,
+                            const ValueType *GKO_RESTRICT weights,
+                            const ValueType *GKO_RESTRICT in,
+                            size_type in_stride, ValueType *GKO_RESTRICT out,
+                            size_type out_stride)
+{
+    if (in_stride == 1 && out_stride == 1) {
+        for (int64 i = 0; i < length; ++i) {
+            out[i] += weight * weights[i] * in[i];
+        }
+    } else {
+        for (int64 i = 0; i < length; ++i) {
+            out[i * out_stride] += weight * weights[i] * in[i * in_stride];
+        }
+    }
+}
+
+
+/**
+ * Calls `fn(y, z, line_begin, block_begin, block_end)` for each block of
+ * `block_size` nodes of each grid line (fixed y and z), with the block given as
+ * a half-open x-range. The (line, block) pairs are distributed among the
+ * threads, so long lines (e.g. on 1D grids) are split across threads as well.
+ */
+template <typename Function>
+void for_each_block(const dim<3> &grid, Function fn)
+{
+    const auto nx = static_cast<int64>(grid[0]);
+    const auto ny = static_cast<int64>(grid[1]);
+    const auto nz = static_cast<int64>(grid[2]);
+    const auto num_blocks = ceildiv(nx, static_cast<int64>(block_size));
+    const auto num_tasks = num_blocks * ny * nz;
+#pragma omp parallel for schedule(static)
+    for (int64 task = 0; task < num_tasks; ++task) {
+        const auto line = task / num_blocks;
+        const auto block_begin =
+            (task % num_blocks) * static_cast<int64>(block_size);
+        const auto block_end =
+            std::min(nx, block_begin + static_cast<int64>(block_size));
+        fn(line % ny, line / ny, nx * line, block_begin, block_end);
+    }
+}
+
+
+/**
+ * Computes c = alpha * A * b + beta * c, or c = alpha * A * b if `beta` is
+ * nullptr.
+ *
+ * Each grid line is split into blocks of `block_size` nodes, and the
+ * contributions of the stencil points are added to a block one point at a
+ * time. Inside of a block, the loops run over contiguous memory without any
+ * index lookups or boundary checks, so they can be vectorized.
+ */
+template <typename ValueType>
+void apply_stencil(const matrix::Stencil<ValueType> *a, ValueType alpha,
+                   const matrix::Dense<ValueType> *b, const ValueType *beta,
+                   matrix::Dense<ValueType> *c)
+{
+    const auto grid = a->get_grid_size();
+    const auto num_rows = static_cast<int64>(a->get_size()[0]);
+    const auto num_rhs = c->get_size()[1];
+    const auto b_stride = b->get_stride();
+    const auto c_stride = c->get_stride();
+    const auto offsets = a->get_const_offsets();
+    const auto coefficients = a->get_const_coefficients();
+    const auto variable = a->has_variable_coefficients();
+    const sorted_points points(a);
+
+    for_each_block(grid, [&](int64 y, int64 z, int64 line_begin,
+                             int64 block_begin, int64 block_end) {
+        for (auto row = line_begin + block_begin; row < line_begin + block_end;
+             ++row) {
+            for (size_type j = 0; j < num_rhs; ++j) {
+                auto &out = c->get_values()[row * c_stride + j];
+                out = beta ? *beta * out : zero<ValueType>();
+            }
+        }
+        for (auto point : points.order) {
+            const auto range = get_valid_range(grid, offsets + 3 * point, y, z,
+                                               block_begin, block_end);
+            const auto length = range.second - range.first;
+            if (length <= 0) {
+                continue;
+            }
+            const auto row = line_begin + range.first;
+            const auto col = row + points.linear_offsets[point];
+            for (size_type j = 0; j < num_rhs; ++j) {
+                const auto in = b->get_const_values() + col * b_stride + j;
+                const auto out = c->get_values() + row * c_stride + j;
+                if (variable) {
+                    add_scaled_line(length, alpha,
+                                    coefficients + point * num_rows + row, in,
+                                    b_stride, out, c_stride);
+                } else {
+                    add_scaled_line(length, alpha * coefficients[point], in,
+                                    b_stride, out, c_stride);
+                }
+            }
+        }
+    });
+}
+
+
+}  // namespace
+
+
+template <typename ValueType>
+void spmv(std::shared_ptr<const OmpExecutor> exec,
+          const matrix::Stencil<ValueType> *a,
+          const matrix::Dense<ValueType> *b, matrix::Dense<ValueType> *c)
+{
+    apply_stencil(a, one<ValueType>(), b,
+                  static_cast<const ValueType *>(nullptr), c);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_STENCIL_SPMV_KERNEL);
+
+
+template <typename ValueType>
+void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
+                   const matrix::Dense<ValueType> *alpha,
+                   const matrix::Stencil<ValueType> *a,
+                   const matrix::Dense<ValueType> *b,
+                   const matrix::Dense<ValueType> *beta,
+                   matrix::Dense<ValueType> *c)
+{
+    apply_stencil(a, alpha->at(0, 0), b, beta->get_const_values(), c);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_STENCIL_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType>
+void extract_diagonal(std::shared_ptr<const OmpExecutor> exec,
+                      const matrix::Stencil<ValueType> *orig,
+                      matrix::Diagonal<ValueType> *diag)
+{
+    const auto num_rows = orig->get_size()[0];
+    const auto offsets = orig->get_const_offsets();
+    const auto coefficients = orig->get_const_coefficients();
+    const auto variable = orig->has_variable_coefficients();
+    const auto diag_values = diag->get_values();
+    std::vector<size_type> centers;
+    for (size_type point = 0; point < orig->get_num_points(); ++point) {
+        if (offsets[3 * point] == 0 && offsets[3 * point + 1] == 0 &&
+            offsets[3 * point + 2] == 0) {
+            centers.push_back(point);
+        }
+    }
+#pragma omp parallel for
+    for (size_type row = 0; row < num_rows; ++row) {
+        auto value = zero<ValueType>();
+        for (auto point : centers) {
+            value += variable ? coefficients[point * num_rows + row]
+                              : coefficients[point];
+        }
+        diag_values[row] = value;
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_STENCIL_EXTRACT_DIAGONAL_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void convert_to_csr(std::shared_ptr<const OmpExecutor> exec,
+                    const matrix::Stencil<ValueType> *source,
+                    matrix::Csr<ValueType, IndexType> *result)
+{
+    const auto grid = source->get_grid_size();
+    const auto num_rows = static_cast<int64>(source->get_size()[0]);
+    const auto offsets = source->get_const_offsets();
+    const auto coefficients = source->get_const_coefficients();
+    const auto variable = source->has_variable_coefficients();
+    const auto row_ptrs = result->get_row_ptrs();
+    const auto col_idxs = result->get_col_idxs();
+    const auto values = result->get_values();
+    const sorted_points points(source);
+
+    for_each_block(grid, [&](int64 y, int64 z, int64 line_begin,
+                             int64 block_begin, int64 block_end) {
+        std::fill(row_ptrs + line_begin + block_begin,
+                  row_ptrs + line_begin + block_end, IndexType{});
+        for (auto point : points.order) {
+            const auto range = get_valid_range(grid, offsets + 3 * point, y, z,
+                                               block_begin, block_end);
+            for (auto x = range.first; x < range.second; ++x) {
+                row_ptrs[line_begin + x]++;
+            }
+        }
+    });
+    components::prefix_sum(exec, row_ptrs, num_rows + 1);
+
+    for_each_block(grid, [&](int64 y, int64 z, int64 line_begin,
+                             int64 block_begin, int64 block_end) {
+        for (auto x = block_begin; x < block_end; ++x) {
+            const auto row = line_begin + x;
+            auto nz_idx = row_ptrs[row];
+            for (auto point : points.order) {
+                const auto range = get_valid_range(grid, offsets + 3 * point,
+                                                   y, z, x, x + 1);
+                if (range.first < range.second) {
+                    col_idxs[nz_idx] = static_cast<IndexType>(
+                        row + points.linear_offsets[point]);
+                    values[nz_idx] = variable
+                                         ? coefficients[point * num_rows + row]
+                                         : coefficients[point];
+                    ++nz_idx;
+                }
+            }
+        }
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace stencil
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
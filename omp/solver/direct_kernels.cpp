@@ -0,0 +1,425 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/solver/direct_kernels.hpp"
+
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/math.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The Direct solver namespace.
+ *
+ * @ingroup direct
+ */
+namespace direct {
+
+
+/**
+ * Dense blocks with fewer entries than this are processed by a single thread.
+ */
+constexpr size_type min_parallel_block_size = 4096;
+
+
+/**
+ * Partially factorizes a dense frontal matrix, i.e. factorizes its first
+ * `size` columns and computes the Schur complement in the remaining block.
+ * If `parallel` is set, the blocks right of the first `size` columns are
+ * updated in parallel. Returns the number of perturbed pivots.
+ */
+template <typename ValueType, typename IndexType>
+size_type factorize_front(ValueType *front, IndexType front_size,
+                          IndexType size, bool is_cholesky,
+                          remove_complex<ValueType> threshold,
+                          IndexType *local_pivots, bool parallel)
+{
+    const auto m = front_size;
+    const auto at = [&](IndexType row, IndexType col) -> ValueType & {
+        return front[row + static_cast<size_type>(col) * m];
+    };
+    parallel = parallel && static_cast<size_type>(m - size) * m * size >=
+                               min_parallel_block_size;
+    size_type num_perturbed{};
+    if (is_cholesky) {
+        for (IndexType k = 0; k < size; ++k) {
+            auto diag = real(at(k, k));
+            if (!(diag > threshold)) {
+                diag = threshold;
+                num_perturbed++;
+            }
+            diag = sqrt(diag);
+            at(k, k) = diag;
+            local_pivots[k] = k;
+            for (auto i = k + 1; i < m; ++i) {
+                at(i, k) /= diag;
+            }
+            for (auto j = k + 1; j < size; ++j) {
+                const auto factor = conj(at(j, k));
+                for (auto i = j; i < m; ++i) {
+                    at(i, j) -= at(i, k) * factor;
+                }
+            }
+        }
+        // lower triangle of the Schur complement
+#pragma omp parallel for schedule(dynamic) if (parallel)
+        for (auto j = size; j < m; ++j) {
+            for (IndexType k = 0; k < size; ++k) {
+                const auto factor = conj(at(j, k));
+                for (auto i = j; i < m; ++i) {
+                    at(i, j) -= at(i, k) * factor;
+                }
+            }
+        }
+        return num_perturbed;
+    }
+    for (IndexType k = 0; k < size; ++k) {
+        // the pivot search is restricted to the diagonal block
+        auto pivot_row = k;
+        for (auto i = k + 1; i < size; ++i) {
+            if (abs(at(i, k)) > abs(at(pivot_row, k))) {
+                pivot_row = i;
+            }
+        }
+        local_pivots[k] = pivot_row;
+        if (pivot_row != k) {
+            for (IndexType j = 0; j < m; ++j) {
+                std::swap(at(k, j), at(pivot_row, j));
+            }
+        }
+        auto pivot = at(k, k);
+        if (abs(pivot) < threshold) {
+            pivot = pivot == zero<ValueType>()
+                        ? ValueType{threshold}
+                        : pivot / abs(pivot) * threshold;
+            at(k, k) = pivot;
+            num_perturbed++;
+        }
+        for (auto i = k + 1; i < m; ++i) {
+            at(i, k) /= pivot;
+        }
+        for (auto j = k + 1; j < size; ++j) {
+            for (auto i = k + 1; i < m; ++i) {
+                at(i, j) -= at(i, k) * at(k, j);
+            }
+        }
+    }
+    // block of U right of the diagonal block and Schur complement
+#pragma omp parallel for if (parallel)
+    for (auto j = size; j < m; ++j) {
+        for (IndexType k = 0; k < size; ++k) {
+            for (auto i = k + 1; i < size; ++i) {
+                at(i, j) -= at(i, k) * at(k, j);
+            }
+        }
+        for (IndexType k = 0; k < size; ++k) {
+            for (auto i = size; i < m; ++i) {
+                at(i, j) -= at(i, k) * at(k, j);
+            }
+        }
+    }
+    return num_perturbed;
+}
+
+
+template <typename ValueType, typename IndexType>
+void factorize(std::shared_ptr<const OmpExecutor> exec,
+               const matrix::Csr<ValueType, IndexType> *system_matrix,
+               const solver::SupernodalSymbolic<IndexType> &symbolic,
+               Array<ValueType> &factors, Array<IndexType> &pivots,
+               size_type &num_perturbed)
+{
+    using real_type = remove_complex<ValueType>;
+    const auto num_supernodes =
+        static_cast<IndexType>(symbolic.supernode_ptrs.get_num_elems() - 1);
+    const auto num_levels =
+        static_cast<IndexType>(symbolic.level_ptrs.get_num_elems() - 1);
+    const auto supernode_ptrs = symbolic.supernode_ptrs.get_const_data();
+    const auto front_ptrs = symbolic.front_ptrs.get_const_data();
+    const auto parent_idxs = symbolic.parent_idxs.get_const_data();
+    const auto child_ptrs = symbolic.child_ptrs.get_const_data();
+    const auto child_idxs = symbolic.child_idxs.get_const_data();
+    const auto level_ptrs = symbolic.level_ptrs.get_const_data();
+    const auto level_supernodes = symbolic.level_supernodes.get_const_data();
+    const auto assembly_ptrs = symbolic.assembly_ptrs.get_const_data();
+    const auto assembly_nonzeros = symbolic.assembly_nonzeros.get_const_data();
+    const auto assembly_positions =
+        symbolic.assembly_positions.get_const_data();
+    const auto factor_ptrs = symbolic.factor_ptrs.get_const_data();
+    const auto is_cholesky =
+        symbolic.type == solver::factorization_type::cholesky;
+    const auto values = system_matrix->get_const_values();
+    const auto num_nonzeros = system_matrix->get_num_stored_elements();
+    factors.resize_and_reset(factor_ptrs[num_supernodes]);
+    pivots.resize_and_reset(system_matrix->get_size()[0]);
+    const auto factor_data = factors.get_data();
+    const auto pivot_data = pivots.get_data();
+
+    real_type max_abs{};
+#pragma omp parallel for reduction(max : max_abs)
+    for (size_type nz = 0; nz < num_nonzeros; ++nz) {
+        max_abs = std::max(max_abs, abs(values[nz]));
+    }
+    const auto threshold =
+        std::max(std::numeric_limits<real_type>::epsilon() * max_abs,
+                 std::numeric_limits<real_type>::min());
+
+    // the update matrices of the supernodes whose parent was not processed yet
+    std::vector<std::vector<ValueType>> updates(num_supernodes);
+    const auto process = [&](IndexType sn, bool parallel) {
+        const auto m = front_ptrs[sn + 1] - front_ptrs[sn];
+        const auto size = supernode_ptrs[sn + 1] - supernode_ptrs[sn];
+        std::vector<ValueType> front(static_cast<size_type>(m) * m,
+                                     zero<ValueType>());
+        for (auto i = assembly_ptrs[sn]; i < assembly_ptrs[sn + 1]; ++i) {
+            front[assembly_positions[i]] += values[assembly_nonzeros[i]];
+        }
+        for (auto c = child_ptrs[sn]; c < child_ptrs[sn + 1]; ++c) {
+            const auto child = child_idxs[c];
+            const auto child_size =
+                supernode_ptrs[child + 1] - supernode_ptrs[child];
+            const auto targets = parent_idxs + front_ptrs[child] + child_size;
+            const auto num_targets =
+                front_ptrs[child + 1] - front_ptrs[child] - child_size;
+            const auto &update = updates[child];
+            for (IndexType j = 0; j < num_targets; ++j) {
+                const auto target_col =
+                    front.data() + static_cast<size_type>(targets[j]) * m;
+                const auto update_col =
+                    update.data() + static_cast<size_type>(j) * num_targets;
+                for (auto i = is_cholesky ? j : 0; i < num_targets; ++i) {
+                    target_col[targets[i]] += update_col[i];
+                }
+            }
+            std::vector<ValueType>{}.swap(updates[child]);
+        }
+        const auto perturbed =
+            factorize_front(front.data(), m, size, is_cholesky, threshold,
+                            pivot_data + supernode_ptrs[sn], parallel);
+        const auto factor = factor_data + factor_ptrs[sn];
+        std::copy_n(front.begin(), static_cast<size_type>(m) * size, factor);
+        if (!is_cholesky) {
+            const auto upper = factor + static_cast<size_type>(m) * size;
+            for (auto j = size; j < m; ++j) {
+                for (IndexType i = 0; i < size; ++i) {
+                    upper[i + static_cast<size_type>(j - size) * size] =
+                        front[i + static_cast<size_type>(j) * m];
+                }
+            }
+        }
+        const auto num_below = m - size;
+        if (num_below > 0) {
+            auto &update = updates[sn];
+            update.resize(static_cast<size_type>(num_below) * num_below);
+            for (IndexType j = 0; j < num_below; ++j) {
+                std::copy_n(
+                    front.begin() + size + static_cast<size_type>(j + size) * m,
+                    num_below,
+                    update.begin() + static_cast<size_type>(j) * num_below);
+            }
+        }
+        return perturbed;
+    };
+
+    // the supernodes of a level are independent of each other. Levels with
+    // few supernodes, usually those close to the root, are processed one
+    // supernode at a time with parallel dense operations instead.
+    const auto num_threads = static_cast<IndexType>(omp_get_max_threads());
+    size_type total_perturbed{};
+    for (IndexType level = 0; level < num_levels; ++level) {
+        const auto begin = level_ptrs[level];
+        const auto end = level_ptrs[level + 1];
+        if (end - begin >= num_threads) {
+#pragma omp parallel for schedule(dynamic) reduction(+ : total_perturbed)
+            for (auto i = begin; i < end; ++i) {
+                total_perturbed += process(level_supernodes[i], false);
+            }
+        } else {
+            for (auto i = begin; i < end; ++i) {
+                total_perturbed += process(level_supernodes[i], true);
+            }
+        }
+    }
+    num_perturbed = total_perturbed;
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DIRECT_FACTORIZE_KERNEL);
+
+
+/**
+ * Solves the factorized system for a single column of the permuted right
+ * hand side stored in work. If `parallel` is set, the off-diagonal blocks of
+ * large supernodes are applied in parallel.
+ */
+template <typename ValueType, typename IndexType>
+void solve_column(const solver::SupernodalSymbolic<IndexType> &symbolic,
+                  const ValueType *factors, const IndexType *pivots,
+                  matrix::Dense<ValueType> *work, size_type col, bool parallel)
+{
+    const auto num_supernodes =
+        static_cast<IndexType>(symbolic.supernode_ptrs.get_num_elems() - 1);
+    const auto supernode_ptrs = symbolic.supernode_ptrs.get_const_data();
+    const auto front_ptrs = symbolic.front_ptrs.get_const_data();
+    const auto front_idxs = symbolic.front_idxs.get_const_data();
+    const auto factor_ptrs = symbolic.factor_ptrs.get_const_data();
+    const auto is_cholesky =
+        symbolic.type == solver::factorization_type::cholesky;
+    const auto use_threads = [&](IndexType m, IndexType size) {
+        return parallel && static_cast<size_type>(m - size) * size >=
+                               min_parallel_block_size;
+    };
+
+    // forward substitution with L
+    for (IndexType sn = 0; sn < num_supernodes; ++sn) {
+        const auto first = supernode_ptrs[sn];
+        const auto size = supernode_ptrs[sn + 1] - first;
+        const auto m = front_ptrs[sn + 1] - front_ptrs[sn];
+        const auto idxs = front_idxs + front_ptrs[sn];
+        const auto lower = factors + factor_ptrs[sn];
+        const auto at = [&](IndexType row, IndexType k) {
+            return lower[row + static_cast<size_type>(k) * m];
+        };
+        if (!is_cholesky) {
+            for (IndexType k = 0; k < size; ++k) {
+                if (pivots[first + k] != k) {
+                    std::swap(work->at(first + k, col),
+                              work->at(first + pivots[first + k], col));
+                }
+            }
+        }
+        for (IndexType k = 0; k < size; ++k) {
+            auto value = work->at(first + k, col);
+            for (IndexType j = 0; j < k; ++j) {
+                value -= at(k, j) * work->at(first + j, col);
+            }
+            work->at(first + k, col) = is_cholesky ? value / at(k, k) : value;
+        }
+#pragma omp parallel for if (use_threads(m, size))
+        for (auto i = size; i < m; ++i) {
+            auto sum = zero<ValueType>();
+            for (IndexType k = 0; k < size; ++k) {
+                sum += at(i, k) * work->at(first + k, col);
+            }
+            work->at(idxs[i], col) -= sum;
+        }
+    }
+    // backward substitution with U or L^H
+    for (auto sn = num_supernodes - 1; sn >= 0; --sn) {
+        const auto first = supernode_ptrs[sn];
+        const auto size = supernode_ptrs[sn + 1] - first;
+        const auto m = front_ptrs[sn + 1] - front_ptrs[sn];
+        const auto idxs = front_idxs + front_ptrs[sn];
+        const auto lower = factors + factor_ptrs[sn];
+        const auto upper = lower + static_cast<size_type>(m) * size;
+        const auto at = [&](IndexType row, IndexType k) {
+            return lower[row + static_cast<size_type>(k) * m];
+        };
+#pragma omp parallel for if (use_threads(m, size))
+        for (IndexType k = 0; k < size; ++k) {
+            auto sum = zero<ValueType>();
+            for (auto j = size; j < m; ++j) {
+                sum += (is_cholesky
+                            ? conj(at(j, k))
+                            : upper[k + static_cast<size_type>(j - size) *
+                                            size]) *
+                       work->at(idxs[j], col);
+            }
+            work->at(first + k, col) -= sum;
+        }
+        for (auto k = size - 1; k >= 0; --k) {
+            auto value = work->at(first + k, col);
+            for (auto j = k + 1; j < size; ++j) {
+                value -= (is_cholesky ? conj(at(j, k)) : at(k, j)) *
+                         work->at(first + j, col);
+            }
+            work->at(first + k, col) =
+                value / (is_cholesky ? conj(at(k, k)) : at(k, k));
+        }
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+void solve(std::shared_ptr<const OmpExecutor> exec,
+           const solver::SupernodalSymbolic<IndexType> &symbolic,
+           const Array<ValueType> &factors, const Array<IndexType> &pivots,
+           const matrix::Dense<ValueType> *b, matrix::Dense<ValueType> *work,
+           matrix::Dense<ValueType> *x)
+{
+    const auto perm = symbolic.permutation.get_const_data();
+    const auto num_rows = b->get_size()[0];
+    const auto num_rhs = b->get_size()[1];
+
+#pragma omp parallel for
+    for (size_type row = 0; row < num_rows; ++row) {
+        for (size_type col = 0; col < num_rhs; ++col) {
+            work->at(row, col) = b->at(perm[row], col);
+        }
+    }
+    // the right hand sides are independent, a single one is solved with
+    // parallel dense operations instead
+    if (num_rhs > 1) {
+#pragma omp parallel for
+        for (size_type col = 0; col < num_rhs; ++col) {
+            solve_column(symbolic, factors.get_const_data(),
+                         pivots.get_const_data(), work, col, false);
+        }
+    } else if (num_rhs == 1) {
+        solve_column(symbolic, factors.get_const_data(),
+                     pivots.get_const_data(), work, 0, true);
+    }
+#pragma omp parallel for
+    for (size_type row = 0; row < num_rows; ++row) {
+        for (size_type col = 0; col < num_rhs; ++col) {
+            x->at(perm[row], col) = work->at(row, col);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_DIRECT_SOLVE_KERNEL);
+
+
+}  // namespace direct
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
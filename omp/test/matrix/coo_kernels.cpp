@@ -343,4 +343,20 @@ TEST_F(Coo, OutplaceAbsoluteMatrixIsEquivalentToRef)
 }
 
 
+TEST_F(Coo, TransposeIsEquivalentToRef)
+{
+    set_up_apply_data();
+
+    auto trans = gko::as<Mtx>(mtx->transpose());
+    auto d_trans = gko::as<Mtx>(dmtx->transpose());
+
+    GKO_ASSERT_MTX_NEAR(d_trans, trans, 0.0);
+    GKO_ASSERT_ARRAY_EQ(
+        gko::Array<int>::view(omp, d_trans->get_num_stored_elements(),
+                              d_trans->get_row_idxs()),
+        gko::Array<int>::view(ref, trans->get_num_stored_elements(),
+                              trans->get_row_idxs()));
+}
+
+
 }  // namespace
@@ -42,6 +42,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 
 
+#include <omp.h>
+
+
 #include <ginkgo/core/base/exception.hpp>
 #include <ginkgo/core/base/executor.hpp>
 #include <ginkgo/core/matrix/coo.hpp>
@@ -335,6 +338,37 @@ TEST_F(Csr, TransposeIsEquivalentToRef)
 }
 
 
+TEST_F(Csr, TransposeWithManyThreadsIsEquivalentToRef)
+{
+    set_up_apply_data();
+    // the result must not depend on the number of threads
+    const auto num_threads = omp_get_max_threads();
+    omp_set_num_threads(7);
+
+    auto trans = gko::as<Mtx>(mtx->transpose());
+    auto d_trans = gko::as<Mtx>(dmtx->transpose());
+
+    omp_set_num_threads(num_threads);
+    GKO_ASSERT_MTX_NEAR(d_trans, trans, 0.0);
+    ASSERT_TRUE(d_trans->is_sorted_by_column_index());
+}
+
+
+TEST_F(Csr, TransposeWithEmptyRowsIsEquivalentToRef)
+{
+    auto sparse_mtx = gko::test::generate_random_matrix<Mtx>(
+        300, 700, std::uniform_int_distribution<>(0, 3),
+        std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+    auto d_sparse_mtx = gko::clone(omp, sparse_mtx);
+
+    auto trans = gko::as<Mtx>(sparse_mtx->transpose());
+    auto d_trans = gko::as<Mtx>(d_sparse_mtx->transpose());
+
+    GKO_ASSERT_MTX_NEAR(d_trans, trans, 0.0);
+    ASSERT_TRUE(d_trans->is_sorted_by_column_index());
+}
+
+
 TEST_F(Csr, ConjugateTransposeIsEquivalentToRef)
 {
     set_up_apply_data();
@@ -0,0 +1,125 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/fbcsr.hpp>
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+
+
+#include "core/matrix/fbcsr_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class Fbcsr : public ::testing::Test {
+protected:
+    using Mtx = gko::matrix::Fbcsr<>;
+    using ComplexMtx = gko::matrix::Fbcsr<std::complex<double>>;
+
+    Fbcsr() : rand_engine(42) {}
+
+    void SetUp()
+    {
+        ref = gko::ReferenceExecutor::create();
+        omp = gko::OmpExecutor::create();
+    }
+
+    void TearDown()
+    {
+        if (omp != nullptr) {
+            ASSERT_NO_THROW(omp->synchronize());
+        }
+    }
+
+    template <typename MtxType>
+    std::unique_ptr<MtxType> gen_mtx(int num_rows, int num_cols)
+    {
+        const auto data =
+            gko::test::generate_random_matrix<
+                gko::matrix::Csr<typename MtxType::value_type,
+                                 typename MtxType::index_type>>(
+                num_rows, num_cols, std::uniform_int_distribution<>(0, 10),
+                std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+        gko::matrix_data<typename MtxType::value_type,
+                         typename MtxType::index_type>
+            mtx_data;
+        data->write(mtx_data);
+        auto mtx = MtxType::create(ref, block_size);
+        mtx->read(mtx_data);
+        return mtx;
+    }
+
+    const int block_size = 3;
+
+    std::shared_ptr<gko::ReferenceExecutor> ref;
+    std::shared_ptr<const gko::OmpExecutor> omp;
+
+    std::ranlux48 rand_engine;
+};
+
+
+TEST_F(Fbcsr, TransposeIsEquivalentToRef)
+{
+    auto mtx = gen_mtx<Mtx>(123 * block_size, 97 * block_size);
+    auto dmtx = gko::clone(omp, mtx);
+
+    auto trans = gko::as<Mtx>(mtx->transpose());
+    auto d_trans = gko::as<Mtx>(dmtx->transpose());
+
+    GKO_ASSERT_MTX_NEAR(d_trans, trans, 0.0);
+    ASSERT_TRUE(gko::clone(ref, d_trans)->is_sorted_by_column_index());
+}
+
+
+TEST_F(Fbcsr, ConjugateTransposeIsEquivalentToRef)
+{
+    auto mtx = gen_mtx<ComplexMtx>(123 * block_size, 97 * block_size);
+    auto dmtx = gko::clone(omp, mtx);
+
+    auto trans = gko::as<ComplexMtx>(mtx->conj_transpose());
+    auto d_trans = gko::as<ComplexMtx>(dmtx->conj_transpose());
+
+    GKO_ASSERT_MTX_NEAR(d_trans, trans, 0.0);
+}
+
+
+}  // namespace
@@ -183,6 +183,41 @@ TEST_F(Hybrid, AdvancedApplyToDenseMatrixIsEquivalentToRef)
 }
 
 
+TEST_F(Hybrid, SimpleApplyWithEllAndCooIsEquivalentToRef)
+{
+    set_up_apply_data(1, std::make_shared<Mtx::imbalance_limit>(0.5));
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    ASSERT_GT(dmtx->get_ell_num_stored_elements_per_row(), 0);
+    ASSERT_GT(dmtx->get_coo_num_stored_elements(), 0);
+    GKO_ASSERT_MTX_NEAR(dresult, expected, 1e-14);
+}
+
+
+TEST_F(Hybrid, AdvancedApplyToDenseMatrixWithEllAndCooIsEquivalentToRef)
+{
+    set_up_apply_data(3, std::make_shared<Mtx::imbalance_limit>(0.5));
+
+    mtx->apply(alpha.get(), y.get(), beta.get(), expected.get());
+    dmtx->apply(dalpha.get(), dy.get(), dbeta.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, 1e-14);
+}
+
+
+TEST_F(Hybrid, SimpleApplyWithCpuStrategyIsEquivalentToRef)
+{
+    set_up_apply_data(2, std::make_shared<Mtx::automatic>(omp));
+
+    mtx->apply(y.get(), expected.get());
+    dmtx->apply(dy.get(), dresult.get());
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, 1e-14);
+}
+
+
 TEST_F(Hybrid, ApplyToComplexIsEquivalentToRef)
 {
     set_up_apply_data();
@@ -0,0 +1,281 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/stencil.hpp>
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
+
+
+#include "core/matrix/stencil_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class Stencil : public ::testing::Test {
+protected:
+    using value_type = double;
+    using Mtx = gko::matrix::Stencil<value_type>;
+    using Csr = gko::matrix::Csr<value_type, gko::int32>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    Stencil() : rand_engine(42) {}
+
+    void SetUp()
+    {
+        ref = gko::ReferenceExecutor::create();
+        omp = gko::OmpExecutor::create();
+    }
+
+    void TearDown()
+    {
+        if (omp != nullptr) {
+            ASSERT_NO_THROW(omp->synchronize());
+        }
+    }
+
+    std::unique_ptr<Vec> gen_vec(int num_rows, int num_cols)
+    {
+        return gko::test::generate_random_matrix<Vec>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+    }
+
+    void set_up_apply_data(gko::dim<3> grid, gko::matrix::stencil_shape shape,
+                           int num_points, bool variable, int num_rhs = 1)
+    {
+        const int num_rows = grid[0] * grid[1] * grid[2];
+        auto coeffs = gen_vec(variable ? num_points * num_rows : num_points, 1);
+        mtx = Mtx::create(
+            ref, grid, shape,
+            gko::Array<value_type>{
+                ref, coeffs->get_const_values(),
+                coeffs->get_const_values() + coeffs->get_size()[0]});
+        dmtx = gko::clone(omp, mtx);
+        b = gen_vec(num_rows, num_rhs);
+        x = gen_vec(num_rows, num_rhs);
+        alpha = gko::initialize<Vec>({2.0}, ref);
+        beta = gko::initialize<Vec>({-1.0}, ref);
+        db = gko::clone(omp, b);
+        dx = gko::clone(omp, x);
+        dalpha = gko::clone(omp, alpha);
+        dbeta = gko::clone(omp, beta);
+    }
+
+    std::shared_ptr<gko::ReferenceExecutor> ref;
+    std::shared_ptr<const gko::OmpExecutor> omp;
+
+    std::ranlux48 rand_engine;
+
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Vec> b;
+    std::unique_ptr<Vec> x;
+    std::unique_ptr<Vec> alpha;
+    std::unique_ptr<Vec> beta;
+
+    std::unique_ptr<Mtx> dmtx;
+    std::unique_ptr<Vec> db;
+    std::unique_ptr<Vec> dx;
+    std::unique_ptr<Vec> dalpha;
+    std::unique_ptr<Vec> dbeta;
+};
+
+
+TEST_F(Stencil, SimpleApply1DIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{1300, 1, 1},
+                      gko::matrix::stencil_shape::three_point_1d, 3, false);
+
+    mtx->apply(b.get(), x.get());
+    dmtx->apply(db.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(dx, x, 1e-14);
+}
+
+
+TEST_F(Stencil, SimpleApply1DWithManyBlocksIsEquivalentToRef)
+{
+    // use more threads than available to get real parallel splits of the line
+    const auto num_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    // the line consists of more blocks of 512 nodes than there are threads,
+    // and its length is not a multiple of the block size
+    set_up_apply_data(gko::dim<3>{512 * 11 + 37, 1, 1},
+                      gko::matrix::stencil_shape::three_point_1d, 3, true);
+
+    mtx->apply(b.get(), x.get());
+    dmtx->apply(db.get(), dx.get());
+
+    omp_set_num_threads(num_threads);
+    GKO_ASSERT_MTX_NEAR(dx, x, 1e-14);
+}
+
+
+TEST_F(Stencil, AdvancedApply2DWithManyBlocksIsEquivalentToRef)
+{
+    const auto num_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    set_up_apply_data(gko::dim<3>{512 * 3 + 101, 5, 1},
+                      gko::matrix::stencil_shape::nine_point_2d, 9, false, 2);
+
+    mtx->apply(alpha.get(), b.get(), beta.get(), x.get());
+    dmtx->apply(dalpha.get(), db.get(), dbeta.get(), dx.get());
+
+    omp_set_num_threads(num_threads);
+    GKO_ASSERT_MTX_NEAR(dx, x, 1e-14);
+}
+
+
+TEST_F(Stencil, SimpleApply2DIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{600, 7, 1},
+                      gko::matrix::stencil_shape::five_point_2d, 5, false);
+
+    mtx->apply(b.get(), x.get());
+    dmtx->apply(db.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(dx, x, 1e-14);
+}
+
+
+TEST_F(Stencil, SimpleApplyNinePointIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{37, 45, 1},
+                      gko::matrix::stencil_shape::nine_point_2d, 9, true);
+
+    mtx->apply(b.get(), x.get());
+    dmtx->apply(db.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(dx, x, 1e-14);
+}
+
+
+TEST_F(Stencil, SimpleApply3DIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{20, 13, 9},
+                      gko::matrix::stencil_shape::twenty_seven_point_3d, 27,
+                      true);
+
+    mtx->apply(b.get(), x.get());
+    dmtx->apply(db.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(dx, x, 1e-14);
+}
+
+
+TEST_F(Stencil, SimpleApplyToMultipleVectorsIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{530, 3, 4},
+                      gko::matrix::stencil_shape::seven_point_3d, 7, false, 3);
+
+    mtx->apply(b.get(), x.get());
+    dmtx->apply(db.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(dx, x, 1e-14);
+}
+
+
+TEST_F(Stencil, AdvancedApplyIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{530, 3, 4},
+                      gko::matrix::stencil_shape::seven_point_3d, 7, true, 2);
+
+    mtx->apply(alpha.get(), b.get(), beta.get(), x.get());
+    dmtx->apply(dalpha.get(), db.get(), dbeta.get(), dx.get());
+
+    GKO_ASSERT_MTX_NEAR(dx, x, 1e-14);
+}
+
+
+TEST_F(Stencil, ConvertToCsrIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{20, 13, 9},
+                      gko::matrix::stencil_shape::twenty_seven_point_3d, 27,
+                      true);
+    auto csr = Csr::create(ref);
+    auto dcsr = Csr::create(omp);
+
+    mtx->convert_to(csr.get());
+    dmtx->convert_to(dcsr.get());
+
+    GKO_ASSERT_MTX_NEAR(dcsr, csr, 0.0);
+    ASSERT_TRUE(dcsr->is_sorted_by_column_index());
+}
+
+
+TEST_F(Stencil, ConvertToCsrWithManyBlocksIsEquivalentToRef)
+{
+    const auto num_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    set_up_apply_data(gko::dim<3>{512 * 5 + 3, 2, 2},
+                      gko::matrix::stencil_shape::seven_point_3d, 7, true);
+    auto csr = Csr::create(ref);
+    auto dcsr = Csr::create(omp);
+
+    mtx->convert_to(csr.get());
+    dmtx->convert_to(dcsr.get());
+
+    omp_set_num_threads(num_threads);
+    GKO_ASSERT_MTX_NEAR(dcsr, csr, 0.0);
+    ASSERT_TRUE(dcsr->is_sorted_by_column_index());
+}
+
+
+TEST_F(Stencil, ExtractDiagonalIsEquivalentToRef)
+{
+    set_up_apply_data(gko::dim<3>{20, 13, 9},
+                      gko::matrix::stencil_shape::seven_point_3d, 7, true);
+
+    auto diag = mtx->extract_diagonal();
+    auto ddiag = dmtx->extract_diagonal();
+
+    GKO_ASSERT_MTX_NEAR(ddiag, diag, 0.0);
+}
+
+
+}  // namespace
@@ -0,0 +1,192 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/direct.hpp>
+
+
+#include <memory>
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/solver/direct_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class Direct : public ::testing::Test {
+protected:
+    using value_type = double;
+    using index_type = gko::int32;
+    using Mtx = gko::matrix::Dense<value_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Solver = gko::solver::Direct<value_type, index_type>;
+
+    Direct() : rand_engine(42) {}
+
+    void SetUp()
+    {
+        ref = gko::ReferenceExecutor::create();
+        omp = gko::OmpExecutor::create();
+    }
+
+    void TearDown()
+    {
+        if (omp != nullptr) {
+            ASSERT_NO_THROW(omp->synchronize());
+        }
+    }
+
+    /**
+     * Generates a diagonally dominant matrix with the sparsity pattern of the
+     * 5-point stencil on a square grid and random values.
+     */
+    std::shared_ptr<Csr> generate_grid(index_type size, bool symmetric)
+    {
+        std::uniform_real_distribution<value_type> dist(-1.0, 1.0);
+        gko::matrix_data<value_type, index_type> data{
+            gko::dim<2>(size * size)};
+        for (index_type i = 0; i < size; ++i) {
+            for (index_type j = 0; j < size; ++j) {
+                const auto row = i * size + j;
+                data.nonzeros.emplace_back(row, row, 5.0 + dist(rand_engine));
+                for (auto col : {row - size, row - 1}) {
+                    if (col < 0 || (col == row - 1 && j == 0)) {
+                        continue;
+                    }
+                    const auto value = dist(rand_engine);
+                    data.nonzeros.emplace_back(row, col, value);
+                    data.nonzeros.emplace_back(
+                        col, row, symmetric ? value : dist(rand_engine));
+                }
+            }
+        }
+        data.ensure_row_major_order();
+        auto result = gko::share(Csr::create(ref));
+        result->read(data);
+        return result;
+    }
+
+    std::unique_ptr<Mtx> generate_rhs(gko::size_type size,
+                                      gko::size_type num_rhs)
+    {
+        return gko::test::generate_random_matrix<Mtx>(
+            size, num_rhs, std::uniform_int_distribution<>(num_rhs, num_rhs),
+            std::normal_distribution<>(0.0, 1.0), rand_engine, ref);
+    }
+
+    void assert_equivalent_to_ref(gko::solver::factorization_type type,
+                                  bool symmetric, gko::size_type num_rhs)
+    {
+        auto mtx = generate_grid(30, symmetric);
+        auto b = generate_rhs(900, num_rhs);
+        auto x = Mtx::create(ref, gko::dim<2>{900, num_rhs});
+        auto d_b = gko::clone(omp, b);
+        auto d_x = Mtx::create(omp, gko::dim<2>{900, num_rhs});
+        auto solver =
+            Solver::build().with_factorization(type).on(ref)->generate(mtx);
+        auto d_solver =
+            Solver::build().with_factorization(type).on(omp)->generate(mtx);
+
+        solver->apply(b.get(), x.get());
+        d_solver->apply(d_b.get(), d_x.get());
+
+        GKO_ASSERT_MTX_NEAR(d_x, x, 1e-12);
+        ASSERT_EQ(d_solver->get_num_supernodes(), solver->get_num_supernodes());
+        ASSERT_EQ(d_solver->get_num_perturbed_pivots(),
+                  solver->get_num_perturbed_pivots());
+    }
+
+    std::shared_ptr<gko::ReferenceExecutor> ref;
+    std::shared_ptr<const gko::OmpExecutor> omp;
+
+    std::ranlux48 rand_engine;
+};
+
+
+TEST_F(Direct, OmpLuIsEquivalentToRef)
+{
+    assert_equivalent_to_ref(gko::solver::factorization_type::lu, false, 1);
+}
+
+
+TEST_F(Direct, OmpLuWithMultipleRhsIsEquivalentToRef)
+{
+    assert_equivalent_to_ref(gko::solver::factorization_type::lu, false, 5);
+}
+
+
+TEST_F(Direct, OmpCholeskyIsEquivalentToRef)
+{
+    assert_equivalent_to_ref(gko::solver::factorization_type::cholesky, true,
+                             1);
+}
+
+
+TEST_F(Direct, OmpCholeskyWithMultipleRhsIsEquivalentToRef)
+{
+    assert_equivalent_to_ref(gko::solver::factorization_type::cholesky, true,
+                             5);
+}
+
+
+TEST_F(Direct, OmpRefactorizeIsEquivalentToRef)
+{
+    auto mtx = generate_grid(30, false);
+    auto other = generate_grid(30, false);
+    auto b = generate_rhs(900, 1);
+    auto x = Mtx::create(ref, gko::dim<2>{900, 1});
+    auto d_b = gko::clone(omp, b);
+    auto d_x = Mtx::create(omp, gko::dim<2>{900, 1});
+    auto solver = Solver::build().on(ref)->generate(mtx);
+    auto d_solver = Solver::build().on(omp)->generate(mtx);
+
+    solver->refactorize(other);
+    d_solver->refactorize(other);
+    solver->apply(b.get(), x.get());
+    d_solver->apply(d_b.get(), d_x.get());
+
+    GKO_ASSERT_MTX_NEAR(d_x, x, 1e-12);
+}
+
+
+}  // namespace
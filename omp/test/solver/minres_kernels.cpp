@@ -0,0 +1,335 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/minres.hpp>
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
+
+
+#include "core/solver/minres_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class Minres : public ::testing::Test {
+protected:
+    using Mtx = gko::matrix::Dense<>;
+    using NormVector = gko::matrix::Dense<gko::remove_complex<double>>;
+    Minres() : rand_engine(30) {}
+
+    void SetUp()
+    {
+        ref = gko::ReferenceExecutor::create();
+        omp = gko::OmpExecutor::create();
+    }
+
+    void TearDown()
+    {
+        if (omp != nullptr) {
+            ASSERT_NO_THROW(omp->synchronize());
+        }
+    }
+
+    std::unique_ptr<Mtx> gen_mtx(int num_rows, int num_cols)
+    {
+        return gko::test::generate_random_matrix<Mtx>(
+            num_rows, num_cols,
+            std::uniform_int_distribution<>(num_cols, num_cols),
+            std::normal_distribution<>(-1.0, 1.0), rand_engine, ref);
+    }
+
+    std::unique_ptr<Mtx> gen_positive(int num_cols)
+    {
+        return gko::test::generate_random_matrix<Mtx>(
+            1, num_cols, std::uniform_int_distribution<>(num_cols, num_cols),
+            std::uniform_real_distribution<>(0.5, 1.0), rand_engine, ref);
+    }
+
+    void initialize_data()
+    {
+        int m = 597;
+        int n = 43;
+        b = gen_mtx(m, n);
+        r = gen_mtx(m, n);
+        r_prev = gen_mtx(m, n);
+        z = gen_mtx(m, n);
+        q = gen_mtx(m, n);
+        w = gen_mtx(m, n);
+        w_prev = gen_mtx(m, n);
+        x = gen_mtx(m, n);
+        alpha = gen_mtx(1, n);
+        beta = gen_positive(n);
+        prev_beta = gen_positive(n);
+        delta_bar = gen_mtx(1, n);
+        eps = gen_mtx(1, n);
+        cos = gen_mtx(1, n);
+        sin = gen_mtx(1, n);
+        phi_bar = gen_positive(n);
+        residual_norm = NormVector::create(ref, gko::dim<2>{1, n});
+        residual_norm->fill(0.0);
+        stop_status = std::unique_ptr<gko::Array<gko::stopping_status>>(
+            new gko::Array<gko::stopping_status>(ref, n));
+        for (size_t i = 0; i < stop_status->get_num_elems(); ++i) {
+            stop_status->get_data()[i].reset();
+        }
+        // check correct handling for stopped columns
+        stop_status->get_data()[1].stop(1);
+
+        d_b = gko::clone(omp, b);
+        d_r = gko::clone(omp, r);
+        d_r_prev = gko::clone(omp, r_prev);
+        d_z = gko::clone(omp, z);
+        d_q = gko::clone(omp, q);
+        d_w = gko::clone(omp, w);
+        d_w_prev = gko::clone(omp, w_prev);
+        d_x = gko::clone(omp, x);
+        d_alpha = gko::clone(omp, alpha);
+        d_beta = gko::clone(omp, beta);
+        d_prev_beta = gko::clone(omp, prev_beta);
+        d_delta_bar = gko::clone(omp, delta_bar);
+        d_eps = gko::clone(omp, eps);
+        d_cos = gko::clone(omp, cos);
+        d_sin = gko::clone(omp, sin);
+        d_phi_bar = gko::clone(omp, phi_bar);
+        d_residual_norm = gko::clone(omp, residual_norm);
+        d_stop_status = std::unique_ptr<gko::Array<gko::stopping_status>>(
+            new gko::Array<gko::stopping_status>(omp, *stop_status));
+    }
+
+    void make_symetric(Mtx *mtx)
+    {
+        for (int i = 0; i < mtx->get_size()[0]; ++i) {
+            for (int j = i + 1; j < mtx->get_size()[1]; ++j) {
+                mtx->at(i, j) = mtx->at(j, i);
+            }
+        }
+    }
+
+    void make_diag_dominant(Mtx *mtx)
+    {
+        using std::abs;
+        for (int i = 0; i < mtx->get_size()[0]; ++i) {
+            auto sum = gko::zero<Mtx::value_type>();
+            for (int j = 0; j < mtx->get_size()[1]; ++j) {
+                sum += abs(mtx->at(i, j));
+            }
+            mtx->at(i, i) = sum;
+        }
+    }
+
+    void make_spd(Mtx *mtx)
+    {
+        make_symetric(mtx);
+        make_diag_dominant(mtx);
+    }
+
+    std::shared_ptr<gko::ReferenceExecutor> ref;
+    std::shared_ptr<const gko::OmpExecutor> omp;
+
+    std::ranlux48 rand_engine;
+
+    std::unique_ptr<Mtx> b;
+    std::unique_ptr<Mtx> r;
+    std::unique_ptr<Mtx> r_prev;
+    std::unique_ptr<Mtx> z;
+    std::unique_ptr<Mtx> q;
+    std::unique_ptr<Mtx> w;
+    std::unique_ptr<Mtx> w_prev;
+    std::unique_ptr<Mtx> x;
+    std::unique_ptr<Mtx> alpha;
+    std::unique_ptr<Mtx> beta;
+    std::unique_ptr<Mtx> prev_beta;
+    std::unique_ptr<Mtx> delta_bar;
+    std::unique_ptr<Mtx> eps;
+    std::unique_ptr<Mtx> cos;
+    std::unique_ptr<Mtx> sin;
+    std::unique_ptr<Mtx> phi_bar;
+    std::unique_ptr<NormVector> residual_norm;
+    std::unique_ptr<gko::Array<gko::stopping_status>> stop_status;
+
+    std::unique_ptr<Mtx> d_b;
+    std::unique_ptr<Mtx> d_r;
+    std::unique_ptr<Mtx> d_r_prev;
+    std::unique_ptr<Mtx> d_z;
+    std::unique_ptr<Mtx> d_q;
+    std::unique_ptr<Mtx> d_w;
+    std::unique_ptr<Mtx> d_w_prev;
+    std::unique_ptr<Mtx> d_x;
+    std::unique_ptr<Mtx> d_alpha;
+    std::unique_ptr<Mtx> d_beta;
+    std::unique_ptr<Mtx> d_prev_beta;
+    std::unique_ptr<Mtx> d_delta_bar;
+    std::unique_ptr<Mtx> d_eps;
+    std::unique_ptr<Mtx> d_cos;
+    std::unique_ptr<Mtx> d_sin;
+    std::unique_ptr<Mtx> d_phi_bar;
+    std::unique_ptr<NormVector> d_residual_norm;
+    std::unique_ptr<gko::Array<gko::stopping_status>> d_stop_status;
+};
+
+
+TEST_F(Minres, OmpMinresInitialize1IsEquivalentToRef)
+{
+    initialize_data();
+
+    gko::kernels::reference::minres::initialize_1(
+        ref, b.get(), r.get(), r_prev.get(), w.get(), w_prev.get(),
+        prev_beta.get(), delta_bar.get(), eps.get(), cos.get(), sin.get(),
+        stop_status.get());
+    gko::kernels::omp::minres::initialize_1(
+        omp, d_b.get(), d_r.get(), d_r_prev.get(), d_w.get(), d_w_prev.get(),
+        d_prev_beta.get(), d_delta_bar.get(), d_eps.get(), d_cos.get(),
+        d_sin.get(), d_stop_status.get());
+
+    GKO_ASSERT_MTX_NEAR(d_r, r, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_r_prev, r_prev, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_w, w, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_w_prev, w_prev, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_prev_beta, prev_beta, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_delta_bar, delta_bar, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_eps, eps, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_cos, cos, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_sin, sin, 1e-14);
+    GKO_ASSERT_ARRAY_EQ(*d_stop_status, *stop_status);
+}
+
+
+TEST_F(Minres, OmpMinresInitialize2IsEquivalentToRef)
+{
+    initialize_data();
+
+    gko::kernels::reference::minres::initialize_2(
+        ref, beta.get(), phi_bar.get(), residual_norm.get());
+    gko::kernels::omp::minres::initialize_2(
+        omp, d_beta.get(), d_phi_bar.get(), d_residual_norm.get());
+
+    GKO_ASSERT_MTX_NEAR(d_beta, beta, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_phi_bar, phi_bar, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_residual_norm, residual_norm, 1e-14);
+}
+
+
+TEST_F(Minres, OmpMinresStep1IsEquivalentToRef)
+{
+    initialize_data();
+
+    gko::kernels::reference::minres::step_1(
+        ref, q.get(), z.get(), r.get(), r_prev.get(), alpha.get(), beta.get(),
+        prev_beta.get(), stop_status.get());
+    gko::kernels::omp::minres::step_1(
+        omp, d_q.get(), d_z.get(), d_r.get(), d_r_prev.get(), d_alpha.get(),
+        d_beta.get(), d_prev_beta.get(), d_stop_status.get());
+
+    GKO_ASSERT_MTX_NEAR(d_q, q, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_r_prev, r_prev, 1e-14);
+}
+
+
+TEST_F(Minres, OmpMinresStep2IsEquivalentToRef)
+{
+    initialize_data();
+
+    gko::kernels::reference::minres::step_2(
+        ref, x.get(), q.get(), w.get(), w_prev.get(), alpha.get(), beta.get(),
+        prev_beta.get(), delta_bar.get(), eps.get(), cos.get(), sin.get(),
+        phi_bar.get(), residual_norm.get(), stop_status.get());
+    gko::kernels::omp::minres::step_2(
+        omp, d_x.get(), d_q.get(), d_w.get(), d_w_prev.get(), d_alpha.get(),
+        d_beta.get(), d_prev_beta.get(), d_delta_bar.get(), d_eps.get(),
+        d_cos.get(), d_sin.get(), d_phi_bar.get(), d_residual_norm.get(),
+        d_stop_status.get());
+
+    GKO_ASSERT_MTX_NEAR(d_x, x, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_w_prev, w_prev, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_prev_beta, prev_beta, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_delta_bar, delta_bar, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_eps, eps, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_cos, cos, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_sin, sin, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_phi_bar, phi_bar, 1e-14);
+    GKO_ASSERT_MTX_NEAR(d_residual_norm, residual_norm, 1e-14);
+}
+
+
+TEST_F(Minres, ApplyIsEquivalentToRef)
+{
+    auto mtx = gen_mtx(50, 50);
+    make_spd(mtx.get());
+    auto x = gen_mtx(50, 3);
+    auto b = gen_mtx(50, 3);
+    auto d_mtx = Mtx::create(omp);
+    d_mtx->copy_from(mtx.get());
+    auto d_x = Mtx::create(omp);
+    d_x->copy_from(x.get());
+    auto d_b = Mtx::create(omp);
+    d_b->copy_from(b.get());
+    auto minres_factory =
+        gko::solver::Minres<>::build()
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(50u).on(ref),
+                gko::stop::ResidualNorm<>::build()
+                    .with_reduction_factor(1e-14)
+                    .on(ref))
+            .on(ref);
+    auto d_minres_factory =
+        gko::solver::Minres<>::build()
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(50u).on(omp),
+                gko::stop::ResidualNorm<>::build()
+                    .with_reduction_factor(1e-14)
+                    .on(omp))
+            .on(omp);
+    auto solver = minres_factory->generate(std::move(mtx));
+    auto d_solver = d_minres_factory->generate(std::move(d_mtx));
+
+    solver->apply(b.get(), x.get());
+    d_solver->apply(d_b.get(), d_x.get());
+
+    GKO_ASSERT_MTX_NEAR(d_x, x, 1e-14);
+}
+
+
+}  // namespace
@@ -56,6 +56,79 @@ namespace reference {
 namespace hybrid {
 
 
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const ReferenceExecutor> exec,
+          const matrix::Hybrid<ValueType, IndexType> *a,
+          const matrix::Dense<ValueType> *b, matrix::Dense<ValueType> *c)
+{
+    const auto ell_num_stored_elements_per_row =
+        a->get_ell_num_stored_elements_per_row();
+    const auto coo_val = a->get_const_coo_values();
+    const auto coo_col = a->get_const_coo_col_idxs();
+    const auto coo_row = a->get_const_coo_row_idxs();
+
+    for (size_type row = 0; row < a->get_size()[0]; row++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) = zero<ValueType>();
+        }
+        for (size_type i = 0; i < ell_num_stored_elements_per_row; i++) {
+            const auto val = a->ell_val_at(row, i);
+            const auto col = a->ell_col_at(row, i);
+            for (size_type j = 0; j < c->get_size()[1]; j++) {
+                c->at(row, j) += val * b->at(col, j);
+            }
+        }
+    }
+    for (size_type i = 0; i < a->get_coo_num_stored_elements(); i++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(coo_row[i], j) += coo_val[i] * b->at(coo_col[i], j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_HYBRID_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
+                   const matrix::Dense<ValueType> *alpha,
+                   const matrix::Hybrid<ValueType, IndexType> *a,
+                   const matrix::Dense<ValueType> *b,
+                   const matrix::Dense<ValueType> *beta,
+                   matrix::Dense<ValueType> *c)
+{
+    const auto ell_num_stored_elements_per_row =
+        a->get_ell_num_stored_elements_per_row();
+    const auto coo_val = a->get_const_coo_values();
+    const auto coo_col = a->get_const_coo_col_idxs();
+    const auto coo_row = a->get_const_coo_row_idxs();
+    const auto alpha_val = alpha->at(0, 0);
+    const auto beta_val = beta->at(0, 0);
+
+    for (size_type row = 0; row < a->get_size()[0]; row++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(row, j) *= beta_val;
+        }
+        for (size_type i = 0; i < ell_num_stored_elements_per_row; i++) {
+            const auto val = a->ell_val_at(row, i);
+            const auto col = a->ell_col_at(row, i);
+            for (size_type j = 0; j < c->get_size()[1]; j++) {
+                c->at(row, j) += alpha_val * val * b->at(col, j);
+            }
+        }
+    }
+    for (size_type i = 0; i < a->get_coo_num_stored_elements(); i++) {
+        for (size_type j = 0; j < c->get_size()[1]; j++) {
+            c->at(coo_row[i], j) +=
+                alpha_val * coo_val[i] * b->at(coo_col[i], j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_HYBRID_ADVANCED_SPMV_KERNEL);
+
+
 template <typename ValueType, typename IndexType>
 void convert_to_dense(std::shared_ptr<const ReferenceExecutor> exec,
                       const matrix::Hybrid<ValueType, IndexType> *source,
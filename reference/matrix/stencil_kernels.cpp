@@ -0,0 +1,229 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/matrix/stencil_kernels.hpp"
+
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The Stencil matrix format namespace.
+ *
+ * @ingroup stencil
+ */
+namespace stencil {
+namespace {
+
+
+/**
+ * Returns the row of the neighbor of node (x, y, z) described by the stencil
+ * point `point`, or -1 if the neighbor lies outside of the grid.
+ */
+template <typename ValueType>
+int64 get_neighbor(const matrix::Stencil<ValueType> *a, size_type point,
+                   int64 x, int64 y, int64 z)
+{
+    const auto grid = a->get_grid_size();
+    const auto offsets = a->get_const_offsets() + 3 * point;
+    const auto nx = x + offsets[0];
+    const auto ny = y + offsets[1];
+    const auto nz = z + offsets[2];
+    if (nx < 0 || ny < 0 || nz < 0 || nx >= static_cast<int64>(grid[0]) ||
+        ny >= static_cast<int64>(grid[1]) ||
+        nz >= static_cast<int64>(grid[2])) {
+        return -1;
+    }
+    return nx + static_cast<int64>(grid[0]) *
+                    (ny + static_cast<int64>(grid[1]) * nz);
+}
+
+
+template <typename ValueType>
+ValueType get_coefficient(const matrix::Stencil<ValueType> *a,
+                          size_type point, size_type row)
+{
+    return a->has_variable_coefficients()
+               ? a->get_const_coefficients()[point * a->get_size()[0] + row]
+               : a->get_const_coefficients()[point];
+}
+
+
+/**
+ * Calls `op(row, col, coefficient)` for each entry of the stencil matrix, in
+ * row-major order and with sorted column indices.
+ */
+template <typename ValueType, typename Op>
+void for_each_entry(const matrix::Stencil<ValueType> *a, Op op)
+{
+    const auto grid = a->get_grid_size();
+    const auto num_points = a->get_num_points();
+    const auto offsets = a->get_const_offsets();
+    // the column offset of a point does not depend on the row, so we can sort
+    // the points by it once to get sorted rows
+    std::vector<size_type> order(num_points);
+    std::iota(order.begin(), order.end(), size_type{});
+    const auto linear_offset = [&](size_type point) {
+        return offsets[3 * point] +
+               static_cast<int64>(grid[0]) *
+                   (offsets[3 * point + 1] +
+                    static_cast<int64>(grid[1]) * offsets[3 * point + 2]);
+    };
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_type p1, size_type p2) {
+                         return linear_offset(p1) < linear_offset(p2);
+                     });
+    size_type row{};
+    for (size_type z = 0; z < grid[2]; ++z) {
+        for (size_type y = 0; y < grid[1]; ++y) {
+            for (size_type x = 0; x < grid[0]; ++x) {
+                for (auto point : order) {
+                    const auto col = get_neighbor(a, point, x, y, z);
+                    if (col >= 0) {
+                        op(row, static_cast<size_type>(col),
+                           get_coefficient(a, point, row));
+                    }
+                }
+                ++row;
+            }
+        }
+    }
+}
+
+
+}  // namespace
+
+
+template <typename ValueType>
+void spmv(std::shared_ptr<const ReferenceExecutor> exec,
+          const matrix::Stencil<ValueType> *a,
+          const matrix::Dense<ValueType> *b, matrix::Dense<ValueType> *c)
+{
+    for (size_type row = 0; row < c->get_size()[0]; ++row) {
+        for (size_type j = 0; j < c->get_size()[1]; ++j) {
+            c->at(row, j) = zero<ValueType>();
+        }
+    }
+    for_each_entry(a, [&](size_type row, size_type col, ValueType val) {
+        for (size_type j = 0; j < c->get_size()[1]; ++j) {
+            c->at(row, j) += val * b->at(col, j);
+        }
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_STENCIL_SPMV_KERNEL);
+
+
+template <typename ValueType>
+void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
+                   const matrix::Dense<ValueType> *alpha,
+                   const matrix::Stencil<ValueType> *a,
+                   const matrix::Dense<ValueType> *b,
+                   const matrix::Dense<ValueType> *beta,
+                   matrix::Dense<ValueType> *c)
+{
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    for (size_type row = 0; row < c->get_size()[0]; ++row) {
+        for (size_type j = 0; j < c->get_size()[1]; ++j) {
+            c->at(row, j) *= vbeta;
+        }
+    }
+    for_each_entry(a, [&](size_type row, size_type col, ValueType val) {
+        for (size_type j = 0; j < c->get_size()[1]; ++j) {
+            c->at(row, j) += valpha * val * b->at(col, j);
+        }
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_STENCIL_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType>
+void extract_diagonal(std::shared_ptr<const ReferenceExecutor> exec,
+                      const matrix::Stencil<ValueType> *orig,
+                      matrix::Diagonal<ValueType> *diag)
+{
+    const auto diag_values = diag->get_values();
+    std::fill_n(diag_values, diag->get_size()[0], zero<ValueType>());
+    for_each_entry(orig, [&](size_type row, size_type col, ValueType val) {
+        if (row == col) {
+            diag_values[row] += val;
+        }
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(
+    GKO_DECLARE_STENCIL_EXTRACT_DIAGONAL_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void convert_to_csr(std::shared_ptr<const ReferenceExecutor> exec,
+                    const matrix::Stencil<ValueType> *source,
+                    matrix::Csr<ValueType, IndexType> *result)
+{
+    const auto row_ptrs = result->get_row_ptrs();
+    const auto col_idxs = result->get_col_idxs();
+    const auto values = result->get_values();
+    std::fill_n(row_ptrs, source->get_size()[0] + 1, IndexType{});
+    IndexType nz{};
+    for_each_entry(source, [&](size_type row, size_type col, ValueType val) {
+        col_idxs[nz] = static_cast<IndexType>(col);
+        values[nz] = val;
+        ++nz;
+        row_ptrs[row + 1] = nz;
+    });
+    // fill in the row pointers of rows without entries
+    for (size_type row = 0; row < source->get_size()[0]; ++row) {
+        row_ptrs[row + 1] = std::max(row_ptrs[row + 1], row_ptrs[row]);
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_STENCIL_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace stencil
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
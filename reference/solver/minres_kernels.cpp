@@ -0,0 +1,191 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include "core/solver/minres_kernels.hpp"
+
+
+#include <limits>
+
+
+#include <ginkgo/core/base/math.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The MINRES solver namespace.
+ *
+ * @ingroup minres
+ */
+namespace minres {
+
+
+template <typename ValueType>
+void initialize_1(std::shared_ptr<const ReferenceExecutor> exec,
+                  const matrix::Dense<ValueType> *b,
+                  matrix::Dense<ValueType> *r, matrix::Dense<ValueType> *r_prev,
+                  matrix::Dense<ValueType> *w, matrix::Dense<ValueType> *w_prev,
+                  matrix::Dense<ValueType> *prev_beta,
+                  matrix::Dense<ValueType> *delta_bar,
+                  matrix::Dense<ValueType> *eps, matrix::Dense<ValueType> *cos,
+                  matrix::Dense<ValueType> *sin,
+                  Array<stopping_status> *stop_status)
+{
+    for (size_type j = 0; j < b->get_size()[1]; ++j) {
+        prev_beta->at(0, j) = zero<ValueType>();
+        delta_bar->at(0, j) = zero<ValueType>();
+        eps->at(0, j) = zero<ValueType>();
+        cos->at(0, j) = -one<ValueType>();
+        sin->at(0, j) = zero<ValueType>();
+        stop_status->get_data()[j].reset();
+    }
+    for (size_type i = 0; i < b->get_size()[0]; ++i) {
+        for (size_type j = 0; j < b->get_size()[1]; ++j) {
+            r->at(i, j) = b->at(i, j);
+            r_prev->at(i, j) = zero<ValueType>();
+            w->at(i, j) = zero<ValueType>();
+            w_prev->at(i, j) = zero<ValueType>();
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_INITIALIZE_1_KERNEL);
+
+
+template <typename ValueType>
+void initialize_2(std::shared_ptr<const ReferenceExecutor> exec,
+                  matrix::Dense<ValueType> *beta,
+                  matrix::Dense<ValueType> *phi_bar,
+                  matrix::Dense<remove_complex<ValueType>> *residual_norm)
+{
+    for (size_type j = 0; j < beta->get_size()[1]; ++j) {
+        const auto norm = sqrt(abs(real(beta->at(0, j))));
+        beta->at(0, j) = norm;
+        phi_bar->at(0, j) = norm;
+        residual_norm->at(0, j) = norm;
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_INITIALIZE_2_KERNEL);
+
+
+template <typename ValueType>
+void step_1(std::shared_ptr<const ReferenceExecutor> exec,
+            matrix::Dense<ValueType> *q, const matrix::Dense<ValueType> *z,
+            const matrix::Dense<ValueType> *r, matrix::Dense<ValueType> *r_prev,
+            const matrix::Dense<ValueType> *alpha,
+            const matrix::Dense<ValueType> *beta,
+            const matrix::Dense<ValueType> *prev_beta,
+            const Array<stopping_status> *stop_status)
+{
+    for (size_type i = 0; i < q->get_size()[0]; ++i) {
+        for (size_type j = 0; j < q->get_size()[1]; ++j) {
+            if (stop_status->get_const_data()[j].has_stopped() ||
+                beta->at(0, j) == zero<ValueType>()) {
+                continue;
+            }
+            // the next Lanczos vector, with q = A z and z = M r
+            const auto tmp =
+                alpha->at(0, j) / (beta->at(0, j) * beta->at(0, j));
+            auto next = (q->at(i, j) - tmp * r->at(i, j)) / beta->at(0, j);
+            if (prev_beta->at(0, j) != zero<ValueType>()) {
+                next -= beta->at(0, j) / prev_beta->at(0, j) * r_prev->at(i, j);
+            }
+            r_prev->at(i, j) = next;
+            q->at(i, j) = z->at(i, j) / beta->at(0, j);
+        }
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_STEP_1_KERNEL);
+
+
+template <typename ValueType>
+void step_2(std::shared_ptr<const ReferenceExecutor> exec,
+            matrix::Dense<ValueType> *x, const matrix::Dense<ValueType> *v,
+            const matrix::Dense<ValueType> *w, matrix::Dense<ValueType> *w_prev,
+            const matrix::Dense<ValueType> *alpha,
+            const matrix::Dense<ValueType> *beta,
+            matrix::Dense<ValueType> *next_beta,
+            matrix::Dense<ValueType> *delta_bar, matrix::Dense<ValueType> *eps,
+            matrix::Dense<ValueType> *cos, matrix::Dense<ValueType> *sin,
+            matrix::Dense<ValueType> *phi_bar,
+            matrix::Dense<remove_complex<ValueType>> *residual_norm,
+            const Array<stopping_status> *stop_status)
+{
+    using real_type = remove_complex<ValueType>;
+    for (size_type j = 0; j < x->get_size()[1]; ++j) {
+        const auto current_beta = real(beta->at(0, j));
+        if (stop_status->get_const_data()[j].has_stopped() ||
+            current_beta == zero<real_type>()) {
+            continue;
+        }
+        // apply the previous rotation to the new column of the tridiagonal
+        // matrix and compute the rotation eliminating its subdiagonal entry
+        const auto diag = real(alpha->at(0, j)) / (current_beta * current_beta);
+        const auto new_beta = sqrt(abs(real(next_beta->at(0, j))));
+        const auto prev_cos = real(cos->at(0, j));
+        const auto prev_sin = real(sin->at(0, j));
+        const auto prev_delta_bar = real(delta_bar->at(0, j));
+        const auto prev_eps = real(eps->at(0, j));
+        const auto delta = prev_cos * prev_delta_bar + prev_sin * diag;
+        const auto gamma_bar = prev_sin * prev_delta_bar - prev_cos * diag;
+        auto gamma = sqrt(gamma_bar * gamma_bar + new_beta * new_beta);
+        gamma = max(gamma, std::numeric_limits<real_type>::epsilon());
+        const auto new_cos = gamma_bar / gamma;
+        const auto new_sin = new_beta / gamma;
+        const auto phi = new_cos * real(phi_bar->at(0, j));
+        for (size_type i = 0; i < x->get_size()[0]; ++i) {
+            // w_prev = (v - eps * w_prev - delta * w) / gamma
+            w_prev->at(i, j) = (v->at(i, j) - prev_eps * w_prev->at(i, j) -
+                                delta * w->at(i, j)) /
+                               gamma;
+            x->at(i, j) += phi * w_prev->at(i, j);
+        }
+        next_beta->at(0, j) = new_beta;
+        delta_bar->at(0, j) = -prev_cos * new_beta;
+        eps->at(0, j) = prev_sin * new_beta;
+        cos->at(0, j) = new_cos;
+        sin->at(0, j) = new_sin;
+        phi_bar->at(0, j) = new_sin * real(phi_bar->at(0, j));
+        residual_norm->at(0, j) = abs(real(phi_bar->at(0, j)));
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_MINRES_STEP_2_KERNEL);
+
+
+}  // namespace minres
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
@@ -388,4 +388,62 @@ TYPED_TEST(ParIct, GenerateWithApproxLargeLimit)
 }
 
 
+TYPED_TEST(ParIct, RefactorizesWithFixedPattern)
+{
+    using factorization_type = typename TestFixture::factorization_type;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    auto scaled = [&](const gko::LinOp *mtx, value_type factor) {
+        auto result = gko::share(Dense::create(this->exec));
+        gko::as<gko::ConvertibleTo<Dense>>(mtx)->convert_to(result.get());
+        result->scale(gko::initialize<Dense>({factor}, this->exec).get());
+        return result;
+    };
+    auto fact = factorization_type::build()
+                    .with_approximate_select(false)
+                    .with_fill_in_limit(1.2)
+                    .on(this->exec)
+                    ->generate(this->mtx_system);
+    auto l_factor = fact->get_l_factor();
+    auto lt_factor = fact->get_lt_factor();
+
+    fact->refactorize(scaled(this->mtx_system.get(), 4.0));
+
+    ASSERT_EQ(fact->get_l_factor(), l_factor);
+    ASSERT_EQ(fact->get_lt_factor(), lt_factor);
+    auto l_expected = scaled(this->mtx_l_large_expect.get(), 2.0);
+    GKO_ASSERT_MTX_NEAR(l_factor, l_expected, this->tol);
+    GKO_ASSERT_MTX_NEAR(lt_factor, gko::as<Dense>(l_expected->transpose()),
+                        this->tol);
+}
+
+
+TYPED_TEST(ParIct, RefactorizesWithNewPattern)
+{
+    using factorization_type = typename TestFixture::factorization_type;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    auto scaled = [&](const gko::LinOp *mtx, value_type factor) {
+        auto result = gko::share(Dense::create(this->exec));
+        gko::as<gko::ConvertibleTo<Dense>>(mtx)->convert_to(result.get());
+        result->scale(gko::initialize<Dense>({factor}, this->exec).get());
+        return result;
+    };
+    auto fact = factorization_type::build()
+                    .with_approximate_select(false)
+                    .with_fill_in_limit(1.2)
+                    .on(this->exec)
+                    ->generate(this->mtx_system);
+    auto l_factor = fact->get_l_factor();
+
+    fact->refactorize(scaled(this->mtx_system.get(), 4.0), false);
+
+    ASSERT_NE(fact->get_l_factor(), l_factor);
+    auto l_expected = scaled(this->mtx_l_large_expect.get(), 2.0);
+    GKO_ASSERT_MTX_NEAR(fact->get_l_factor(), l_expected, this->tol);
+    GKO_ASSERT_MTX_NEAR(fact->get_lt_factor(),
+                        gko::as<Dense>(l_expected->transpose()), this->tol);
+}
+
+
 }  // namespace
@@ -754,4 +754,34 @@ TYPED_TEST(ParIlu, GenerateForReverseCsrSmall)
 }
 
 
+TYPED_TEST(ParIlu, RefactorizesWithSamePattern)
+{
+    using value_type = typename TestFixture::value_type;
+    auto factors = this->ilu_factory_skip->generate(this->mtx_big_nodiag);
+    auto l_factor = factors->get_l_factor();
+    auto u_factor = factors->get_u_factor();
+
+    factors->refactorize(this->mtx_big);
+
+    ASSERT_EQ(factors->get_l_factor(), l_factor);
+    ASSERT_EQ(factors->get_u_factor(), u_factor);
+    GKO_ASSERT_MTX_NEAR(l_factor, this->big_l_expected, r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(u_factor, this->big_u_expected, r<value_type>::value);
+}
+
+
+TYPED_TEST(ParIlu, RefactorizationThrowsForDifferentPattern)
+{
+    using Csr = typename TestFixture::Csr;
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto factors = this->ilu_factory_skip->generate(this->mtx_big);
+    auto diag = gko::share(Csr::create(this->exec));
+    diag->read(gko::matrix_data<value_type, index_type>::diag(
+        gko::dim<2>{6, 6}, gko::one<value_type>()));
+
+    ASSERT_THROW(factors->refactorize(diag), gko::ValueMismatch);
+}
+
+
 }  // namespace
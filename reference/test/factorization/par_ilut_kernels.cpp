@@ -672,4 +672,61 @@ TYPED_TEST(ParIlut, GenerateWithApproxLargeLimit)
 }
 
 
+TYPED_TEST(ParIlut, RefactorizesWithFixedPattern)
+{
+    using factorization_type = typename TestFixture::factorization_type;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    auto scaled = [&](const gko::LinOp *mtx, value_type factor) {
+        auto result = gko::share(Dense::create(this->exec));
+        gko::as<gko::ConvertibleTo<Dense>>(mtx)->convert_to(result.get());
+        result->scale(gko::initialize<Dense>({factor}, this->exec).get());
+        return result;
+    };
+    auto fact = factorization_type::build()
+                    .with_approximate_select(false)
+                    .with_fill_in_limit(1.2)
+                    .on(this->exec)
+                    ->generate(this->mtx_system);
+    auto l_factor = fact->get_l_factor();
+    auto u_factor = fact->get_u_factor();
+
+    fact->refactorize(scaled(this->mtx_system.get(), 2.0));
+
+    ASSERT_EQ(fact->get_l_factor(), l_factor);
+    ASSERT_EQ(fact->get_u_factor(), u_factor);
+    GKO_ASSERT_MTX_NEAR(l_factor, this->mtx_l_large_expect, this->tol);
+    GKO_ASSERT_MTX_NEAR(u_factor, scaled(this->mtx_u_large_expect.get(), 2.0),
+                        this->tol);
+}
+
+
+TYPED_TEST(ParIlut, RefactorizesWithNewPattern)
+{
+    using factorization_type = typename TestFixture::factorization_type;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    auto scaled = [&](const gko::LinOp *mtx, value_type factor) {
+        auto result = gko::share(Dense::create(this->exec));
+        gko::as<gko::ConvertibleTo<Dense>>(mtx)->convert_to(result.get());
+        result->scale(gko::initialize<Dense>({factor}, this->exec).get());
+        return result;
+    };
+    auto fact = factorization_type::build()
+                    .with_approximate_select(false)
+                    .with_fill_in_limit(1.2)
+                    .on(this->exec)
+                    ->generate(this->mtx_system);
+    auto l_factor = fact->get_l_factor();
+
+    fact->refactorize(scaled(this->mtx_system.get(), 2.0), false);
+
+    ASSERT_NE(fact->get_l_factor(), l_factor);
+    GKO_ASSERT_MTX_NEAR(fact->get_l_factor(), this->mtx_l_large_expect,
+                        this->tol);
+    GKO_ASSERT_MTX_NEAR(fact->get_u_factor(),
+                        scaled(this->mtx_u_large_expect.get(), 2.0), this->tol);
+}
+
+
 }  // namespace
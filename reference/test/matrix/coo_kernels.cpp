@@ -338,6 +338,49 @@ TYPED_TEST(Coo, MovesEmptyToDense)
 }
 
 
+TYPED_TEST(Coo, CanBeTransposed)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+
+    auto trans = gko::as<Mtx>(this->mtx->transpose());
+
+    // clang-format off
+    GKO_ASSERT_MTX_NEAR(trans, l({{1.0, 0.0},
+                                  {3.0, 5.0},
+                                  {2.0, 0.0}}), 0.0);
+    // clang-format on
+    auto r = trans->get_const_row_idxs();
+    auto c = trans->get_const_col_idxs();
+    ASSERT_EQ(trans->get_num_stored_elements(), 4);
+    EXPECT_EQ(r[0], 0);
+    EXPECT_EQ(r[1], 1);
+    EXPECT_EQ(r[2], 1);
+    EXPECT_EQ(r[3], 2);
+    EXPECT_EQ(c[0], 0);
+    EXPECT_EQ(c[1], 0);
+    EXPECT_EQ(c[2], 1);
+    EXPECT_EQ(c[3], 0);
+}
+
+
+TYPED_TEST(Coo, CanBeConjTransposed)
+{
+    using T = gko::to_complex<typename TestFixture::value_type>;
+    using Mtx = gko::matrix::Coo<T, typename TestFixture::index_type>;
+    auto mtx = gko::initialize<Mtx>(
+        {I<T>{T{1.0, 2.0}, T{0.0, 0.0}}, I<T>{T{3.0, -1.0}, T{5.0, 0.0}}},
+        this->exec);
+
+    auto trans = gko::as<Mtx>(mtx->conj_transpose());
+
+    GKO_ASSERT_MTX_NEAR(trans,
+                        l({I<T>{T{1.0, -2.0}, T{3.0, 1.0}},
+                           I<T>{T{0.0, 0.0}, T{5.0, 0.0}}}),
+                        0.0);
+}
+
+
 TYPED_TEST(Coo, AppliesToDenseVector)
 {
     using Vec = typename TestFixture::Vec;
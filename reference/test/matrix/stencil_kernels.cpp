@@ -0,0 +1,312 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/matrix/stencil.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
+#include <ginkgo/core/preconditioner/jacobi.hpp>
+
+
+#include "core/matrix/stencil_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueType>
+class Stencil : public ::testing::Test {
+protected:
+    using value_type = ValueType;
+    using Mtx = gko::matrix::Stencil<value_type>;
+    using Csr = gko::matrix::Csr<value_type, gko::int32>;
+    using Vec = gko::matrix::Dense<value_type>;
+    using MixedVec = gko::matrix::Dense<gko::next_precision<value_type>>;
+
+    Stencil()
+        : exec(gko::ReferenceExecutor::create()),
+          // 3 x 2 grid with the 5-point Laplacian
+          mtx(Mtx::create(exec, gko::dim<3>{3, 2, 1},
+                          gko::matrix::stencil_shape::five_point_2d,
+                          gko::Array<value_type>{exec, {-1, -2, 4, -3, -4}})),
+          // rows are (bottom, left, center, right, top) neighbors
+          csr(gko::initialize<Csr>({{4.0, -3.0, 0.0, -4.0, 0.0, 0.0},
+                                    {-2.0, 4.0, -3.0, 0.0, -4.0, 0.0},
+                                    {0.0, -2.0, 4.0, 0.0, 0.0, -4.0},
+                                    {-1.0, 0.0, 0.0, 4.0, -3.0, 0.0},
+                                    {0.0, -1.0, 0.0, -2.0, 4.0, -3.0},
+                                    {0.0, 0.0, -1.0, 0.0, -2.0, 4.0}},
+                                   exec)),
+          x(gko::initialize<Vec>({I<value_type>{1.0, 2.0},
+                                  I<value_type>{-1.0, 0.5},
+                                  I<value_type>{2.0, 1.0},
+                                  I<value_type>{0.0, -3.0},
+                                  I<value_type>{3.0, 1.0},
+                                  I<value_type>{-2.0, 0.0}},
+                                 exec))
+    {}
+
+    std::unique_ptr<Mtx> create_variable_mtx()
+    {
+        // 3-point stencil on 3 nodes with row-dependent coefficients
+        return Mtx::create(exec, gko::dim<3>{3, 1, 1},
+                           gko::matrix::stencil_shape::three_point_1d,
+                           gko::Array<value_type>{
+                               exec, {0, -1, -2, 2, 3, 4, -3, -4, 0}});
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Csr> csr;
+    std::unique_ptr<Vec> x;
+};
+
+TYPED_TEST_SUITE(Stencil, gko::test::ValueTypes);
+
+
+TYPED_TEST(Stencil, AppliesToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto y = Vec::create(this->exec, gko::dim<2>{6, 2});
+    auto expected = y->clone();
+
+    this->mtx->apply(this->x.get(), y.get());
+    this->csr->apply(this->x.get(), expected.get());
+
+    GKO_ASSERT_MTX_NEAR(y, expected, 0.0);
+}
+
+
+TYPED_TEST(Stencil, AppliesToMixedDenseVector)
+{
+    using MixedVec = typename TestFixture::MixedVec;
+    auto x = MixedVec::create(this->exec);
+    this->x->convert_to(x.get());
+    auto y = MixedVec::create(this->exec, gko::dim<2>{6, 2});
+    auto expected = y->clone();
+
+    this->mtx->apply(x.get(), y.get());
+    this->csr->apply(x.get(), expected.get());
+
+    GKO_ASSERT_MTX_NEAR(y, expected, 0.0);
+}
+
+
+TYPED_TEST(Stencil, AppliesLinearCombinationToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({2.0}, this->exec);
+    auto y = gko::initialize<Vec>({I<T>{1.0, 0.0}, I<T>{2.0, 1.0},
+                                   I<T>{0.0, 3.0}, I<T>{1.0, 1.0},
+                                   I<T>{-1.0, 2.0}, I<T>{0.5, 0.5}},
+                                  this->exec);
+    auto expected = y->clone();
+
+    this->mtx->apply(alpha.get(), this->x.get(), beta.get(), y.get());
+    this->csr->apply(alpha.get(), this->x.get(), beta.get(), expected.get());
+
+    GKO_ASSERT_MTX_NEAR(y, expected, 0.0);
+}
+
+
+TYPED_TEST(Stencil, AppliesWithVariableCoefficients)
+{
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = this->create_variable_mtx();
+    auto x = gko::initialize<Vec>({1.0, 2.0, 3.0}, this->exec);
+    auto y = Vec::create(this->exec, gko::dim<2>{3, 1});
+
+    mtx->apply(x.get(), y.get());
+
+    // [2 -3  0]
+    // [-1 3 -4]
+    // [0 -2  4]
+    GKO_ASSERT_MTX_NEAR(y, l({-4.0, -7.0, 8.0}), 0.0);
+}
+
+
+TYPED_TEST(Stencil, AppliesToSevenPointStencil)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = typename TestFixture::Csr;
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = Mtx::create(
+        this->exec, gko::dim<3>{3, 2, 2},
+        gko::matrix::stencil_shape::seven_point_3d,
+        gko::Array<value_type>{this->exec, {-1, -2, -3, 6, -4, -5, -6}});
+    auto csr = Csr::create(this->exec);
+    mtx->convert_to(csr.get());
+    auto x = Vec::create(this->exec, gko::dim<2>{12, 1});
+    for (int i = 0; i < 12; ++i) {
+        x->at(i, 0) = static_cast<value_type>(i % 5 - 1);
+    }
+    auto y = Vec::create(this->exec, gko::dim<2>{12, 1});
+    auto expected = y->clone();
+
+    mtx->apply(x.get(), y.get());
+    csr->apply(x.get(), expected.get());
+
+    GKO_ASSERT_MTX_NEAR(y, expected, 0.0);
+    ASSERT_EQ(csr->get_num_stored_elements(), 12 + 2 * (8 + 6 + 6));
+}
+
+
+TYPED_TEST(Stencil, ConvertsToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto result = Csr::create(this->exec);
+
+    this->mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+    ASSERT_EQ(result->get_num_stored_elements(), 20);
+    ASSERT_TRUE(result->is_sorted_by_column_index());
+}
+
+
+TYPED_TEST(Stencil, ConvertsToCsr64)
+{
+    using value_type = typename TestFixture::value_type;
+    using Csr64 = gko::matrix::Csr<value_type, gko::int64>;
+    auto result = Csr64::create(this->exec);
+
+    this->mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+}
+
+
+TYPED_TEST(Stencil, ConvertsVariableStencilToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto mtx = this->create_variable_mtx();
+    auto result = Csr::create(this->exec);
+
+    mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(
+        result, l({{2.0, -3.0, 0.0}, {-1.0, 3.0, -4.0}, {0.0, -2.0, 4.0}}),
+        0.0);
+}
+
+
+TYPED_TEST(Stencil, ConvertsStencilWithEmptyRowsToCsr)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = typename TestFixture::Csr;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = Mtx::create(this->exec, gko::dim<3>{3, 1, 1},
+                           gko::Array<gko::int32>{this->exec, {1, 0, 0}},
+                           gko::Array<value_type>{this->exec, {2.0}});
+    auto result = Csr::create(this->exec);
+
+    mtx->convert_to(result.get());
+
+    GKO_ASSERT_MTX_NEAR(result,
+                        l({{0.0, 2.0, 0.0}, {0.0, 0.0, 2.0}, {0.0, 0.0, 0.0}}),
+                        0.0);
+    ASSERT_EQ(result->get_num_stored_elements(), 2);
+}
+
+
+TYPED_TEST(Stencil, ExtractsDiagonal)
+{
+    using value_type = typename TestFixture::value_type;
+    auto mtx = this->create_variable_mtx();
+
+    auto diag = mtx->extract_diagonal();
+
+    ASSERT_EQ(diag->get_size(), gko::dim<2>(3, 3));
+    EXPECT_EQ(diag->get_const_values()[0], value_type{2.0});
+    EXPECT_EQ(diag->get_const_values()[1], value_type{3.0});
+    EXPECT_EQ(diag->get_const_values()[2], value_type{4.0});
+}
+
+
+TYPED_TEST(Stencil, CanBeUsedWithJacobi)
+{
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto jacobi = gko::preconditioner::Jacobi<value_type, gko::int32>::build()
+                      .with_max_block_size(1u)
+                      .on(this->exec)
+                      ->generate(gko::share(this->create_variable_mtx()));
+    auto b = gko::initialize<Vec>({2.0, 3.0, 2.0}, this->exec);
+    auto x = Vec::create(this->exec, gko::dim<2>{3, 1});
+
+    jacobi->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 1.0, 0.5}), r<value_type>::value);
+}
+
+
+TYPED_TEST(Stencil, GeneratesCorrectMatrixData)
+{
+    using value_type = typename TestFixture::value_type;
+    using tpl = typename gko::matrix_data<value_type>::nonzero_type;
+    gko::matrix_data<value_type> data;
+    auto mtx = TestFixture::Mtx::create(
+        this->exec, gko::dim<3>{3, 1, 1},
+        gko::matrix::stencil_shape::three_point_1d,
+        gko::Array<value_type>{this->exec, {-1, 2, -1}});
+
+    mtx->write(data);
+
+    ASSERT_EQ(data.size, gko::dim<2>(3, 3));
+    ASSERT_EQ(data.nonzeros.size(), 7);
+    EXPECT_EQ(data.nonzeros[0], tpl(0, 0, value_type{2.0}));
+    EXPECT_EQ(data.nonzeros[1], tpl(0, 1, value_type{-1.0}));
+    EXPECT_EQ(data.nonzeros[2], tpl(1, 0, value_type{-1.0}));
+    EXPECT_EQ(data.nonzeros[3], tpl(1, 1, value_type{2.0}));
+    EXPECT_EQ(data.nonzeros[4], tpl(1, 2, value_type{-1.0}));
+    EXPECT_EQ(data.nonzeros[5], tpl(2, 1, value_type{-1.0}));
+    EXPECT_EQ(data.nonzeros[6], tpl(2, 2, value_type{2.0}));
+}
+
+
+}  // namespace
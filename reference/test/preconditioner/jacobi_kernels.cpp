@@ -42,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
 
 
 #include "core/base/extended_float.hpp"
@@ -51,6 +52,48 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace {
 
 
+/**
+ * An operator which only provides its diagonal, i.e. which cannot be converted
+ * to Csr.
+ */
+template <typename ValueType>
+class DiagonalOnlyLinOp
+    : public gko::EnableLinOp<DiagonalOnlyLinOp<ValueType>>,
+      public gko::EnableCreateMethod<DiagonalOnlyLinOp<ValueType>>,
+      public gko::DiagonalExtractable<ValueType> {
+    friend class gko::EnablePolymorphicObject<DiagonalOnlyLinOp, gko::LinOp>;
+    friend class gko::EnableCreateMethod<DiagonalOnlyLinOp>;
+
+public:
+    std::unique_ptr<gko::matrix::Diagonal<ValueType>> extract_diagonal()
+        const override
+    {
+        return gko::clone(diag_);
+    }
+
+protected:
+    void apply_impl(const gko::LinOp *b, gko::LinOp *x) const override {}
+
+    void apply_impl(const gko::LinOp *alpha, const gko::LinOp *b,
+                    const gko::LinOp *beta, gko::LinOp *x) const override
+    {}
+
+    explicit DiagonalOnlyLinOp(std::shared_ptr<const gko::Executor> exec)
+        : gko::EnableLinOp<DiagonalOnlyLinOp>(exec)
+    {}
+
+    DiagonalOnlyLinOp(std::shared_ptr<const gko::Executor> exec,
+                      std::initializer_list<ValueType> diag)
+        : gko::EnableLinOp<DiagonalOnlyLinOp>(exec, gko::dim<2>{diag.size()}),
+          diag_(gko::matrix::Diagonal<ValueType>::create(
+              exec, diag.size(), gko::Array<ValueType>{exec, diag}))
+    {}
+
+private:
+    std::shared_ptr<gko::matrix::Diagonal<ValueType>> diag_;
+};
+
+
 template <typename ValueIndexType>
 class Jacobi : public ::testing::Test {
 protected:
@@ -642,6 +685,107 @@ TYPED_TEST(Jacobi, AvoidsPrecisionsThatOverflow)
 }
 
 
+TYPED_TEST(Jacobi, RegeneratesWithSameBlocks)
+{
+    using T = typename TestFixture::value_type;
+    auto bj = this->bj_factory->generate(this->mtx);
+    auto blocks = bj->get_blocks();
+    auto scaled = gko::clone(this->mtx);
+    for (gko::size_type i = 0; i < scaled->get_num_stored_elements(); ++i) {
+        scaled->get_values()[i] *= T{2.0};
+    }
+
+    bj->regenerate(gko::share(scaled));
+
+    auto scheme = bj->get_storage_scheme();
+    auto p = scheme.get_stride();
+    ASSERT_EQ(bj->get_blocks(), blocks);
+    ASSERT_EQ(bj->get_num_blocks(), 2);
+    auto b1 = bj->get_blocks() + scheme.get_global_block_offset(0);
+    GKO_EXPECT_NEAR(b1[0 + 0 * p], T{2.0 / 14.0}, r<T>::value);
+    GKO_EXPECT_NEAR(b1[0 + 1 * p], T{1.0 / 14.0}, r<T>::value);
+    GKO_EXPECT_NEAR(b1[1 + 0 * p], T{0.5 / 14.0}, r<T>::value);
+    GKO_EXPECT_NEAR(b1[1 + 1 * p], T{2.0 / 14.0}, r<T>::value);
+    auto b2 = bj->get_blocks() + scheme.get_global_block_offset(1);
+    GKO_EXPECT_NEAR(b2[0 + 0 * p], T{7.0 / 48.0}, r<T>::value);
+    GKO_EXPECT_NEAR(b2[1 + 1 * p], T{8.0 / 48.0}, r<T>::value);
+    GKO_EXPECT_NEAR(b2[2 + 0 * p], T{0.5 / 48.0}, r<T>::value);
+    GKO_EXPECT_NEAR(b2[2 + 2 * p], T{7.0 / 48.0}, r<T>::value);
+}
+
+
+TYPED_TEST(Jacobi, RegeneratesKeepingBlockPrecisions)
+{
+    using Bj = typename TestFixture::Bj;
+    using T = typename TestFixture::value_type;
+    auto factory =
+        Bj::build()
+            .with_max_block_size(17u)
+            .with_block_pointers(this->block_pointers)
+            .with_storage_optimization(gko::precision_reduction::autodetect())
+            .with_accuracy(gko::remove_complex<T>{1.5e-3})
+            .on(this->exec);
+    auto bj = factory->generate(this->mtx);
+    auto precisions = bj->get_parameters().storage_optimization.block_wise;
+    // same pattern, but the diagonal blocks are perfectly conditioned
+    auto diag_mtx = gko::clone(this->mtx);
+    for (auto i : {1, 3, 6, 7, 9, 11}) {
+        diag_mtx->get_values()[i] = gko::zero<T>();
+    }
+
+    bj->regenerate(gko::share(diag_mtx));
+
+    auto prec =
+        bj->get_parameters().storage_optimization.block_wise.get_const_data();
+    EXPECT_EQ(prec[0], precisions.get_const_data()[0]);
+    EXPECT_EQ(prec[1], precisions.get_const_data()[1]);
+    GKO_EXPECT_NEAR(bj->get_conditioning()[0], gko::remove_complex<T>{1.0},
+                    r<T>::value);
+    GKO_ASSERT_NEAR(bj->get_conditioning()[1], gko::remove_complex<T>{1.0},
+                    r<T>::value);
+}
+
+
+TYPED_TEST(Jacobi, RegeneratesWithNewBlockPrecisions)
+{
+    using Bj = typename TestFixture::Bj;
+    using T = typename TestFixture::value_type;
+    auto factory =
+        Bj::build()
+            .with_max_block_size(17u)
+            .with_block_pointers(this->block_pointers)
+            .with_storage_optimization(gko::precision_reduction::autodetect())
+            .with_accuracy(gko::remove_complex<T>{1.5e-3})
+            .on(this->exec);
+    auto bj = factory->generate(this->mtx);
+    auto diag_mtx = gko::share(gko::clone(this->mtx));
+    for (auto i : {1, 3, 6, 7, 9, 11}) {
+        diag_mtx->get_values()[i] = gko::zero<T>();
+    }
+    auto expected = factory->generate(diag_mtx);
+
+    bj->regenerate(diag_mtx, false);
+
+    auto prec =
+        bj->get_parameters().storage_optimization.block_wise.get_const_data();
+    auto expected_prec = expected->get_parameters()
+                             .storage_optimization.block_wise.get_const_data();
+    EXPECT_EQ(prec[0], expected_prec[0]);
+    ASSERT_EQ(prec[1], expected_prec[1]);
+    GKO_ASSERT_MTX_NEAR(bj, expected, r<T>::value);
+}
+
+
+TYPED_TEST(Jacobi, RegenerationThrowsOnSizeMismatch)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto bj = this->bj_factory->generate(this->mtx);
+
+    ASSERT_THROW(bj->regenerate(Mtx::create(this->exec, gko::dim<2>{4})),
+                 gko::DimensionMismatch);
+}
+
+
 TYPED_TEST(Jacobi, AppliesToVector)
 {
     using Vec = typename TestFixture::Vec;
@@ -656,6 +800,26 @@ TYPED_TEST(Jacobi, AppliesToVector)
 }
 
 
+TYPED_TEST(Jacobi, ScalarJacobiOnlyUsesDiagonal)
+{
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = DiagonalOnlyLinOp<value_type>::create(
+        this->exec, std::initializer_list<value_type>{4.0, 2.0, -1.0});
+    auto x = Vec::create(this->exec, gko::dim<2>{3, 1});
+    auto b = gko::initialize<Vec>({4.0, -1.0, 2.0}, this->exec);
+    auto bj = TestFixture::Bj::build()
+                  .with_max_block_size(1u)
+                  .on(this->exec)
+                  ->generate(gko::share(mtx));
+
+    bj->apply(b.get(), x.get());
+
+    ASSERT_EQ(bj->get_num_blocks(), 3);
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, -0.5, -2.0}), r<value_type>::value);
+}
+
+
 TYPED_TEST(Jacobi, AppliesToMixedVector)
 {
     using value_type = gko::next_precision<typename TestFixture::value_type>;
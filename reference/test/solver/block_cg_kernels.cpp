@@ -0,0 +1,332 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/block_cg.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/log/convergence.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/preconditioner/jacobi.hpp>
+#include <ginkgo/core/solver/cg.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename T>
+class BlockCg : public ::testing::Test {
+protected:
+    using value_type = T;
+    using Mtx = gko::matrix::Dense<value_type>;
+    using Csr = gko::matrix::Csr<value_type, gko::int32>;
+    using Solver = gko::solver::BlockCg<value_type>;
+    BlockCg()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(gko::initialize<Mtx>(
+              {{2, -1.0, 0.0}, {-1.0, 2, -1.0}, {0.0, -1.0, 2}}, exec)),
+          block_cg_factory(
+              Solver::build()
+                  .with_criteria(
+                      gko::stop::Iteration::build().with_max_iters(400u).on(
+                          exec),
+                      gko::stop::ResidualNorm<value_type>::build()
+                          .with_reduction_factor(r<value_type>::value)
+                          .on(exec))
+                  .on(exec)),
+          mtx_big(gko::initialize<Mtx>(
+              {{8828.0, 2673.0, 4150.0, -3139.5, 3829.5, 5856.0},
+               {2673.0, 10765.5, 1805.0, 73.0, 1966.0, 3919.5},
+               {4150.0, 1805.0, 6472.5, 2656.0, 2409.5, 3836.5},
+               {-3139.5, 73.0, 2656.0, 6048.0, 665.0, -132.0},
+               {3829.5, 1966.0, 2409.5, 665.0, 4240.5, 4373.5},
+               {5856.0, 3919.5, 3836.5, -132.0, 4373.5, 5678.0}},
+              exec))
+    {}
+
+    // 1D Poisson matrix tridiag(-1, 2, -1)
+    std::shared_ptr<Csr> create_poisson(gko::size_type size)
+    {
+        gko::matrix_data<value_type, gko::int32> data{gko::dim<2>{size}};
+        for (gko::int32 i = 0; i < static_cast<gko::int32>(size); ++i) {
+            if (i > 0) {
+                data.nonzeros.emplace_back(i, i - 1, -1.0);
+            }
+            data.nonzeros.emplace_back(i, i, 2.0);
+            if (i + 1 < static_cast<gko::int32>(size)) {
+                data.nonzeros.emplace_back(i, i + 1, -1.0);
+            }
+        }
+        auto result = gko::share(Csr::create(exec));
+        result->read(data);
+        return result;
+    }
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::shared_ptr<Mtx> mtx;
+    std::unique_ptr<typename Solver::Factory> block_cg_factory;
+    std::shared_ptr<Mtx> mtx_big;
+};
+
+TYPED_TEST_SUITE(BlockCg, gko::test::ValueTypes);
+
+
+TYPED_TEST(BlockCg, SolvesStencilSystem)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->block_cg_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({-1.0, 3.0, 1.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 3.0, 2.0}), r<value_type>::value);
+}
+
+
+TYPED_TEST(BlockCg, SolvesStencilSystemMixed)
+{
+    using value_type = gko::next_precision<typename TestFixture::value_type>;
+    using Mtx = gko::matrix::Dense<value_type>;
+    auto solver = this->block_cg_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({-1.0, 3.0, 1.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 3.0, 2.0}),
+                        (r_mixed<value_type, TypeParam>()));
+}
+
+
+TYPED_TEST(BlockCg, SolvesMultipleStencilSystems)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using T = value_type;
+    auto solver = this->block_cg_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>(
+        {I<T>{-1.0, 1.0}, I<T>{3.0, 0.0}, I<T>{1.0, 1.0}}, this->exec);
+    auto x = gko::initialize<Mtx>(
+        {I<T>{0.0, 0.0}, I<T>{0.0, 0.0}, I<T>{0.0, 0.0}}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({{1.0, 1.0}, {3.0, 1.0}, {2.0, 1.0}}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(BlockCg, SolvesStencilSystemUsingAdvancedApply)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->block_cg_factory->generate(this->mtx);
+    auto alpha = gko::initialize<Mtx>({2.0}, this->exec);
+    auto beta = gko::initialize<Mtx>({-1.0}, this->exec);
+    auto b = gko::initialize<Mtx>({-1.0, 3.0, 1.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.5, 1.0, 2.0}, this->exec);
+
+    solver->apply(alpha.get(), b.get(), beta.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.5, 5.0, 2.0}), r<value_type>::value);
+}
+
+
+TYPED_TEST(BlockCg, TerminatesAfterSizeOverNumRhsIterations)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using T = value_type;
+    // the block Krylov space of the four right-hand sides spans the whole
+    // space after two iterations
+    auto solver =
+        TestFixture::Solver::build()
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(2u).on(
+                    this->exec))
+            .on(this->exec)
+            ->generate(this->create_poisson(8));
+    auto b = gko::initialize<Mtx>({I<T>{0.0, -1.0, 4.0, 3.0},
+                                   I<T>{3.0, -1.0, -3.0, -5.0},
+                                   I<T>{-1.0, 3.0, 0.0, 5.0},
+                                   I<T>{-5.0, 2.0, 2.0, -3.0},
+                                   I<T>{6.0, -5.0, 2.0, -1.0},
+                                   I<T>{-3.0, 3.0, -6.0, 6.0},
+                                   I<T>{3.0, -3.0, 1.0, -6.0},
+                                   I<T>{-2.0, 4.0, 5.0, 3.0}},
+                                  this->exec);
+    auto x = Mtx::create(this->exec, gko::dim<2>{8, 4});
+    x->fill(gko::zero<value_type>());
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x,
+                        l({{1.0, 0.0, 2.0, 1.0},
+                           {2.0, 1.0, 0.0, -1.0},
+                           {0.0, 3.0, 1.0, 2.0},
+                           {-1.0, 2.0, 2.0, 0.0},
+                           {3.0, -1.0, 1.0, 1.0},
+                           {1.0, 1.0, -2.0, 3.0},
+                           {2.0, 0.0, 1.0, -1.0},
+                           {0.0, 2.0, 3.0, 1.0}}),
+                        r<value_type>::value * 1e2);
+}
+
+
+TYPED_TEST(BlockCg, NeedsFewerIterationsThanCg)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto poisson = this->create_poisson(64);
+    auto b = Mtx::create(this->exec, gko::dim<2>{64, 4});
+    for (gko::size_type row = 0; row < 64; ++row) {
+        for (gko::size_type col = 0; col < 4; ++col) {
+            b->at(row, col) = static_cast<value_type>(
+                std::sin(static_cast<double>((row + 1) * (col + 1))));
+        }
+    }
+    auto x = Mtx::create(this->exec, b->get_size());
+    x->fill(gko::zero<value_type>());
+    auto cg_x = x->clone();
+    auto create_criteria = [&] {
+        return gko::share(
+            gko::stop::Combined::build()
+                .with_criteria(
+                    gko::stop::Iteration::build().with_max_iters(400u).on(
+                        this->exec),
+                    gko::stop::ResidualNorm<value_type>::build()
+                        .with_reduction_factor(r<value_type>::value)
+                        .on(this->exec))
+                .on(this->exec));
+    };
+    auto criteria = create_criteria();
+    auto cg_criteria = create_criteria();
+    auto logger = gko::share(gko::log::Convergence<value_type>::create(
+        this->exec, gko::log::Logger::criterion_check_completed_mask));
+    auto cg_logger = gko::share(gko::log::Convergence<value_type>::create(
+        this->exec, gko::log::Logger::criterion_check_completed_mask));
+    criteria->add_logger(logger);
+    cg_criteria->add_logger(cg_logger);
+    auto solver = TestFixture::Solver::build()
+                      .with_criteria(criteria)
+                      .on(this->exec)
+                      ->generate(poisson);
+    auto cg = gko::solver::Cg<value_type>::build()
+                  .with_criteria(cg_criteria)
+                  .on(this->exec)
+                  ->generate(poisson);
+
+    solver->apply(b.get(), x.get());
+    cg->apply(b.get(), cg_x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, cg_x, r<value_type>::value * 1e3);
+    ASSERT_LT(logger->get_num_iterations(), cg_logger->get_num_iterations());
+}
+
+
+TYPED_TEST(BlockCg, SolvesLinearlyDependentRightHandSides)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using T = value_type;
+    auto solver = this->block_cg_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({I<T>{-1.0, -1.0, -2.0},
+                                   I<T>{3.0, 3.0, 6.0},
+                                   I<T>{1.0, 1.0, 2.0}},
+                                  this->exec);
+    auto x = Mtx::create(this->exec, gko::dim<2>{3, 3});
+    x->fill(gko::zero<value_type>());
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(
+        x, l({{1.0, 1.0, 2.0}, {3.0, 3.0, 6.0}, {2.0, 2.0, 4.0}}),
+        r<value_type>::value);
+}
+
+
+TYPED_TEST(BlockCg, SolvesBigDenseSystemWithJacobi)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using T = value_type;
+    auto solver =
+        TestFixture::Solver::build()
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(100u).on(
+                    this->exec),
+                gko::stop::ResidualNorm<value_type>::build()
+                    .with_reduction_factor(r<value_type>::value)
+                    .on(this->exec))
+            .with_preconditioner(
+                gko::preconditioner::Jacobi<value_type>::build()
+                    .with_max_block_size(1u)
+                    .on(this->exec))
+            .on(this->exec)
+            ->generate(this->mtx_big);
+    auto b = gko::initialize<Mtx>({I<T>{1300083.0, 886630.5},
+                                   I<T>{1018120.5, -172578.0},
+                                   I<T>{906410.0, 684522.0},
+                                   I<T>{-42679.5, -65310.5},
+                                   I<T>{846779.5, 455487.5},
+                                   I<T>{1176858.5, 607436.0}},
+                                  this->exec);
+    auto x = Mtx::create(this->exec, gko::dim<2>{6, 2});
+    x->fill(gko::zero<value_type>());
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x,
+                        l({{81.0, 33.0},
+                           {55.0, -56.0},
+                           {45.0, 81.0},
+                           {5.0, -30.0},
+                           {85.0, 21.0},
+                           {-10.0, 40.0}}),
+                        r<value_type>::value * 1e3);
+}
+
+
+}  // namespace
@@ -0,0 +1,385 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/ca_gmres.hpp>
+
+
+#include <cmath>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/log/convergence.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/preconditioner/jacobi.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename T>
+class CaGmres : public ::testing::Test {
+protected:
+    using value_type = T;
+    using real_type = gko::remove_complex<value_type>;
+    using Mtx = gko::matrix::Dense<value_type>;
+    using Csr = gko::matrix::Csr<value_type, gko::int32>;
+    using Solver = gko::solver::CaGmres<value_type>;
+    CaGmres()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(gko::initialize<Mtx>(
+              {{1.0, 2.0, 3.0}, {3.0, 2.0, -1.0}, {0.0, -1.0, 2}}, exec)),
+          ca_gmres_factory(
+              Solver::build()
+                  .with_criteria(
+                      gko::stop::Iteration::build().with_max_iters(4u).on(exec),
+                      gko::stop::ResidualNorm<value_type>::build()
+                          .with_reduction_factor(r<value_type>::value)
+                          .on(exec))
+                  .with_step_size(2u)
+                  .on(exec)),
+          mtx_big(gko::initialize<Mtx>(
+              {{2295.7, -764.8, 1166.5, 428.9, 291.7, -774.5},
+               {2752.6, -1127.7, 1212.8, -299.1, 987.7, 786.8},
+               {138.3, 78.2, 485.5, -899.9, 392.9, 1408.9},
+               {-1907.1, 2106.6, 1026.0, 634.7, 194.6, -534.1},
+               {-365.0, -715.8, 870.7, 67.5, 279.8, 1927.8},
+               {-848.1, -280.5, -381.8, -187.1, 51.2, -176.2}},
+              exec)),
+          mtx_medium(
+              gko::initialize<Mtx>({{-86.40, 153.30, -108.90, 8.60, -61.60},
+                                    {7.70, -77.00, 3.30, -149.20, 74.80},
+                                    {-121.40, 37.10, 55.30, -74.20, -19.20},
+                                    {-111.40, -22.60, 110.10, -106.20, 88.90},
+                                    {-0.70, 111.70, 154.40, 235.00, -76.50}},
+                                   exec))
+    {}
+
+    std::unique_ptr<typename Solver::Factory> build_factory(
+        gko::size_type krylov_dim, gko::size_type step_size,
+        gko::solver::ca_gmres::basis basis, gko::size_type max_iters = 100u)
+    {
+        return Solver::build()
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(max_iters).on(
+                    exec),
+                gko::stop::ResidualNorm<value_type>::build()
+                    .with_reduction_factor(r<value_type>::value)
+                    .on(exec))
+            .with_krylov_dim(krylov_dim)
+            .with_step_size(step_size)
+            .with_basis(basis)
+            .on(exec);
+    }
+
+    // nonsymmetric convection-diffusion like matrix with an additional band
+    std::shared_ptr<Csr> create_nonsymmetric(gko::int32 size)
+    {
+        gko::matrix_data<value_type, gko::int32> data{gko::dim<2>(size)};
+        for (gko::int32 i = 0; i < size; ++i) {
+            if (i > 0) {
+                data.nonzeros.emplace_back(i, i - 1, -1.3);
+            }
+            data.nonzeros.emplace_back(i, i, 2.5 + 0.01 * i);
+            if (i + 1 < size) {
+                data.nonzeros.emplace_back(i, i + 1, -0.7);
+            }
+            if (i + 7 < size) {
+                data.nonzeros.emplace_back(i, i + 7, 0.3);
+            }
+        }
+        auto result = gko::share(Csr::create(exec));
+        result->read(data);
+        return result;
+    }
+
+    // returns ||b - A x|| / ||b||
+    real_type relative_residual(const gko::LinOp *a, const Mtx *b,
+                                const Mtx *x)
+    {
+        auto res = gko::clone(b);
+        auto one = gko::initialize<Mtx>({1.0}, exec);
+        auto neg_one = gko::initialize<Mtx>({-1.0}, exec);
+        a->apply(neg_one.get(), x, one.get(), res.get());
+        auto res_norm = gko::matrix::Dense<real_type>::create(
+            exec, gko::dim<2>{1, 1});
+        auto b_norm = gko::matrix::Dense<real_type>::create(
+            exec, gko::dim<2>{1, 1});
+        res->compute_norm2(res_norm.get());
+        b->compute_norm2(b_norm.get());
+        return res_norm->at(0, 0) / b_norm->at(0, 0);
+    }
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::shared_ptr<Mtx> mtx;
+    std::unique_ptr<typename Solver::Factory> ca_gmres_factory;
+    std::shared_ptr<Mtx> mtx_big;
+    std::shared_ptr<Mtx> mtx_medium;
+};
+
+TYPED_TEST_SUITE(CaGmres, gko::test::ValueTypes);
+
+
+TYPED_TEST(CaGmres, SolvesStencilSystem)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->ca_gmres_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({13.0, 7.0, 1.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 3.0, 2.0}), r<value_type>::value * 1e1);
+}
+
+
+TYPED_TEST(CaGmres, SolvesStencilSystemMixed)
+{
+    using value_type = gko::next_precision<typename TestFixture::value_type>;
+    using Mtx = gko::matrix::Dense<value_type>;
+    auto solver = this->ca_gmres_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({13.0, 7.0, 1.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 3.0, 2.0}),
+                        (r_mixed<value_type, TypeParam>()) * 1e1);
+}
+
+
+TYPED_TEST(CaGmres, SolvesMultipleStencilSystems)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using T = value_type;
+    auto solver = this->ca_gmres_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>(
+        {I<T>{13.0, 6.0}, I<T>{7.0, 4.0}, I<T>{1.0, 1.0}}, this->exec);
+    auto x = gko::initialize<Mtx>(
+        {I<T>{0.0, 0.0}, I<T>{0.0, 0.0}, I<T>{0.0, 0.0}}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({{1.0, 1.0}, {3.0, 1.0}, {2.0, 1.0}}),
+                        r<value_type>::value * 1e1);
+}
+
+
+TYPED_TEST(CaGmres, SolvesStencilSystemUsingAdvancedApply)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->ca_gmres_factory->generate(this->mtx);
+    auto alpha = gko::initialize<Mtx>({2.0}, this->exec);
+    auto beta = gko::initialize<Mtx>({-1.0}, this->exec);
+    auto b = gko::initialize<Mtx>({13.0, 7.0, 1.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.5, 1.0, 2.0}, this->exec);
+
+    solver->apply(alpha.get(), b.get(), beta.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.5, 5.0, 2.0}), r<value_type>::value * 1e1);
+}
+
+
+TYPED_TEST(CaGmres, SolvesBigDenseSystemWithMonomialBasis)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver =
+        this->build_factory(6u, 3u, gko::solver::ca_gmres::basis::monomial)
+            ->generate(this->mtx_big);
+    auto b = gko::initialize<Mtx>(
+        {72748.36, 297469.88, 347229.24, 36290.66, 82958.82, -80192.15},
+        this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({52.7, 85.4, 134.2, -250.0, -16.8, 35.3}),
+                        r<value_type>::value * 1e3);
+}
+
+
+TYPED_TEST(CaGmres, SolvesBigDenseSystemWithNewtonBasis)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver =
+        this->build_factory(6u, 3u, gko::solver::ca_gmres::basis::newton)
+            ->generate(this->mtx_big);
+    auto b = gko::initialize<Mtx>(
+        {72748.36, 297469.88, 347229.24, 36290.66, 82958.82, -80192.15},
+        this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({52.7, 85.4, 134.2, -250.0, -16.8, 35.3}),
+                        r<value_type>::value * 1e3);
+}
+
+
+TYPED_TEST(CaGmres, SolvesMediumDenseSystemWithRestart)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto half_tol = std::sqrt(r<value_type>::value);
+    auto solver =
+        this->build_factory(4u, 2u, gko::solver::ca_gmres::basis::newton,
+                            200u)
+            ->generate(this->mtx_medium);
+    auto b = gko::initialize<Mtx>(
+        {-13945.16, 11205.66, 16132.96, 24342.18, -10910.98}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({-140.20, -142.20, 48.80, -17.70, -19.60}),
+                        half_tol * 1e2);
+}
+
+
+TYPED_TEST(CaGmres, SolvesWithPreconditioner)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Solver = typename TestFixture::Solver;
+    using value_type = typename TestFixture::value_type;
+    auto solver =
+        Solver::build()
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(100u).on(
+                    this->exec),
+                gko::stop::ResidualNorm<value_type>::build()
+                    .with_reduction_factor(r<value_type>::value)
+                    .on(this->exec))
+            .with_preconditioner(
+                gko::preconditioner::Jacobi<value_type>::build()
+                    .with_max_block_size(3u)
+                    .on(this->exec))
+            .with_step_size(3u)
+            .on(this->exec)
+            ->generate(this->mtx_big);
+    auto b = gko::initialize<Mtx>(
+        {175352.10, 313410.50, 131114.10, -134116.30, 179529.30, -43564.90},
+        this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({33.0, -56.0, 81.0, -30.0, 21.0, 40.0}),
+                        r<value_type>::value * 1e3);
+}
+
+
+TYPED_TEST(CaGmres, IterationCountIsMultipleOfStepSize)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using Solver = typename TestFixture::Solver;
+    auto logger = gko::share(gko::log::Convergence<value_type>::create(
+        this->exec, gko::log::Logger::criterion_check_completed_mask));
+    auto criteria = gko::share(
+        gko::stop::Combined::build()
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(100u).on(
+                    this->exec),
+                gko::stop::ResidualNorm<value_type>::build()
+                    .with_reduction_factor(r<value_type>::value)
+                    .on(this->exec))
+            .on(this->exec));
+    criteria->add_logger(logger);
+    auto factory = Solver::build()
+                       .with_criteria(criteria)
+                       .with_krylov_dim(40u)
+                       .with_step_size(4u)
+                       .on(this->exec);
+    auto mtx = this->create_nonsymmetric(60);
+    auto solver = factory->generate(mtx);
+    auto b = Mtx::create(this->exec, gko::dim<2>{60, 1});
+    auto x = Mtx::create(this->exec, gko::dim<2>{60, 1});
+    for (int i = 0; i < 60; ++i) {
+        b->at(i, 0) = std::sin(i);
+    }
+    x->fill(gko::zero<value_type>());
+
+    solver->apply(b.get(), x.get());
+
+    ASSERT_GT(logger->get_num_iterations(), 0);
+    ASSERT_EQ(logger->get_num_iterations() % 4, 0);
+    ASSERT_LE(this->relative_residual(mtx.get(), b.get(), x.get()),
+              r<value_type>::value * 1e1);
+}
+
+
+TYPED_TEST(CaGmres, SolvesMultipleSystemsWithNewtonBasisAndRestarts)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = this->create_nonsymmetric(200);
+    auto solver =
+        this->build_factory(16u, 4u, gko::solver::ca_gmres::basis::newton,
+                            1000u)
+            ->generate(mtx);
+    auto b = Mtx::create(this->exec, gko::dim<2>{200, 2});
+    auto x = Mtx::create(this->exec, gko::dim<2>{200, 2});
+    for (int i = 0; i < 200; ++i) {
+        b->at(i, 0) = std::sin(i);
+        b->at(i, 1) = 1.0;
+    }
+    x->fill(gko::zero<value_type>());
+
+    solver->apply(b.get(), x.get());
+
+    auto b0 = b->create_submatrix(gko::span{0, 200}, gko::span{0, 1});
+    auto x0 = x->create_submatrix(gko::span{0, 200}, gko::span{0, 1});
+    auto b1 = b->create_submatrix(gko::span{0, 200}, gko::span{1, 2});
+    auto x1 = x->create_submatrix(gko::span{0, 200}, gko::span{1, 2});
+    ASSERT_LE(this->relative_residual(mtx.get(), b0.get(), x0.get()),
+              r<value_type>::value * 1e1);
+    ASSERT_LE(this->relative_residual(mtx.get(), b1.get(), x1.get()),
+              r<value_type>::value * 1e1);
+}
+
+
+}  // namespace
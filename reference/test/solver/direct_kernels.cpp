@@ -0,0 +1,357 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/direct.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/solver/direct_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class Direct : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::Dense<value_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Solver = gko::solver::Direct<value_type, index_type>;
+
+    Direct()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(gko::initialize<Csr>({{2.0, -1.0, 0.0},
+                                    {-1.0, 2.0, -1.0},
+                                    {0.0, -1.0, 2.0}},
+                                   exec)),
+          mtx_pivot(gko::initialize<Csr>(
+              {{0.0, 2.0, 0.0}, {1.0, 0.0, 2.0}, {0.0, 3.0, 1.0}}, exec)),
+          lu_factory(Solver::build().on(exec)),
+          cholesky_factory(
+              Solver::build()
+                  .with_factorization(gko::solver::factorization_type::cholesky)
+                  .on(exec))
+    {}
+
+    /**
+     * Generates the 5-point discretization of a convection-diffusion
+     * operator on a square grid, which is symmetric without convection.
+     */
+    std::shared_ptr<Csr> generate_grid(index_type size, double convection)
+    {
+        gko::matrix_data<value_type, index_type> data{
+            gko::dim<2>(size * size)};
+        for (index_type i = 0; i < size; ++i) {
+            for (index_type j = 0; j < size; ++j) {
+                const auto row = i * size + j;
+                data.nonzeros.emplace_back(row, row, 4.0);
+                if (i > 0) {
+                    data.nonzeros.emplace_back(row, row - size,
+                                               -1.0 - convection);
+                }
+                if (i < size - 1) {
+                    data.nonzeros.emplace_back(row, row + size,
+                                               -1.0 + convection);
+                }
+                if (j > 0) {
+                    data.nonzeros.emplace_back(row, row - 1, -1.0 - convection);
+                }
+                if (j < size - 1) {
+                    data.nonzeros.emplace_back(row, row + 1, -1.0 + convection);
+                }
+            }
+        }
+        data.ensure_row_major_order();
+        auto result = gko::share(Csr::create(exec));
+        result->read(data);
+        return result;
+    }
+
+    std::unique_ptr<Mtx> generate_solution(gko::size_type size,
+                                           gko::size_type num_rhs)
+    {
+        auto result = Mtx::create(exec, gko::dim<2>{size, num_rhs});
+        for (gko::size_type i = 0; i < size; ++i) {
+            for (gko::size_type j = 0; j < num_rhs; ++j) {
+                result->at(i, j) = static_cast<value_type>(
+                    static_cast<double>((i + 3 * j) % 7) - 3.0);
+            }
+        }
+        return result;
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::shared_ptr<Csr> mtx;
+    std::shared_ptr<Csr> mtx_pivot;
+    std::unique_ptr<typename Solver::Factory> lu_factory;
+    std::unique_ptr<typename Solver::Factory> cholesky_factory;
+};
+
+TYPED_TEST_SUITE(Direct, gko::test::ValueIndexTypes);
+
+
+TYPED_TEST(Direct, SolvesSpdSystemWithLu)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->lu_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({0.0, 0.0, 4.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 2.0, 3.0}), r<value_type>::value);
+}
+
+
+TYPED_TEST(Direct, SolvesSpdSystemWithCholesky)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->cholesky_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({0.0, 0.0, 4.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 2.0, 3.0}), r<value_type>::value);
+}
+
+
+TYPED_TEST(Direct, SolvesSystemRequiringPivoting)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->lu_factory->generate(this->mtx_pivot);
+    auto b = gko::initialize<Mtx>({4.0, 7.0, 9.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 2.0, 3.0}), r<value_type>::value);
+    ASSERT_EQ(solver->get_num_perturbed_pivots(), 0);
+}
+
+
+TYPED_TEST(Direct, SolvesMultipleRightHandSides)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->lu_factory->generate(this->mtx_pivot);
+    auto b = gko::initialize<Mtx>({{4.0, 2.0}, {7.0, 1.0}, {9.0, 3.0}},
+                                  this->exec);
+    auto x = Mtx::create(this->exec, gko::dim<2>{3, 2});
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({{1.0, 1.0}, {2.0, 1.0}, {3.0, 0.0}}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Direct, SolvesSystemMixed)
+{
+    using other_value_type = typename TestFixture::value_type;
+    using value_type = gko::next_precision<other_value_type>;
+    using Mtx = gko::matrix::Dense<value_type>;
+    auto solver = this->lu_factory->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({0.0, 0.0, 4.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 2.0, 3.0}),
+                        (r_mixed<value_type, other_value_type>()));
+}
+
+
+TYPED_TEST(Direct, SolvesSystemUsingAdvancedApply)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->lu_factory->generate(this->mtx);
+    auto alpha = gko::initialize<Mtx>({2.0}, this->exec);
+    auto beta = gko::initialize<Mtx>({-1.0}, this->exec);
+    auto b = gko::initialize<Mtx>({0.0, 0.0, 4.0}, this->exec);
+    auto x = gko::initialize<Mtx>({1.0, 1.0, 1.0}, this->exec);
+
+    solver->apply(alpha.get(), b.get(), beta.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 3.0, 5.0}), r<value_type>::value);
+}
+
+
+TYPED_TEST(Direct, SolvesLargeNonsymmetricSystem)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = this->generate_grid(10, 0.5);
+    auto x_exact = this->generate_solution(100, 2);
+    auto b = Mtx::create(this->exec, gko::dim<2>{100, 2});
+    mtx->apply(x_exact.get(), b.get());
+    auto x = Mtx::create(this->exec, gko::dim<2>{100, 2});
+    auto solver = this->lu_factory->generate(mtx);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, x_exact, r<value_type>::value * 1e2);
+    ASSERT_LT(solver->get_num_supernodes(), 100);
+    ASSERT_EQ(solver->get_num_perturbed_pivots(), 0);
+}
+
+
+TYPED_TEST(Direct, SolvesLargeSpdSystemWithCholesky)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = this->generate_grid(10, 0.0);
+    auto x_exact = this->generate_solution(100, 1);
+    auto b = Mtx::create(this->exec, gko::dim<2>{100, 1});
+    mtx->apply(x_exact.get(), b.get());
+    auto x = Mtx::create(this->exec, gko::dim<2>{100, 1});
+    auto solver = this->cholesky_factory->generate(mtx);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, x_exact, r<value_type>::value * 1e2);
+}
+
+
+TYPED_TEST(Direct, CholeskyStoresFewerEntriesThanLu)
+{
+    auto mtx = this->generate_grid(10, 0.0);
+
+    auto lu = this->lu_factory->generate(mtx);
+    auto cholesky = this->cholesky_factory->generate(mtx);
+
+    ASSERT_EQ(lu->get_num_supernodes(), cholesky->get_num_supernodes());
+    ASSERT_LT(cholesky->get_num_factor_elements(),
+              lu->get_num_factor_elements());
+}
+
+
+TYPED_TEST(Direct, SolvesWithoutReorderingAndSingleColumnSupernodes)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Solver = typename TestFixture::Solver;
+    using value_type = typename TestFixture::value_type;
+    auto mtx = this->generate_grid(8, 0.5);
+    auto x_exact = this->generate_solution(64, 1);
+    auto b = Mtx::create(this->exec, gko::dim<2>{64, 1});
+    mtx->apply(x_exact.get(), b.get());
+    auto x = Mtx::create(this->exec, gko::dim<2>{64, 1});
+    auto solver = Solver::build()
+                      .with_skip_reordering(true)
+                      .with_max_supernode_size(1u)
+                      .on(this->exec)
+                      ->generate(mtx);
+
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, x_exact, r<value_type>::value * 1e2);
+    ASSERT_EQ(solver->get_num_supernodes(), 64);
+}
+
+
+TYPED_TEST(Direct, ReorderingReducesFill)
+{
+    using Solver = typename TestFixture::Solver;
+    auto mtx = this->generate_grid(10, 0.0);
+
+    auto reordered = this->lu_factory->generate(mtx);
+    auto natural =
+        Solver::build().with_skip_reordering(true).on(this->exec)->generate(
+            mtx);
+
+    ASSERT_LE(reordered->get_num_factor_elements(),
+              natural->get_num_factor_elements());
+}
+
+
+TYPED_TEST(Direct, RefactorizesWithSamePattern)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver = this->lu_factory->generate(this->mtx);
+    auto scaled = gko::clone(this->mtx);
+    scaled->scale(gko::initialize<Mtx>({2.0}, this->exec).get());
+    auto b = gko::initialize<Mtx>({0.0, 0.0, 4.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->refactorize(gko::share(scaled));
+    solver->apply(b.get(), x.get());
+
+    GKO_ASSERT_MTX_NEAR(x, l({0.5, 1.0, 1.5}), r<value_type>::value);
+}
+
+
+TYPED_TEST(Direct, RefactorizeThrowsOnDifferentPattern)
+{
+    using Csr = typename TestFixture::Csr;
+    auto solver = this->lu_factory->generate(this->mtx);
+    auto other = gko::share(gko::initialize<Csr>(
+        {{2.0, -1.0, 1.0}, {-1.0, 2.0, -1.0}, {0.0, -1.0, 2.0}}, this->exec));
+
+    ASSERT_THROW(solver->refactorize(other), gko::ValueMismatch);
+}
+
+
+TYPED_TEST(Direct, PerturbsZeroPivots)
+{
+    using Csr = typename TestFixture::Csr;
+    auto singular =
+        gko::share(gko::initialize<Csr>({{1.0, 1.0}, {1.0, 1.0}}, this->exec));
+
+    auto solver = this->lu_factory->generate(singular);
+
+    ASSERT_EQ(solver->get_num_perturbed_pivots(), 1);
+}
+
+
+}  // namespace
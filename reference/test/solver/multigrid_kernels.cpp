@@ -0,0 +1,251 @@
+/*******************************<GINKGO LICENSE>******************************
+Copyright (c) 2017-2021, the Ginkgo authors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions
+are met:
+
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in the
+documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************<GINKGO LICENSE>*******************************/
+
+#include <ginkgo/core/solver/multigrid.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/multigrid/amgx_pgm.hpp>
+#include <ginkgo/core/preconditioner/jacobi.hpp>
+#include <ginkgo/core/solver/cg.hpp>
+#include <ginkgo/core/solver/ir.hpp>
+#include <ginkgo/core/stop/combined.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename T>
+class Multigrid : public ::testing::Test {
+protected:
+    using value_type = T;
+    using Csr = gko::matrix::Csr<value_type, gko::int32>;
+    using Vec = gko::matrix::Dense<value_type>;
+    using Solver = gko::solver::Multigrid<value_type>;
+    using AmgxPgm = gko::multigrid::AmgxPgm<value_type, gko::int32>;
+    using Smoother = gko::solver::Ir<value_type>;
+    using Jacobi = gko::preconditioner::Jacobi<value_type, gko::int32>;
+    using Cg = gko::solver::Cg<value_type>;
+
+    Multigrid()
+        : exec(gko::ReferenceExecutor::create()),
+          mtx(gko::share(Csr::create(exec))),
+          b(Vec::create(exec, gko::dim<2>{num_rows, 1})),
+          x(Vec::create(exec, gko::dim<2>{num_rows, 1}))
+    {
+        // 1D Poisson problem
+        gko::matrix_data<value_type, gko::int32> data{gko::dim<2>{num_rows}};
+        for (int i = 0; i < static_cast<int>(num_rows); ++i) {
+            if (i > 0) {
+                data.nonzeros.emplace_back(i, i - 1, -1.0);
+            }
+            data.nonzeros.emplace_back(i, i, 2.0);
+            if (i < static_cast<int>(num_rows) - 1) {
+                data.nonzeros.emplace_back(i, i + 1, -1.0);
+            }
+        }
+        mtx->read(data);
+        for (gko::size_type i = 0; i < num_rows; ++i) {
+            b->at(i, 0) = gko::one<value_type>();
+            x->at(i, 0) = gko::zero<value_type>();
+        }
+    }
+
+    std::unique_ptr<typename Solver::Factory> build_multigrid(
+        gko::solver::multigrid_cycle cycle, gko::size_type max_iters,
+        bool zero_initial_guess = false)
+    {
+        return Solver::build()
+            .with_mg_level(
+                AmgxPgm::build().with_deterministic(true).on(this->exec))
+            .with_pre_smoother(
+                Smoother::build()
+                    .with_solver(
+                        Jacobi::build().with_max_block_size(1u).on(this->exec))
+                    .with_relaxation_factor(value_type{0.9})
+                    .with_criteria(
+                        gko::stop::Iteration::build().with_max_iters(2u).on(
+                            this->exec))
+                    .on(this->exec))
+            .with_coarsest_solver(
+                Cg::build()
+                    .with_criteria(
+                        gko::stop::Iteration::build().with_max_iters(4u).on(
+                            this->exec),
+                        gko::stop::ResidualNorm<value_type>::build()
+                            .with_reduction_factor(r<value_type>::value)
+                            .on(this->exec))
+                    .on(this->exec))
+            .with_cycle(cycle)
+            .with_zero_initial_guess(zero_initial_guess)
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(max_iters).on(
+                    this->exec),
+                gko::stop::ResidualNorm<value_type>::build()
+                    .with_reduction_factor(reduction())
+                    .on(this->exec))
+            .on(this->exec);
+    }
+
+    static gko::remove_complex<value_type> reduction()
+    {
+        return std::is_same<gko::remove_complex<value_type>, float>::value
+                   ? 1e-5
+                   : 1e-10;
+    }
+
+    gko::remove_complex<value_type> get_residual_reduction()
+    {
+        auto res = Vec::create(exec, gko::dim<2>{num_rows, 1});
+        res->copy_from(b.get());
+        auto one = gko::initialize<Vec>({1.0}, exec);
+        auto neg_one = gko::initialize<Vec>({-1.0}, exec);
+        mtx->apply(neg_one.get(), x.get(), one.get(), res.get());
+        auto res_norm = Vec::create(exec, gko::dim<2>{1, 1});
+        auto b_norm = Vec::create(exec, gko::dim<2>{1, 1});
+        res->compute_norm2(res_norm.get());
+        b->compute_norm2(b_norm.get());
+        return gko::abs(res_norm->at(0, 0)) / gko::abs(b_norm->at(0, 0));
+    }
+
+    static constexpr gko::size_type num_rows = 64;
+    std::shared_ptr<const gko::Executor> exec;
+    std::shared_ptr<Csr> mtx;
+    std::unique_ptr<Vec> b;
+    std::unique_ptr<Vec> x;
+};
+
+template <typename T>
+constexpr gko::size_type Multigrid<T>::num_rows;
+
+TYPED_TEST_SUITE(Multigrid, gko::test::ValueTypes);
+
+
+TYPED_TEST(Multigrid, SolvesPoissonWithVCycle)
+{
+    auto solver = this->build_multigrid(gko::solver::multigrid_cycle::v, 200u)
+                      ->generate(this->mtx);
+
+    solver->apply(this->b.get(), this->x.get());
+
+    ASSERT_LE(this->get_residual_reduction(), this->reduction() * 1e1);
+}
+
+
+TYPED_TEST(Multigrid, SolvesPoissonWithWCycle)
+{
+    auto solver = this->build_multigrid(gko::solver::multigrid_cycle::w, 200u)
+                      ->generate(this->mtx);
+
+    solver->apply(this->b.get(), this->x.get());
+
+    ASSERT_LE(this->get_residual_reduction(), this->reduction() * 1e1);
+}
+
+
+TYPED_TEST(Multigrid, SolvesPoissonWithFCycle)
+{
+    auto solver = this->build_multigrid(gko::solver::multigrid_cycle::f, 200u)
+                      ->generate(this->mtx);
+
+    solver->apply(this->b.get(), this->x.get());
+
+    ASSERT_LE(this->get_residual_reduction(), this->reduction() * 1e1);
+}
+
+
+TYPED_TEST(Multigrid, WCycleConvergesFasterThanVCycle)
+{
+    auto v_solver = this->build_multigrid(gko::solver::multigrid_cycle::v, 4u)
+                        ->generate(this->mtx);
+    auto w_solver = this->build_multigrid(gko::solver::multigrid_cycle::w, 4u)
+                        ->generate(this->mtx);
+
+    v_solver->apply(this->b.get(), this->x.get());
+    auto v_reduction = this->get_residual_reduction();
+    this->x->fill(gko::zero<typename TestFixture::value_type>());
+    w_solver->apply(this->b.get(), this->x.get());
+
+    ASSERT_LT(this->get_residual_reduction(), v_reduction);
+}
+
+
+TYPED_TEST(Multigrid, ReusesWorkVectorsForMultipleApplications)
+{
+    auto solver = this->build_multigrid(gko::solver::multigrid_cycle::v, 200u)
+                      ->generate(this->mtx);
+    auto x2 = gko::clone(this->x);
+
+    solver->apply(this->b.get(), this->x.get());
+    solver->apply(this->b.get(), x2.get());
+
+    GKO_ASSERT_MTX_NEAR(this->x, x2, 0.0);
+}
+
+
+TYPED_TEST(Multigrid, PreconditionsCg)
+{
+    using Cg = typename TestFixture::Cg;
+    using Jacobi = typename TestFixture::Jacobi;
+    auto build_cg = [this](std::shared_ptr<const gko::LinOpFactory> precond) {
+        return Cg::build()
+            .with_preconditioner(precond)
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(8u).on(this->exec))
+            .on(this->exec)
+            ->generate(this->mtx);
+    };
+    auto jacobi_cg =
+        build_cg(Jacobi::build().with_max_block_size(1u).on(this->exec));
+    auto mg_cg = build_cg(
+        this->build_multigrid(gko::solver::multigrid_cycle::v, 1u, true));
+
+    jacobi_cg->apply(this->b.get(), this->x.get());
+    auto jacobi_reduction = this->get_residual_reduction();
+    this->x->fill(gko::zero<typename TestFixture::value_type>());
+    mg_cg->apply(this->b.get(), this->x.get());
+
+    ASSERT_LT(this->get_residual_reduction(), jacobi_reduction * 1e-2);
+}
+
+
+}  // namespace